@@ -0,0 +1,24 @@
+#version 450 core
+
+layout(location = 0) in vec2 position;    // World position, already transformed
+layout(location = 1) in vec2 texCoord;
+layout(location = 2) in vec4 color;
+layout(location = 3) in float textureSlot; // Texture unit of the sprite within the batch
+
+out vec2 v_TexCoord;
+out vec4 v_Color;
+flat out int v_TextureSlot;
+
+// Written once per frame by GraphicsSystem, matches GraphicsSystem::FrameUniforms
+layout(std140, binding = 0) uniform Frame
+{
+    mat4 u_ViewProjection;
+};
+
+void main()
+{
+    gl_Position = u_ViewProjection * vec4(position, 0.0, 1.0);
+    v_TexCoord = texCoord;
+    v_Color = color;
+    v_TextureSlot = int(textureSlot + 0.5);
+}
\ No newline at end of file
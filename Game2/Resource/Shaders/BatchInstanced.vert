@@ -0,0 +1,45 @@
+#version 450 core
+
+layout(location = 0) in vec2 position;      // Corner of the shared quad
+layout(location = 1) in vec2 texCoord;      // 0 to 1 across the quad
+
+// Per instance
+layout(location = 2) in vec4 i_Basis;       // Transformed x axis (xy) and y axis (zw)
+layout(location = 3) in vec2 i_Translation;
+layout(location = 4) in vec4 i_UVRect;      // Bottom-left (xy) and top-right (zw), unused for sprite sheets
+layout(location = 5) in vec4 i_Color;
+layout(location = 6) in float i_TextureSlot;
+layout(location = 7) in float i_Sheet;      // Row of u_Sheets, -1 to draw i_UVRect
+layout(location = 8) in float i_Frame;
+
+out vec2 v_TexCoord;
+out vec4 v_Color;
+flat out int v_TextureSlot;
+
+// Written once per frame by GraphicsSystem, matches GraphicsSystem::FrameUniforms
+layout(std140, binding = 0) uniform Frame
+{
+    mat4 u_ViewProjection;
+};
+
+// Written when the sprite sheets load, matches SpriteSheetTable
+layout(std140, binding = 1) uniform SpriteSheets
+{
+    ivec4 u_Sheets[128];        // First frame rect (x) and frame count (y) of each sheet
+    vec4 u_FrameRects[768];
+};
+
+void main()
+{
+    vec2 world = i_Basis.xy * position.x + i_Basis.zw * position.y + i_Translation;
+    gl_Position = u_ViewProjection * vec4(world, 0.0, 1.0);
+    vec4 uvRect = i_UVRect;
+    if (i_Sheet >= 0.0)
+    {
+        ivec4 sheet = u_Sheets[int(i_Sheet + 0.5)];
+        uvRect = u_FrameRects[sheet.x + clamp(int(i_Frame + 0.5), 0, sheet.y - 1)];
+    }
+    v_TexCoord = mix(uvRect.xy, uvRect.zw, texCoord);
+    v_Color = i_Color;
+    v_TextureSlot = int(i_TextureSlot + 0.5);
+}
@@ -1,13 +1,22 @@
 #version 450 core
 
 in vec2 TexCoords;
+in vec3 TextColor;
 out vec4 color;
 
+// Signed distance field of the glyphs, 0.5 on the outline and larger inside
 uniform sampler2D text;
-uniform vec3 textColor;
+uniform float u_OutlineWidth;   // In distance field units, 0 for none
+uniform vec3 u_OutlineColor;
 
 void main()
 {    
-    vec4 sampled = vec4(1.0, 1.0, 1.0, texture(text, TexCoords).r);
-    color = vec4(textColor, 1.0) * sampled;
+    float distance = texture(text, TexCoords).r;
+    // Antialias across about one screen pixel, whatever size the text is drawn at
+    float smoothing = max(fwidth(distance), 0.0001);
+    float fill = smoothstep(0.5 - smoothing, 0.5 + smoothing, distance);
+    float edge = 0.5 - u_OutlineWidth;
+    float outline = smoothstep(edge - smoothing, edge + smoothing, distance);
+    float alpha = max(fill, outline);
+    color = vec4(mix(u_OutlineColor, TextColor, fill / max(alpha, 0.0001)), alpha);
 }  
\ No newline at end of file
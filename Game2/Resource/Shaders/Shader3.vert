@@ -1,7 +1,9 @@
 #version 450 core
 
 layout (location = 0) in vec4 vertex; // <vec2 pos, vec2 tex>
+layout (location = 1) in vec3 color;
 out vec2 TexCoords;
+out vec3 TextColor;
 
 uniform mat4 projection;
 
@@ -17,4 +19,5 @@ void main()
 {
     gl_Position = vec4(vertex.x, vertex.y, 0.0, 1.0);
     TexCoords = vertex.zw;
+    TextColor = color;
 }
\ No newline at end of file
@@ -0,0 +1,179 @@
+/******************************************************************************/
+/*!
+\file		AnimationSystem.cpp
+\author 	Wayne Kwok Jun Lin
+\par    	email: k.junlinwayne@digipen.edu
+\date   	April 19, 2024
+\brief		This file contains the implementation of the AnimationSystem class
+            and of the AnimationLibrary.
+Copyright (C) 2024 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the prior
+written consent of DigiPen Institute of Technology is prohibited.
+ */
+ /******************************************************************************/
+#include "pch.h"
+#include "AnimationSystem.h"
+#include "TextureComponent.h"
+#include "Application.h"
+#include "logger.h"
+#include <fstream>
+#include <sstream>
+
+namespace Engine
+{
+    namespace
+    {
+        // Stores the column and row of the frame a sprite is on
+        void SetFrameIndices(SpriteComponent& sprite)
+        {
+            sprite.texturexindex = sprite.currentframe % sprite.horizontalframes;
+            sprite.textureyindex = sprite.currentframe / sprite.horizontalframes;
+        }
+    }
+
+    AnimationLibrary& AnimationLibrary::GetInstance()
+    {
+        static AnimationLibrary instance;
+        return instance;
+    }
+
+    bool AnimationLibrary::Load(const std::string& filePath)
+    {
+        std::ifstream file(filePath);
+        if (!file.is_open())
+        {
+            Logger::GetInstance().Log(LogLevel::Error, ("Could not open animation clips " + filePath).c_str());
+            return false;
+        }
+
+        clips.clear();
+        defined.clear();
+        std::string line;
+        while (std::getline(file, line))
+        {
+            if (line.empty() || line[0] == '#')
+            {
+                continue;
+            }
+            std::istringstream iss(line);
+            int sheet = 0;
+            AnimationClip clip;
+            std::string mode;
+            if (!(iss >> sheet >> clip.frames >> clip.frameRate >> mode) || sheet < 0 || clip.frames < 1 || clip.frameRate <= 0.0f)
+            {
+                Logger::GetInstance().Log(LogLevel::Error, ("Invalid animation clip: " + line).c_str());
+                continue;
+            }
+            clip.mode = mode == "one_time" ? anim_mode::one_time : anim_mode::loop;
+
+            if (sheet >= static_cast<int>(clips.size()))
+            {
+                clips.resize(sheet + 1);
+                defined.resize(sheet + 1, false);
+            }
+            clips[sheet] = clip;
+            defined[sheet] = true;
+        }
+        return true;
+    }
+
+    const AnimationClip* AnimationLibrary::Find(int sheet) const
+    {
+        if (sheet < 0 || sheet >= static_cast<int>(clips.size()) || !defined[sheet])
+        {
+            return nullptr;
+        }
+        return &clips[sheet];
+    }
+
+    int AnimationLibrary::FrameCount(int sheet) const
+    {
+        const AnimationClip* clip = Find(sheet);
+        return clip ? clip->frames : 1;
+    }
+
+    std::string AnimationSystem::returnSystem()
+    {
+        return "animationSystem";
+    }
+
+    void AnimationSystem::Update(std::unordered_map<EntityID, std::unique_ptr<Entity>>* entities)
+    {
+        const AnimationLibrary& library = AnimationLibrary::GetInstance();
+        stats = Stats();
+        sprites.clear();
+
+        // Sprites whose texture changed start the clip of the new sheet
+        for (const auto& entityPair : *entities)
+        {
+            Entity* entity = entityPair.second.get();
+            if (!entity->HasComponent(ComponentType::Sprite) || !entity->HasComponent(ComponentType::Texture))
+            {
+                continue;
+            }
+            SpriteComponent* sprite = dynamic_cast<SpriteComponent*>(entity->GetComponent(ComponentType::Sprite));
+            TextureComponent* texture = dynamic_cast<TextureComponent*>(entity->GetComponent(ComponentType::Texture));
+            const int sheet = texture->textureKey.subIndex;
+            const AnimationClip* clip = library.Find(sheet);
+            if (!clip)
+            {
+                sprite->clip = -1;
+                continue;
+            }
+            if (sprite->clip != sheet)
+            {
+                sprite->clip = sheet;
+                sprite->framerate = clip->frameRate;
+                sprite->horizontalframes = clip->frames;
+                sprite->verticalframes = 1;
+                sprite->playmode = clip->mode;
+                sprite->animtimer = 0.0f;
+                sprite->currentframe = 0;
+                sprite->playing = true;
+                SetFrameIndices(*sprite);
+                ++stats.clipChanges;
+            }
+            sprites.push_back(sprite);
+        }
+
+        // Every clock advances by the same step
+        const float step = static_cast<float>(fixedDeltaTime);
+        for (SpriteComponent* sprite : sprites)
+        {
+            if (!sprite->playing)
+            {
+                continue;
+            }
+            const float frameTime = 1.0f / sprite->framerate;
+            const int lastFrame = sprite->horizontalframes * sprite->verticalframes - 1;
+            int frame = sprite->currentframe;
+            sprite->animtimer += step;
+            while (sprite->animtimer >= frameTime)
+            {
+                sprite->animtimer -= frameTime;
+                if (frame < lastFrame)
+                {
+                    ++frame;
+                }
+                else if (sprite->playmode == anim_mode::loop)
+                {
+                    frame = 0;
+                }
+                else
+                {
+                    // One-shot clips hold their last frame
+                    sprite->playing = false;
+                    sprite->animtimer = 0.0f;
+                    break;
+                }
+            }
+            if (frame != sprite->currentframe)
+            {
+                sprite->currentframe = frame;
+                SetFrameIndices(*sprite);
+                ++stats.frameChanges;
+            }
+        }
+        stats.animated = static_cast<int>(sprites.size());
+    }
+}
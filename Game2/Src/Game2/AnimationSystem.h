@@ -0,0 +1,124 @@
+/******************************************************************************/
+/*!
+\file		AnimationSystem.h
+\author 	Wayne Kwok Jun Lin
+\par    	email: k.junlinwayne@digipen.edu
+\date   	April 19, 2024
+\brief		This file contains the declaration of the AnimationSystem class,
+            which advances the sprite animation of every entity once per fixed
+            step, and of the AnimationLibrary holding the clips it plays, loaded
+            from Resource/Config/Animations.txt.
+Copyright (C) 2024 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the prior
+written consent of DigiPen Institute of Technology is prohibited.
+ */
+ /******************************************************************************/
+#ifndef ENGINE_ANIMATIONSYSTEM_H
+#define ENGINE_ANIMATIONSYSTEM_H
+
+#include <string>
+#include <vector>
+#include "System.h"
+#include "Entity.h"
+#include "SpriteComponent.h"
+
+namespace Engine
+{
+    // How a sprite sheet is played
+    struct AnimationClip
+    {
+        int frames = 1;             // Frames in a single row across the sheet
+        float frameRate = 10.0f;    // Frames per second
+        anim_mode mode = anim_mode::loop;
+    };
+
+    // The clips of every sprite sheet, indexed by the texture sub-index of the sheet.
+    class AnimationLibrary
+    {
+    public:
+        /*!
+         * \brief Gets the clips, loading them from the default file on first use.
+         * \return A reference to the only instance.
+         */
+        static AnimationLibrary& GetInstance();
+
+        AnimationLibrary(const AnimationLibrary&) = delete;
+        AnimationLibrary& operator=(const AnimationLibrary&) = delete;
+
+        /**************************************************************************/
+        /*!
+        \brief Replaces the clips with the ones of a file. Each line holds the
+        sheet sub-index, the frame count, the frame rate and loop or one_time.
+        Empty lines and lines starting with # are skipped.
+
+        \param[in] filePath
+        The clip file.
+
+        \return
+        True if the file was read.
+        */
+        /**************************************************************************/
+        bool Load(const std::string& filePath);
+
+        /*!
+         * \brief Finds the clip of a sprite sheet.
+         * \param sheet The texture sub-index of the sheet.
+         * \return The clip, or nullptr if the texture is not animated.
+         */
+        const AnimationClip* Find(int sheet) const;
+
+        /*!
+         * \brief Gets the number of frames across a texture.
+         * \param sheet The texture sub-index.
+         * \return The frame count of its clip, or 1 if the texture is not animated.
+         */
+        int FrameCount(int sheet) const;
+
+        static constexpr const char* DEFAULT_PATH = "Resource/Config/Animations.txt";
+
+    private:
+        AnimationLibrary() { Load(DEFAULT_PATH); }
+
+        std::vector<AnimationClip> clips;
+        std::vector<bool> defined;  // Whether each sub-index has a clip
+    };
+
+    class AnimationSystem : public System
+    {
+    public:
+        /*!
+        \brief Counters describing the last step.
+        */
+        struct Stats
+        {
+            int animated = 0;       // Sprites playing a clip
+            int frameChanges = 0;
+            int clipChanges = 0;    // Sprites restarted because their texture changed
+        };
+
+        virtual std::string returnSystem() override;
+
+        /**************************************************************************/
+        /*!
+        \brief Advances every sprite animation by one fixed step. The frame
+        reached is drawn from the sprite sheet table by the batch shader.
+
+        \param[in] entities
+        A pointer to an unordered_map of EntityID and unique_ptr to Entity objects.
+        */
+        /**************************************************************************/
+        void Update(std::unordered_map<EntityID, std::unique_ptr<Entity>>* entities) override;
+
+        /*!
+        \brief Gets the counters of the last step.
+        \return A reference to the statistics.
+        */
+        const Stats& GetStats() const { return stats; }
+
+    private:
+        // Sprites animated this step, gathered so the clocks advance in one pass
+        std::vector<SpriteComponent*> sprites;
+        Stats stats;
+    };
+}
+#endif ENGINE_ANIMATIONSYSTEM_H
@@ -609,7 +609,8 @@ namespace Engine
                 if (collisionTest && transformTest && textureTest) //INPUT TESTING FOR UNIT ENTITIES
                 {
 
-                    if (collisionTest->isColliding) {
+                    // Crowd avoidance already steers units apart, only push them out by hand without it
+                    if (collisionTest->isColliding && !PathfindingSystem::IsCrowdAvoidance()) {
                         if (textureTest->textureKey.mainIndex == 1 || textureTest->textureKey.mainIndex == 2 ||
                             textureTest->textureKey.mainIndex == 3) {
                             //audioEngine.playSound(sound_Slash);
@@ -911,7 +912,10 @@ namespace Engine
             }
             */
 
-        }           
+        }
+
+        // Join the path workers now rather than from a static destructor during unload
+        PathfindingSystem::Shutdown();
     }
 
     bool Application::OnWindowClose(WindowCloseEvent& e)
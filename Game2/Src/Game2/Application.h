@@ -30,6 +30,7 @@ written consent of DigiPen Institute of Technology is prohibited.
 extern double loopTime;
 extern const double fixedDeltaTime;
 extern int currentNumberOfSteps;
+extern double accumulatedTime;
 extern bool isPaused;
 extern bool stepOneFrame;
 extern double dt;
@@ -20,6 +20,7 @@
 
 #include "pch.h"
 #include <glm/glm.hpp>
+#include <cfloat>
 #include "Input.h"
 
 namespace Engine
@@ -104,6 +105,29 @@ namespace Engine
 			return m_ViewProjectionMatrix;
 		}
 
+		/**
+		* @brief Gets the world rectangle the camera sees, including its zoom and rotation.
+		*
+		* @param min Receives the bottom-left corner of the rectangle.
+		* @param max Receives the top-right corner of the rectangle.
+		*/
+		void GetViewBounds(glm::vec2& min, glm::vec2& max) const
+		{
+			// Map the corners of clip space back into the world
+			glm::mat4 inverse = glm::inverse(m_ViewProjectionMatrix);
+			min = glm::vec2(FLT_MAX);
+			max = glm::vec2(-FLT_MAX);
+			for (float x : { -1.0f, 1.0f })
+			{
+				for (float y : { -1.0f, 1.0f })
+				{
+					glm::vec4 corner = inverse * glm::vec4(x, y, 0.0f, 1.0f);
+					min = glm::min(min, glm::vec2(corner));
+					max = glm::max(max, glm::vec2(corner));
+				}
+			}
+		}
+
 		/**
 		* @brief Updates the camera's position based on input controls.
 		*
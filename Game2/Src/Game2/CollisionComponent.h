@@ -46,6 +46,35 @@ namespace Engine
 		std::queue<std::pair<EntityID, EntityID>> ArcherTowerQueue;
 		std::vector<std::pair<EntityID, EntityID>> ArcherTowerVector;
 
+		// Runtime body state, assigned by the CollisionSystem and never saved
+		BodyType bodyType = BodyType::Kinematic;
+		bool sleeping = false;
+		int idleFrames = 0;
+		VECTORMATH::Vector2D restPosition = VECTORMATH::Vector2D(0.f, 0.f);
+
+		/*!*****************************************************************
+
+		\brief
+		Checks if the body moves and has to be tested against other bodies
+
+		\return  bool
+		False for static and sleeping bodies
+
+		********************************************************************/
+		bool IsAwake() const { return bodyType != BodyType::Static && !sleeping; }
+
+		/*!*****************************************************************
+
+		\brief
+		Wakes the body up, restarting its idle count. Static bodies stay static
+
+		********************************************************************/
+		void Wake()
+		{
+			sleeping = false;
+			idleFrames = 0;
+		}
+
 
 		/*!*****************************************************************
 
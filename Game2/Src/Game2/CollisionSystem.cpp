@@ -122,6 +122,32 @@ namespace Engine
 {
 	Input inputManager;
 
+	// Body counts and pair counters of the last update, shown in the profiler
+	CollisionSystem::BodyStats bodyStats;
+
+	// Updates a kinematic body has to stay still and untouched before it sleeps
+	const int KINEMATIC_SLEEP_FRAMES = 30;
+
+	namespace
+	{
+		// Components of an entity the pair loop reads, looked up once per update instead of once per pair
+		struct PairCandidate
+		{
+			Entity* entity;
+			CollisionComponent* collision;
+			TransformComponent* transform;
+			StatsComponent* stats;
+			TextureComponent* texture;
+			ShootingComponent* shooting;
+		};
+
+		// Every entity with a transform, the awake colliders, and the awake colliders plus the units
+		// towers shoot at. Kept between updates so they are not reallocated
+		std::vector<PairCandidate> allCandidates;
+		std::vector<PairCandidate> awakeCandidates;
+		std::vector<PairCandidate> towerCandidates;
+	}
+
 	void CollisionSystem::Update(std::unordered_map<EntityID, std::unique_ptr<Entity>>* entities)
 
 	{
@@ -185,6 +211,7 @@ namespace Engine
 
 		*/
 		EntityToMouseCollision(entities);
+		UpdateBodyStates(entities);
 		EntityToEntityCollision(entities);
 
 
@@ -547,6 +574,42 @@ namespace Engine
 
 	void CollisionSystem::EntityToEntityCollision(std::unordered_map<EntityID, std::unique_ptr<Entity>>* entities)
 	{
+		// Nothing changes between two idle bodies, so an idle body only has to be tested against the
+		// awake ones. Tower ranges act as triggers and keep shooting at sleeping units
+		allCandidates.clear();
+		awakeCandidates.clear();
+		towerCandidates.clear();
+		for (const auto& entityPair : *entities)
+		{
+			Entity* entity = entityPair.second.get();
+			if (!entity->HasComponent(ComponentType::Transform))
+			{
+				continue;
+			}
+
+			PairCandidate candidate = {
+				entity,
+				dynamic_cast<CollisionComponent*>(entity->GetComponent(ComponentType::Collision)),
+				dynamic_cast<TransformComponent*>(entity->GetComponent(ComponentType::Transform)),
+				dynamic_cast<StatsComponent*>(entity->GetComponent(ComponentType::Stats)),
+				dynamic_cast<TextureComponent*>(entity->GetComponent(ComponentType::Texture)),
+				dynamic_cast<ShootingComponent*>(entity->GetComponent(ComponentType::Shooting)) };
+			allCandidates.push_back(candidate);
+
+			if (candidate.collision && !candidate.collision->disableCollision)
+			{
+				if (candidate.collision->IsAwake())
+				{
+					awakeCandidates.push_back(candidate);
+					towerCandidates.push_back(candidate);
+				}
+				else if (candidate.collision->layer == Layer::World)
+				{
+					towerCandidates.push_back(candidate);
+				}
+			}
+		}
+
 		// Iterate through all pairs of entities
 		for (auto it1 = entities->begin(); it1 != entities->end(); ++it1)
 		{
@@ -639,11 +702,16 @@ namespace Engine
 
 					bool isColliding = false; // Flag to check if entity1 is colliding with any other entity
 
-					for (auto it2 = entities->begin(); it2 != entities->end(); ++it2)
+					// Idle bodies skip every other idle body
+					const std::vector<PairCandidate>& candidates = collisionComponent1->IsAwake() ? allCandidates
+						: (collisionComponent1->layer == Layer::Tower ? towerCandidates : awakeCandidates);
+					bodyStats.pairsSkipped += static_cast<int>(allCandidates.size() - candidates.size());
+
+					for (const PairCandidate& candidate : candidates)
 					{
-						if (it1 != it2) // Avoid self-collision check
+						if (candidate.entity != entity1) // Avoid self-collision check
 						{
-							Entity* entity2 = it2->second.get();
+							Entity* entity2 = candidate.entity;
 							//if ((entity1->GetID() == 13 && entity2->GetID() == 15)
 							//	|| (entity1->GetID() == 15 && entity2->GetID() == 13)) // Defo wrong, should check with entity types instead
 							//{
@@ -652,11 +720,11 @@ namespace Engine
 
 							if (entity2->HasComponent(ComponentType::Transform))
 							{
-								CollisionComponent* collisionComponent2 = dynamic_cast<CollisionComponent*>(entity2->GetComponent(ComponentType::Collision));
-								TransformComponent* transformComponent2 = dynamic_cast<TransformComponent*>(entity2->GetComponent(ComponentType::Transform));
-								StatsComponent* statsComponent2 = dynamic_cast<StatsComponent*>(entity2->GetComponent(ComponentType::Stats));
-								TextureComponent* textureComponent2 = dynamic_cast<TextureComponent*>(entity2->GetComponent(ComponentType::Texture));
-								ShootingComponent* shootingComponent1 = dynamic_cast<ShootingComponent*>(entity2->GetComponent(ComponentType::Shooting));
+								CollisionComponent* collisionComponent2 = candidate.collision;
+								TransformComponent* transformComponent2 = candidate.transform;
+								StatsComponent* statsComponent2 = candidate.stats;
+								TextureComponent* textureComponent2 = candidate.texture;
+								ShootingComponent* shootingComponent1 = candidate.shooting;
 
 								if (collisionComponent2 && collisionComponent2->disableCollision == true)
 								{
@@ -783,6 +851,8 @@ namespace Engine
 
 									if (collisionComponent2 != nullptr)
 									{
+										++bodyStats.pairsTested;
+
 										circleVel2 = VECTORMATH::Vec2(collisionComponent2->collisionVel.x, collisionComponent2->collisionVel.y);
 										BehaviourComponent* behaviourComponent1 = dynamic_cast<BehaviourComponent*>(entity1->GetComponent(ComponentType::Logic));
 
@@ -791,6 +861,10 @@ namespace Engine
 										{
 											isColliding = true;
 
+											// Contact with an awake body wakes a sleeping one
+											collisionComponent1->Wake();
+											collisionComponent2->Wake();
+
 											// Collision from arrow to unit
 											if (collisionComponent2->layer == Layer::Arrow && collisionComponent2->layerTarget == Layer::World && collisionComponent1->layer == Layer::World)
 											{
@@ -1109,6 +1183,84 @@ namespace Engine
 	}
 
 
+	void CollisionSystem::UpdateBodyStates(std::unordered_map<EntityID, std::unique_ptr<Entity>>* entities)
+	{
+		bodyStats = BodyStats();
+
+		for (const auto& entityPair : *entities)
+		{
+			Entity* entity = entityPair.second.get();
+			if (!entity->HasComponent(ComponentType::Transform) || !entity->HasComponent(ComponentType::Collision))
+			{
+				continue;
+			}
+
+			CollisionComponent* collisionComponent = dynamic_cast<CollisionComponent*>(entity->GetComponent(ComponentType::Collision));
+			TransformComponent* transformComponent = dynamic_cast<TransformComponent*>(entity->GetComponent(ComponentType::Transform));
+
+			// Towers, castles and the HUD never move, bodies the physics world simulates are dynamic
+			BodyType bodyType = BodyType::Kinematic;
+			if (collisionComponent->layer == Layer::Tower || collisionComponent->layer == Layer::Castle || collisionComponent->layer == Layer::inGameGUI)
+			{
+				bodyType = BodyType::Static;
+			}
+			else if (entity->HasComponent(ComponentType::Physics) && !entity->HasComponent(ComponentType::Pathfinding)
+				&& (collisionComponent->layer == Layer::World || collisionComponent->layer == Layer::Arrow))
+			{
+				bodyType = BodyType::Dynamic;
+			}
+
+			if (collisionComponent->bodyType != bodyType)
+			{
+				collisionComponent->bodyType = bodyType;
+				collisionComponent->Wake();
+			}
+
+			switch (bodyType)
+			{
+			case BodyType::Static:
+				++bodyStats.staticBodies;
+				break;
+
+			case BodyType::Kinematic:
+			{
+				// Scripts, pathfinding and the editor move kinematic bodies, any move wakes them
+				bool moved = transformComponent->position.x != collisionComponent->restPosition.x
+					|| transformComponent->position.y != collisionComponent->restPosition.y;
+				collisionComponent->restPosition = transformComponent->position;
+
+				if (moved || collisionComponent->isColliding)
+				{
+					collisionComponent->Wake();
+				}
+				else if (++collisionComponent->idleFrames >= KINEMATIC_SLEEP_FRAMES)
+				{
+					collisionComponent->sleeping = true;
+				}
+
+				if (collisionComponent->sleeping)
+				{
+					++bodyStats.kinematicSleeping;
+				}
+				else
+				{
+					++bodyStats.kinematicAwake;
+				}
+				break;
+			}
+
+			case BodyType::Dynamic:
+				// Slept, woken and counted by the physics world
+				break;
+			}
+		}
+	}
+
+	const CollisionSystem::BodyStats& CollisionSystem::GetBodyStats()
+	{
+		return bodyStats;
+	}
+
 	void CollisionSystem::EntityToMouseCollision(std::unordered_map<EntityID, std::unique_ptr<Entity>>* entities)
 	{
 
@@ -53,6 +53,8 @@ extern bool archerDead;
 
 namespace Engine
 {
+	class CollisionComponent;
+
 	class CollisionSystem : public System //CollisionSystem class, Child class of System base class
 	{
 	public:
@@ -263,6 +265,8 @@ namespace Engine
 		/**************************************************************************/
 		/*!
 		\brief Check for collisions between entities in a collection and update their states as needed.
+		Static and sleeping bodies are only tested against awake ones, except that
+		towers also test sleeping units, which their ranges keep shooting at.
 
 		\param[in] entities
 		A pointer to an `std::unordered_map` containing entities associated with unique IDs.
@@ -282,6 +286,35 @@ namespace Engine
 		/**************************************************************************/
 		void EntityToMouseCollision(std::unordered_map<EntityID, std::unique_ptr<Entity>>* entities);
 
+		// Counts of static and kinematic bodies, and of the pairs the last update tested or skipped as idle
+		struct BodyStats
+		{
+			int staticBodies = 0;
+			int kinematicAwake = 0;
+			int kinematicSleeping = 0;
+			int pairsTested = 0;
+			int pairsSkipped = 0;
+		};
+
+		/**************************************************************************/
+		/*!
+		\brief Classifies every collider as static, kinematic or dynamic and puts
+		kinematic bodies that stopped moving and touch nothing to sleep. Moved
+		bodies wake up. Dynamic bodies are put to sleep by the physics world.
+
+		\param[in] entities
+		A pointer to an `std::unordered_map` containing entities associated with unique IDs.
+
+		*/
+		/**************************************************************************/
+		void UpdateBodyStates(std::unordered_map<EntityID, std::unique_ptr<Entity>>* entities);
+
+		/*!
+		\brief Gets the body counts of the last update.
+		\return A reference to the counts.
+		*/
+		static const BodyStats& GetBodyStats();
+
 	private:
 		EntityID lastCollidingEntityID = {};
 	};
@@ -0,0 +1,497 @@
+/******************************************************************************/
+/*!
+\file		CrowdAvoidance.cpp
+\author		Ang Jun Sheng Aloysius, a.junshengaloysius, 2201807
+
+\par		a.junshengaloysius@digipen.edu
+
+\date		12/04/2024
+
+\brief		Contains the definitions of the crowd local avoidance step. The
+			velocity solve follows the ORCA half-plane construction and the
+			incremental 2D linear program of van den Berg et al.
+Copyright (C) 2024 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+ */
+ /******************************************************************************/
+
+#include "pch.h"
+#include "CrowdAvoidance.h"
+#include <cmath>
+#include <execution>
+
+namespace Engine
+{
+    namespace
+    {
+        const float EPSILON = 0.00001f;
+
+        // Agents per parallel chunk, small crowds are solved on the calling thread
+        const int CHUNK_SIZE = 256;
+
+        struct Vec
+        {
+            float x, y;
+        };
+
+        inline Vec operator+(Vec a, Vec b) { return { a.x + b.x, a.y + b.y }; }
+        inline Vec operator-(Vec a, Vec b) { return { a.x - b.x, a.y - b.y }; }
+        inline Vec operator*(Vec a, float s) { return { a.x * s, a.y * s }; }
+        inline float dot(Vec a, Vec b) { return a.x * b.x + a.y * b.y; }
+        inline float det(Vec a, Vec b) { return a.x * b.y - a.y * b.x; }
+        inline float lengthSq(Vec a) { return dot(a, a); }
+
+        inline Vec normalize(Vec a)
+        {
+            float length = std::sqrt(lengthSq(a));
+            return length > EPSILON ? a * (1.0f / length) : Vec{ 0.0f, 0.0f };
+        }
+
+        // Velocities on the left of the directed line are allowed
+        struct Line
+        {
+            Vec point;
+            Vec direction;
+        };
+
+        // Best velocity on one line, subject to the lines before it and the speed limit
+        bool linearProgram1(const std::vector<Line>& lines, size_t lineNo, float radius, Vec optimal, bool directionOpt, Vec& result)
+        {
+            float dotProduct = dot(lines[lineNo].point, lines[lineNo].direction);
+            float discriminant = dotProduct * dotProduct + radius * radius - lengthSq(lines[lineNo].point);
+            if (discriminant < 0.0f)
+            {
+                // The speed limit circle misses the line
+                return false;
+            }
+
+            float sqrtDiscriminant = std::sqrt(discriminant);
+            float tLeft = -dotProduct - sqrtDiscriminant;
+            float tRight = -dotProduct + sqrtDiscriminant;
+
+            for (size_t i = 0; i < lineNo; ++i)
+            {
+                float denominator = det(lines[lineNo].direction, lines[i].direction);
+                float numerator = det(lines[i].direction, lines[lineNo].point - lines[i].point);
+                if (std::fabs(denominator) <= EPSILON)
+                {
+                    // Parallel lines, either line i excludes all of this one or none of it
+                    if (numerator < 0.0f)
+                    {
+                        return false;
+                    }
+                    continue;
+                }
+
+                float t = numerator / denominator;
+                if (denominator >= 0.0f)
+                {
+                    tRight = std::min(tRight, t);
+                }
+                else
+                {
+                    tLeft = std::max(tLeft, t);
+                }
+                if (tLeft > tRight)
+                {
+                    return false;
+                }
+            }
+
+            if (directionOpt)
+            {
+                result = lines[lineNo].point + lines[lineNo].direction * (dot(optimal, lines[lineNo].direction) > 0.0f ? tRight : tLeft);
+            }
+            else
+            {
+                float t = std::clamp(dot(lines[lineNo].direction, optimal - lines[lineNo].point), tLeft, tRight);
+                result = lines[lineNo].point + lines[lineNo].direction * t;
+            }
+            return true;
+        }
+
+        // Velocity closest to the optimal one satisfying every line, or the index of the first line that fails
+        size_t linearProgram2(const std::vector<Line>& lines, float radius, Vec optimal, bool directionOpt, Vec& result)
+        {
+            if (directionOpt)
+            {
+                result = optimal * radius;
+            }
+            else if (lengthSq(optimal) > radius * radius)
+            {
+                result = normalize(optimal) * radius;
+            }
+            else
+            {
+                result = optimal;
+            }
+
+            for (size_t i = 0; i < lines.size(); ++i)
+            {
+                if (det(lines[i].direction, lines[i].point - result) > 0.0f)
+                {
+                    Vec previous = result;
+                    if (!linearProgram1(lines, i, radius, optimal, directionOpt, result))
+                    {
+                        result = previous;
+                        return i;
+                    }
+                }
+            }
+            return lines.size();
+        }
+
+        // Infeasible crowds, minimizes the largest violation of the remaining lines instead
+        void linearProgram3(const std::vector<Line>& lines, size_t beginLine, float radius, Vec& result, std::vector<Line>& projected)
+        {
+            float distance = 0.0f;
+            for (size_t i = beginLine; i < lines.size(); ++i)
+            {
+                if (det(lines[i].direction, lines[i].point - result) <= distance)
+                {
+                    continue;
+                }
+
+                projected.clear();
+                for (size_t j = 0; j < i; ++j)
+                {
+                    Line line;
+                    float determinant = det(lines[i].direction, lines[j].direction);
+                    if (std::fabs(determinant) <= EPSILON)
+                    {
+                        if (dot(lines[i].direction, lines[j].direction) > 0.0f)
+                        {
+                            // Same direction, line j adds nothing
+                            continue;
+                        }
+                        line.point = (lines[i].point + lines[j].point) * 0.5f;
+                    }
+                    else
+                    {
+                        line.point = lines[i].point + lines[i].direction * (det(lines[j].direction, lines[i].point - lines[j].point) / determinant);
+                    }
+                    line.direction = normalize(lines[j].direction - lines[i].direction);
+                    projected.push_back(line);
+                }
+
+                Vec previous = result;
+                if (linearProgram2(projected, radius, { -lines[i].direction.y, lines[i].direction.x }, true, result) < projected.size())
+                {
+                    // Only floating point error gets here, keep the last result
+                    result = previous;
+                }
+                distance = det(lines[i].direction, lines[i].point - result);
+            }
+        }
+    }
+
+    void CrowdAvoidance::Clear()
+    {
+        positionX.clear();
+        positionY.clear();
+        currentVelocityX.clear();
+        currentVelocityY.clear();
+        preferredX.clear();
+        preferredY.clear();
+        velocityX.clear();
+        velocityY.clear();
+        radius.clear();
+        maxSpeed.clear();
+    }
+
+    int CrowdAvoidance::AddAgent(float x, float y, float _radius, float currentX, float currentY, float _preferredX, float _preferredY, float _maxSpeed)
+    {
+        positionX.push_back(x);
+        positionY.push_back(y);
+        currentVelocityX.push_back(currentX);
+        currentVelocityY.push_back(currentY);
+        preferredX.push_back(_preferredX);
+        preferredY.push_back(_preferredY);
+        velocityX.push_back(currentX);
+        velocityY.push_back(currentY);
+        radius.push_back(_radius);
+        maxSpeed.push_back(_maxSpeed);
+        return static_cast<int>(positionX.size()) - 1;
+    }
+
+    uint32_t CrowdAvoidance::BucketOf(int cellX, int cellY) const
+    {
+        return (static_cast<uint32_t>(cellX) * 73856093u ^ static_cast<uint32_t>(cellY) * 19349663u) & cellMask;
+    }
+
+    void CrowdAvoidance::BuildSpatialHash()
+    {
+        // Twice as many buckets as agents keeps collisions between cells rare
+        int count = GetAgentCount();
+        uint32_t bucketCount = 64;
+        while (bucketCount < static_cast<uint32_t>(count) * 2)
+        {
+            bucketCount <<= 1;
+        }
+        cellMask = bucketCount - 1;
+        cellSize = std::max(settings.neighbourDistance, 1.0f);
+
+        // Counting sort of the agents by bucket
+        cellStart.assign(bucketCount + 1, 0);
+        agentBucket.resize(count);
+        for (int i = 0; i < count; ++i)
+        {
+            uint32_t bucket = BucketOf(static_cast<int>(std::floor(positionX[i] / cellSize)), static_cast<int>(std::floor(positionY[i] / cellSize)));
+            agentBucket[i] = bucket;
+            ++cellStart[bucket + 1];
+        }
+        for (uint32_t bucket = 0; bucket < bucketCount; ++bucket)
+        {
+            cellStart[bucket + 1] += cellStart[bucket];
+        }
+
+        cellAgents.resize(count);
+        std::vector<int> next(cellStart.begin(), cellStart.end() - 1);
+        for (int i = 0; i < count; ++i)
+        {
+            cellAgents[next[agentBucket[i]]++] = i;
+        }
+        stats.hashCells = static_cast<int>(bucketCount);
+    }
+
+    void CrowdAvoidance::SolveRange(int begin, int end, float timeStep, int& neighbourCount)
+    {
+        // Scratch space reused by every agent solved on this thread
+        thread_local std::vector<std::pair<float, int>> neighbours;
+        thread_local std::vector<Line> lines;
+        thread_local std::vector<Line> projected;
+
+        float invTimeHorizon = 1.0f / settings.timeHorizon;
+        float invTimeStep = 1.0f / timeStep;
+        float rangeSq = settings.neighbourDistance * settings.neighbourDistance;
+        size_t maxNeighbours = static_cast<size_t>(std::max(settings.maxNeighbours, 0));
+
+        for (int agent = begin; agent < end; ++agent)
+        {
+            Vec position = { positionX[agent], positionY[agent] };
+            Vec velocity = { currentVelocityX[agent], currentVelocityY[agent] };
+            Vec preferred = { preferredX[agent], preferredY[agent] };
+            if (maxSpeed[agent] <= 0.0f)
+            {
+                velocityX[agent] = 0.0f;
+                velocityY[agent] = 0.0f;
+                continue;
+            }
+
+            // Closest neighbours in the 3x3 cells around the agent, each bucket visited once
+            neighbours.clear();
+            int cellX = static_cast<int>(std::floor(position.x / cellSize));
+            int cellY = static_cast<int>(std::floor(position.y / cellSize));
+            uint32_t visited[9];
+            int visitedCount = 0;
+            for (int dy = -1; dy <= 1; ++dy)
+            {
+                for (int dx = -1; dx <= 1; ++dx)
+                {
+                    uint32_t bucket = BucketOf(cellX + dx, cellY + dy);
+                    if (std::find(visited, visited + visitedCount, bucket) != visited + visitedCount)
+                    {
+                        continue;
+                    }
+                    visited[visitedCount++] = bucket;
+
+                    for (int k = cellStart[bucket]; k < cellStart[bucket + 1]; ++k)
+                    {
+                        int other = cellAgents[k];
+                        float offsetX = positionX[other] - position.x;
+                        float offsetY = positionY[other] - position.y;
+                        float distanceSq = offsetX * offsetX + offsetY * offsetY;
+                        if (other == agent || distanceSq >= rangeSq)
+                        {
+                            continue;
+                        }
+                        if (neighbours.size() == maxNeighbours && distanceSq >= neighbours.back().first)
+                        {
+                            continue;
+                        }
+
+                        // Sorted insert, dropping the furthest once full
+                        if (neighbours.size() < maxNeighbours)
+                        {
+                            neighbours.push_back({ distanceSq, other });
+                        }
+                        else
+                        {
+                            neighbours.back() = { distanceSq, other };
+                        }
+                        for (size_t n = neighbours.size() - 1; n > 0 && neighbours[n - 1].first > distanceSq; --n)
+                        {
+                            std::swap(neighbours[n - 1], neighbours[n]);
+                        }
+                    }
+                }
+            }
+            neighbourCount += static_cast<int>(neighbours.size());
+
+            // One half-plane of allowed velocities per neighbour
+            lines.clear();
+            for (const auto& neighbour : neighbours)
+            {
+                int other = neighbour.second;
+                Vec relativePosition = { positionX[other] - position.x, positionY[other] - position.y };
+                Vec relativeVelocity = velocity - Vec{ currentVelocityX[other], currentVelocityY[other] };
+                float distanceSq = neighbour.first;
+                float combinedRadius = radius[agent] + radius[other];
+                float combinedRadiusSq = combinedRadius * combinedRadius;
+
+                Line line;
+                Vec u;
+                if (distanceSq > combinedRadiusSq)
+                {
+                    // Not colliding yet, stay out of the truncated velocity obstacle
+                    Vec w = relativeVelocity - relativePosition * invTimeHorizon;
+                    float wLengthSq = lengthSq(w);
+                    float dotProduct = dot(w, relativePosition);
+                    if (dotProduct < 0.0f && dotProduct * dotProduct > combinedRadiusSq * wLengthSq)
+                    {
+                        // Closest to the cut-off circle
+                        float wLength = std::sqrt(wLengthSq);
+                        Vec unitW = w * (1.0f / wLength);
+                        line.direction = { unitW.y, -unitW.x };
+                        u = unitW * (combinedRadius * invTimeHorizon - wLength);
+                    }
+                    else
+                    {
+                        // Closest to one of the legs
+                        float leg = std::sqrt(distanceSq - combinedRadiusSq);
+                        if (det(relativePosition, w) > 0.0f)
+                        {
+                            line.direction = Vec{ relativePosition.x * leg - relativePosition.y * combinedRadius,
+                                relativePosition.x * combinedRadius + relativePosition.y * leg } * (1.0f / distanceSq);
+                        }
+                        else
+                        {
+                            line.direction = Vec{ relativePosition.x * leg + relativePosition.y * combinedRadius,
+                                -relativePosition.x * combinedRadius + relativePosition.y * leg } * (-1.0f / distanceSq);
+                        }
+                        u = line.direction * dot(relativeVelocity, line.direction) - relativeVelocity;
+                    }
+                }
+                else
+                {
+                    // Already overlapping, separate within this step
+                    Vec w = relativeVelocity - relativePosition * invTimeStep;
+                    float wLength = std::sqrt(lengthSq(w));
+                    Vec unitW = wLength > EPSILON ? w * (1.0f / wLength) : Vec{ 1.0f, 0.0f };
+                    line.direction = { unitW.y, -unitW.x };
+                    u = unitW * (combinedRadius * invTimeStep - wLength);
+                }
+
+                // Share the avoidance with moving neighbours, go around those holding their position
+                float responsibility = maxSpeed[other] > 0.0f ? 0.5f : 1.0f;
+                line.point = velocity + u * responsibility;
+                lines.push_back(line);
+            }
+
+            Vec result;
+            size_t failed = linearProgram2(lines, maxSpeed[agent], preferred, false, result);
+            if (failed < lines.size())
+            {
+                linearProgram3(lines, failed, maxSpeed[agent], result, projected);
+            }
+            velocityX[agent] = result.x;
+            velocityY[agent] = result.y;
+        }
+    }
+
+    void CrowdAvoidance::Solve(float timeStep)
+    {
+        auto solveStart = std::chrono::high_resolution_clock::now();
+        int count = GetAgentCount();
+        stats.agents = count;
+
+        BuildSpatialHash();
+        stats.lastBuildMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - solveStart).count();
+
+        // Every agent writes only its own velocity, so chunks need no locking
+        int chunkCount = (count + CHUNK_SIZE - 1) / CHUNK_SIZE;
+        std::vector<int> chunkNeighbours(chunkCount, 0);
+        if (chunkCount <= 1)
+        {
+            if (count > 0)
+            {
+                SolveRange(0, count, timeStep, chunkNeighbours[0]);
+            }
+        }
+        else
+        {
+            std::vector<int> chunks(chunkCount);
+            for (int i = 0; i < chunkCount; ++i)
+            {
+                chunks[i] = i;
+            }
+            std::for_each(std::execution::par, chunks.begin(), chunks.end(), [&](int chunk)
+                {
+                    SolveRange(chunk * CHUNK_SIZE, std::min((chunk + 1) * CHUNK_SIZE, count), timeStep, chunkNeighbours[chunk]);
+                });
+        }
+
+        int neighbourTotal = 0;
+        for (int neighbourCount : chunkNeighbours)
+        {
+            neighbourTotal += neighbourCount;
+        }
+        stats.averageNeighbours = count > 0 ? static_cast<double>(neighbourTotal) / count : 0.0;
+        stats.lastSolveMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - solveStart).count();
+    }
+
+    CrowdAvoidance::BenchmarkResult CrowdAvoidance::RunBenchmark(int agentCount, int steps)
+    {
+        const float AGENT_RADIUS = 20.0f;
+        const float SPACING = 50.0f;
+        const float SPEED = 1.0f;
+
+        // Two blocks of agents marching into each other
+        int half = agentCount / 2;
+        int columns = std::max(1, static_cast<int>(std::sqrt(static_cast<float>(std::max(half, 1)))));
+        std::vector<float> x(agentCount), y(agentCount), goalX(agentCount);
+        std::vector<float> velocityX(agentCount, 0.0f), velocityY(agentCount, 0.0f);
+        for (int i = 0; i < agentCount; ++i)
+        {
+            bool left = i < half;
+            int index = left ? i : i - half;
+            int column = index % columns;
+            x[i] = left ? -(column + 0.5f) * SPACING : (column + 0.5f) * SPACING;
+            y[i] = (index / columns) * SPACING + (left ? 0.0f : SPACING * 0.5f);
+            goalX[i] = left ? columns * SPACING : -columns * SPACING;
+        }
+
+        CrowdAvoidance crowd;
+        BenchmarkResult result;
+        result.agents = agentCount;
+        for (int step = 0; step < steps; ++step)
+        {
+            crowd.Clear();
+            for (int i = 0; i < agentCount; ++i)
+            {
+                float towardGoal = goalX[i] > x[i] ? SPEED : -SPEED;
+                crowd.AddAgent(x[i], y[i], AGENT_RADIUS, velocityX[i], velocityY[i], towardGoal, 0.0f, SPEED);
+            }
+            crowd.Solve(1.0f);
+
+            result.averageSolveMs += crowd.GetStats().lastSolveMs;
+            result.averageNeighbours += crowd.GetStats().averageNeighbours;
+            for (int i = 0; i < agentCount; ++i)
+            {
+                velocityX[i] = crowd.GetVelocityX(i);
+                velocityY[i] = crowd.GetVelocityY(i);
+                x[i] += velocityX[i];
+                y[i] += velocityY[i];
+            }
+        }
+
+        if (steps > 0)
+        {
+            result.averageSolveMs /= steps;
+            result.averageNeighbours /= steps;
+        }
+        return result;
+    }
+}
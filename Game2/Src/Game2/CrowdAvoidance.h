@@ -0,0 +1,161 @@
+/******************************************************************************/
+/*!
+\file		CrowdAvoidance.h
+\author		Ang Jun Sheng Aloysius, a.junshengaloysius, 2201807
+
+\par		a.junshengaloysius@digipen.edu
+
+\date		12/04/2024
+
+\brief		Contains the declaration of the crowd local avoidance step. Units
+			add themselves as agents with the velocity their path asks for, and
+			Solve returns velocities that keep them from walking into each
+			other using optimal reciprocal collision avoidance (ORCA).
+			Neighbours are found through a spatial hash rebuilt every solve,
+			agent data is stored as separate arrays, and agents are solved
+			in parallel chunks.
+Copyright (C) 2024 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+ */
+ /******************************************************************************/
+#ifndef ENGINE_CROWDAVOIDANCE_H
+#define ENGINE_CROWDAVOIDANCE_H
+
+#include <vector>
+#include <cstdint>
+
+namespace Engine
+{
+    class CrowdAvoidance
+    {
+    public:
+        /*!
+        \brief Tuning of the avoidance step. Times are in solve steps.
+        */
+        struct Settings
+        {
+            float neighbourDistance = 96.0f;    // Agents further apart than this are ignored
+            int maxNeighbours = 10;             // Closest neighbours considered per agent
+            float timeHorizon = 30.0f;          // How far ahead collisions are avoided
+        };
+
+        /*!
+        \brief Counters describing the last solve.
+        */
+        struct Stats
+        {
+            int agents = 0;
+            int hashCells = 0;
+            double averageNeighbours = 0.0;
+            double lastBuildMs = 0.0;   // Spatial hash rebuild
+            double lastSolveMs = 0.0;   // Velocity solve, including the rebuild
+        };
+
+        /*!
+        \brief Timing of one agent count from RunBenchmark.
+        */
+        struct BenchmarkResult
+        {
+            int agents = 0;
+            double averageSolveMs = 0.0;
+            double averageNeighbours = 0.0;
+        };
+
+        /*!
+        \brief Removes every agent. Called before the agents of an update are added.
+        */
+        void Clear();
+
+        /**************************************************************************/
+        /*!
+        \brief Adds an agent for the next solve.
+
+        \param[in] x, y
+        The position of the agent.
+
+        \param[in] radius
+        The radius of the agent.
+
+        \param[in] currentX, currentY
+        The velocity the agent moved with on the last step.
+
+        \param[in] preferredX, preferredY
+        The velocity the agent would take without anyone in the way.
+
+        \param[in] maxSpeed
+        The fastest the agent may move. Agents with 0 hold their position and the
+        others go around them.
+
+        \return
+        The index of the agent.
+        */
+        /**************************************************************************/
+        int AddAgent(float x, float y, float radius, float currentX, float currentY, float preferredX, float preferredY, float maxSpeed);
+
+        /**************************************************************************/
+        /*!
+        \brief Computes collision-free velocities for every agent.
+
+        \param[in] timeStep
+        The length of the step the velocities will be applied for.
+        */
+        /**************************************************************************/
+        void Solve(float timeStep);
+
+        float GetVelocityX(int agent) const { return velocityX[agent]; }
+        float GetVelocityY(int agent) const { return velocityY[agent]; }
+        int GetAgentCount() const { return static_cast<int>(positionX.size()); }
+
+        void SetSettings(const Settings& _settings) { settings = _settings; }
+        const Settings& GetSettings() const { return settings; }
+
+        /*!
+        \brief Gets the counters of the last solve.
+        \return A reference to the statistics.
+        */
+        const Stats& GetStats() const { return stats; }
+
+        /**************************************************************************/
+        /*!
+        \brief Times the solve on a dense crowd of agents walking through each
+        other, as in a battle line.
+
+        \param[in] agentCount
+        The number of agents.
+
+        \param[in] steps
+        The number of steps timed.
+
+        \return
+        The average time per step.
+        */
+        /**************************************************************************/
+        static BenchmarkResult RunBenchmark(int agentCount, int steps);
+
+    private:
+        void BuildSpatialHash();
+        uint32_t BucketOf(int cellX, int cellY) const;
+        void SolveRange(int begin, int end, float timeStep, int& neighbourCount);
+
+        Settings settings;
+        Stats stats;
+
+        // Agent data, one array per field
+        std::vector<float> positionX, positionY;
+        std::vector<float> currentVelocityX, currentVelocityY;
+        std::vector<float> preferredX, preferredY;
+        std::vector<float> velocityX, velocityY;
+        std::vector<float> radius;
+        std::vector<float> maxSpeed;
+
+        // Spatial hash. Agents of bucket b are cellAgents[cellStart[b]] to cellAgents[cellStart[b + 1] - 1]
+        float cellSize = 1.0f;
+        uint32_t cellMask = 0;
+        std::vector<int> cellStart;
+        std::vector<int> cellAgents;
+        std::vector<uint32_t> agentBucket;
+    };
+}
+#endif ENGINE_CROWDAVOIDANCE_H
@@ -0,0 +1,266 @@
+/******************************************************************************/
+/*!
+\file		CullingGrid.cpp
+\author 	Wayne Kwok Jun Lin
+\par    	email: k.junlinwayne@digipen.edu
+\date   	April 16, 2024
+\brief		This file contains the implementation of the CullingGrid class.
+Copyright (C) 2024 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the prior
+written consent of DigiPen Institute of Technology is prohibited.
+ */
+ /******************************************************************************/
+#include "pch.h"
+#include "CullingGrid.h"
+#include <chrono>
+#include <cmath>
+
+namespace Engine
+{
+    namespace
+    {
+        // Half the size of the entity quad drawn by the sprite batch
+        const float QUAD_HALF_SIZE = 50.0f;
+        // Keeps cell coordinates of stray transforms within int range
+        const float MAX_CELL = 1.0e6f;
+    }
+
+    void CullingGrid::BeginSync()
+    {
+        syncStart = std::chrono::high_resolution_clock::now();
+        ++currentSync;
+        pendingUpdates = 0;
+    }
+
+    void CullingGrid::Update(EntityID id, const Transform2D& transform, bool moved)
+    {
+        auto it = indexOf.find(id);
+        int index;
+        if (it == indexOf.end())
+        {
+            index = static_cast<int>(renderables.size());
+            Renderable renderable{};
+            renderable.id = id;
+            renderables.push_back(renderable);
+            indexOf[id] = index;
+        }
+        else
+        {
+            index = it->second;
+            renderables[index].boundSync = currentSync;
+            if (!moved)
+            {
+                return;
+            }
+            Erase(index);
+        }
+
+        Renderable& renderable = renderables[index];
+        renderable.boundSync = currentSync;
+        renderable.bounds = QuadBounds(transform);
+        Insert(index);
+        ++pendingUpdates;
+    }
+
+    void CullingGrid::Cull(const Bounds& view)
+    {
+        // Renderables not updated this sync were destroyed or lost their texture
+        for (int i = static_cast<int>(renderables.size()) - 1; i >= 0; --i)
+        {
+            if (renderables[i].boundSync != currentSync)
+            {
+                RemoveAt(i);
+            }
+        }
+
+        ++currentStamp;
+        stats.cellsVisited = 0;
+        int visible = 0;
+
+        int cellMinX = CellOf(view.minX), cellMaxX = CellOf(view.maxX);
+        int cellMinY = CellOf(view.minY), cellMaxY = CellOf(view.maxY);
+        int64_t viewCells = static_cast<int64_t>(cellMaxX - cellMinX + 1) * (cellMaxY - cellMinY + 1);
+
+        if (viewCells > static_cast<int64_t>(renderables.size()))
+        {
+            // Zoomed far out, testing every renderable is cheaper than walking the cells
+            for (Renderable& renderable : renderables)
+            {
+                if (Overlaps(renderable.bounds, view))
+                {
+                    renderable.visibleStamp = currentStamp;
+                    ++visible;
+                }
+            }
+        }
+        else
+        {
+            for (int cellY = cellMinY; cellY <= cellMaxY; ++cellY)
+            {
+                for (int cellX = cellMinX; cellX <= cellMaxX; ++cellX)
+                {
+                    auto cell = cells.find(CellKey(cellX, cellY));
+                    if (cell == cells.end())
+                    {
+                        continue;
+                    }
+                    ++stats.cellsVisited;
+                    for (int index : cell->second)
+                    {
+                        // Renderables spanning several cells are only tested once
+                        Renderable& renderable = renderables[index];
+                        if (renderable.visitStamp == currentStamp)
+                        {
+                            continue;
+                        }
+                        renderable.visitStamp = currentStamp;
+                        if (Overlaps(renderable.bounds, view))
+                        {
+                            renderable.visibleStamp = currentStamp;
+                            ++visible;
+                        }
+                    }
+                }
+            }
+            for (int index : oversized)
+            {
+                Renderable& renderable = renderables[index];
+                if (Overlaps(renderable.bounds, view))
+                {
+                    renderable.visibleStamp = currentStamp;
+                    ++visible;
+                }
+            }
+        }
+
+        stats.renderables = static_cast<int>(renderables.size());
+        stats.visible = visible;
+        stats.culled = stats.renderables - visible;
+        stats.boundsUpdates = pendingUpdates;
+        stats.lastCullMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - syncStart).count();
+    }
+
+    bool CullingGrid::IsVisible(EntityID id) const
+    {
+        auto it = indexOf.find(id);
+        if (it == indexOf.end())
+        {
+            return true;
+        }
+        return renderables[it->second].visibleStamp == currentStamp;
+    }
+
+    void CullingGrid::Clear()
+    {
+        renderables.clear();
+        indexOf.clear();
+        cells.clear();
+        oversized.clear();
+        stats = Stats();
+    }
+
+    CullingGrid::Bounds CullingGrid::QuadBounds(const Transform2D& transform)
+    {
+        // Half extents of the transformed square, the absolute sum of its two half axes
+        float extentX = QUAD_HALF_SIZE * (std::fabs(transform.basis[0]) + std::fabs(transform.basis[2]));
+        float extentY = QUAD_HALF_SIZE * (std::fabs(transform.basis[1]) + std::fabs(transform.basis[3]));
+        float x = transform.translation[0];
+        float y = transform.translation[1];
+        return { x - extentX, y - extentY, x + extentX, y + extentY };
+    }
+
+    void CullingGrid::Insert(int index)
+    {
+        Renderable& renderable = renderables[index];
+        renderable.cellMinX = CellOf(renderable.bounds.minX);
+        renderable.cellMinY = CellOf(renderable.bounds.minY);
+        renderable.cellMaxX = CellOf(renderable.bounds.maxX);
+        renderable.cellMaxY = CellOf(renderable.bounds.maxY);
+        int64_t cellCount = static_cast<int64_t>(renderable.cellMaxX - renderable.cellMinX + 1) * (renderable.cellMaxY - renderable.cellMinY + 1);
+
+        renderable.oversized = cellCount > MAX_CELLS_PER_RENDERABLE;
+        if (renderable.oversized)
+        {
+            oversized.push_back(index);
+            return;
+        }
+        for (int cellY = renderable.cellMinY; cellY <= renderable.cellMaxY; ++cellY)
+        {
+            for (int cellX = renderable.cellMinX; cellX <= renderable.cellMaxX; ++cellX)
+            {
+                cells[CellKey(cellX, cellY)].push_back(index);
+            }
+        }
+    }
+
+    void CullingGrid::Erase(int index)
+    {
+        const Renderable& renderable = renderables[index];
+        auto removeFrom = [index](std::vector<int>& list)
+        {
+            for (size_t i = 0; i < list.size(); ++i)
+            {
+                if (list[i] == index)
+                {
+                    list[i] = list.back();
+                    list.pop_back();
+                    return;
+                }
+            }
+        };
+
+        if (renderable.oversized)
+        {
+            removeFrom(oversized);
+            return;
+        }
+        for (int cellY = renderable.cellMinY; cellY <= renderable.cellMaxY; ++cellY)
+        {
+            for (int cellX = renderable.cellMinX; cellX <= renderable.cellMaxX; ++cellX)
+            {
+                auto cell = cells.find(CellKey(cellX, cellY));
+                if (cell != cells.end())
+                {
+                    removeFrom(cell->second);
+                    if (cell->second.empty())
+                    {
+                        cells.erase(cell);
+                    }
+                }
+            }
+        }
+    }
+
+    void CullingGrid::RemoveAt(int index)
+    {
+        Erase(index);
+        indexOf.erase(renderables[index].id);
+
+        // Move the last renderable into the gap, refiling it under its new index
+        int last = static_cast<int>(renderables.size()) - 1;
+        if (index != last)
+        {
+            Erase(last);
+            renderables[index] = renderables[last];
+            indexOf[renderables[index].id] = index;
+            Insert(index);
+        }
+        renderables.pop_back();
+    }
+
+    int64_t CullingGrid::CellKey(int cellX, int cellY)
+    {
+        return (static_cast<int64_t>(cellX) << 32) ^ static_cast<uint32_t>(cellY);
+    }
+
+    int CullingGrid::CellOf(float coordinate)
+    {
+        float cell = std::floor(coordinate / CELL_SIZE);
+        return static_cast<int>(std::max(-MAX_CELL, std::min(cell, MAX_CELL)));
+    }
+
+    bool CullingGrid::Overlaps(const Bounds& a, const Bounds& b)
+    {
+        return a.minX <= b.maxX && a.maxX >= b.minX && a.minY <= b.maxY && a.maxY >= b.minY;
+    }
+}
@@ -0,0 +1,147 @@
+/******************************************************************************/
+/*!
+\file		CullingGrid.h
+\author 	Wayne Kwok Jun Lin
+\par    	email: k.junlinwayne@digipen.edu
+\date   	April 16, 2024
+\brief		This file contains the declaration of the CullingGrid class, which
+            keeps the world bounds of every renderable in a uniform grid and
+            finds the ones overlapping the camera view. Bounds are cached and
+            only recomputed, and moved between cells, when the transform
+            cache reports the transform they were built from changed.
+
+Copyright (C) 2024 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the prior
+written consent of DigiPen Institute of Technology is prohibited.
+ */
+ /******************************************************************************/
+#ifndef ENGINE_CULLINGGRID_H
+#define ENGINE_CULLINGGRID_H
+
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include <chrono>
+#include "EngineTypes.h"
+#include "Transform2D.h"
+
+namespace Engine
+{
+    class CullingGrid
+    {
+    public:
+        // Axis-aligned rectangle in world units
+        struct Bounds
+        {
+            float minX = 0.0f, minY = 0.0f;
+            float maxX = 0.0f, maxY = 0.0f;
+        };
+
+        /*!
+        \brief Counters describing the last cull.
+        */
+        struct Stats
+        {
+            int renderables = 0;
+            int visible = 0;
+            int culled = 0;
+            int boundsUpdates = 0;      // Renderables whose transform changed since the last cull
+            int cellsVisited = 0;
+            double lastCullMs = 0.0;    // Updating the bounds and querying the grid
+        };
+
+        /**************************************************************************/
+        /*!
+        \brief Starts a new sync. Every renderable not updated again before Cull
+        is removed.
+        */
+        /**************************************************************************/
+        void BeginSync();
+
+        /**************************************************************************/
+        /*!
+        \brief Updates the bounds of a renderable drawn as the 100 by 100 entity
+        quad. The bounds are only rebuilt for new renderables or moved ones.
+
+        \param[in] id
+        The entity drawn.
+
+        \param[in] transform
+        The transform the entity is drawn with.
+
+        \param[in] moved
+        Whether the transform changed since the last sync.
+        */
+        /**************************************************************************/
+        void Update(EntityID id, const Transform2D& transform, bool moved);
+
+        /**************************************************************************/
+        /*!
+        \brief Removes the renderables not updated since BeginSync, then marks the
+        ones overlapping the view as visible.
+
+        \param[in] view
+        The world rectangle seen by the camera.
+        */
+        /**************************************************************************/
+        void Cull(const Bounds& view);
+
+        /*!
+        \brief Checks whether a renderable overlapped the view in the last cull.
+        \param[in] id The entity.
+        \return True if visible, or if the entity is unknown to the grid.
+        */
+        bool IsVisible(EntityID id) const;
+
+        /*!
+        \brief Removes every renderable.
+        */
+        void Clear();
+
+        /*!
+        \brief Gets the counters of the last cull.
+        \return A reference to the statistics.
+        */
+        const Stats& GetStats() const { return stats; }
+
+        /*!
+        \brief Computes the world bounds of the transformed entity quad.
+        \param[in] transform The transform of the quad.
+        \return The bounds.
+        */
+        static Bounds QuadBounds(const Transform2D& transform);
+
+        static constexpr float CELL_SIZE = 256.0f;
+        static constexpr int MAX_CELLS_PER_RENDERABLE = 64;  // Larger renderables are tested every cull instead
+
+    private:
+        struct Renderable
+        {
+            EntityID id;
+            Bounds bounds;
+            int cellMinX, cellMinY, cellMaxX, cellMaxY;
+            bool oversized;
+            unsigned int boundSync;
+            unsigned int visitStamp;
+            unsigned int visibleStamp;
+        };
+
+        void Insert(int index);
+        void Erase(int index);
+        void RemoveAt(int index);
+        static int64_t CellKey(int cellX, int cellY);
+        static int CellOf(float coordinate);
+        static bool Overlaps(const Bounds& a, const Bounds& b);
+
+        Stats stats;
+        std::vector<Renderable> renderables;
+        std::unordered_map<EntityID, int> indexOf;
+        std::unordered_map<int64_t, std::vector<int>> cells;
+        std::vector<int> oversized;
+        unsigned int currentSync = 0;
+        unsigned int currentStamp = 0;
+        int pendingUpdates = 0;
+        std::chrono::high_resolution_clock::time_point syncStart;
+    };
+}
+#endif ENGINE_CULLINGGRID_H
@@ -0,0 +1,157 @@
+/******************************************************************************/
+/*!
+\file		DistanceField.cpp
+\author		Ang Jun Sheng Aloysius, a.junshengaloysius, 2201807
+
+\par		a.junshengaloysius@digipen.edu
+
+\date		14/04/2024
+
+\brief		Contains the definitions of the navigation distance field.
+Copyright (C) 2024 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+ */
+ /******************************************************************************/
+
+#include "pch.h"
+#include "DistanceField.h"
+#include <cmath>
+
+namespace Engine
+{
+    namespace
+    {
+        // Offset of a cell with no source found yet, far enough to lose every comparison
+        const int16_t FAR_OFFSET = 16383;
+    }
+
+    void DistanceField::Propagate(std::vector<Offset>& offsets) const
+    {
+        // Takes the source of a neighbour if it is closer than the current one
+        auto compare = [&](Offset& current, int nx, int ny, int16_t stepX, int16_t stepY)
+            {
+                if (nx < 0 || ny < 0 || nx >= width || ny >= height)
+                {
+                    return;
+                }
+                const Offset& other = offsets[Index(nx, ny)];
+                if (other.x == FAR_OFFSET)
+                {
+                    return;
+                }
+                Offset candidate = { static_cast<int16_t>(other.x + stepX), static_cast<int16_t>(other.y + stepY) };
+                if (current.x == FAR_OFFSET || candidate.LengthSquared() < current.LengthSquared())
+                {
+                    current = candidate;
+                }
+            };
+
+        for (int y = 0; y < height; ++y)
+        {
+            for (int x = 0; x < width; ++x)
+            {
+                Offset& current = offsets[Index(x, y)];
+                compare(current, x - 1, y, -1, 0);
+                compare(current, x, y - 1, 0, -1);
+                compare(current, x - 1, y - 1, -1, -1);
+                compare(current, x + 1, y - 1, 1, -1);
+            }
+            for (int x = width - 1; x >= 0; --x)
+            {
+                compare(offsets[Index(x, y)], x + 1, y, 1, 0);
+            }
+        }
+
+        for (int y = height - 1; y >= 0; --y)
+        {
+            for (int x = width - 1; x >= 0; --x)
+            {
+                Offset& current = offsets[Index(x, y)];
+                compare(current, x + 1, y, 1, 0);
+                compare(current, x, y + 1, 0, 1);
+                compare(current, x - 1, y + 1, -1, 1);
+                compare(current, x + 1, y + 1, 1, 1);
+            }
+            for (int x = 0; x < width; ++x)
+            {
+                compare(offsets[Index(x, y)], x - 1, y, -1, 0);
+            }
+        }
+    }
+
+    void DistanceField::Build(const OccupancyGrid& grid, unsigned int mapVersion)
+    {
+        if (IsBuilt(mapVersion) && width == grid.GetWidth() && height == grid.GetHeight())
+        {
+            return;
+        }
+
+        auto buildStart = std::chrono::high_resolution_clock::now();
+        width = grid.GetWidth();
+        height = grid.GetHeight();
+        size_t cellCount = static_cast<size_t>(width) * height;
+
+        // Closest obstacle, measured from the free cells
+        std::vector<Offset> nearestBlocked(cellCount);
+        nearestFree.assign(cellCount, { FAR_OFFSET, FAR_OFFSET });
+        for (int y = 0; y < height; ++y)
+        {
+            for (int x = 0; x < width; ++x)
+            {
+                bool blocked = grid.IsBlocked(x, y);
+                nearestBlocked[Index(x, y)] = blocked ? Offset{ 0, 0 } : Offset{ FAR_OFFSET, FAR_OFFSET };
+                if (!blocked)
+                {
+                    nearestFree[Index(x, y)] = { 0, 0 };
+                }
+            }
+        }
+        Propagate(nearestBlocked);
+        Propagate(nearestFree);
+
+        clearance.assign(cellCount, 0);
+        stats.maxClearance = 0;
+        for (int y = 0; y < height; ++y)
+        {
+            for (int x = 0; x < width; ++x)
+            {
+                const Offset& offset = nearestBlocked[Index(x, y)];
+                if (offset.x == 0 && offset.y == 0)
+                {
+                    continue;
+                }
+
+                // The edge of the map is as solid as any obstacle
+                int edge = std::min({ x + 1, y + 1, width - x, height - y });
+                int distance = offset.x == FAR_OFFSET ? edge :
+                    std::min(edge, static_cast<int>(std::sqrt(static_cast<double>(offset.LengthSquared()))));
+                clearance[Index(x, y)] = static_cast<uint16_t>(std::min(distance, static_cast<int>(UINT16_MAX)));
+                stats.maxClearance = std::max(stats.maxClearance, distance);
+            }
+        }
+
+        built = true;
+        version = mapVersion;
+        stats.memoryBytes = clearance.capacity() * sizeof(uint16_t) + nearestFree.capacity() * sizeof(Offset);
+        stats.buildMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - buildStart).count();
+    }
+
+    std::pair<int, int> DistanceField::NearestFree(int x, int y) const
+    {
+        if (width == 0 || height == 0)
+        {
+            return { x, y };
+        }
+
+        x = std::clamp(x, 0, width - 1);
+        y = std::clamp(y, 0, height - 1);
+        const Offset& offset = nearestFree[Index(x, y)];
+        if (offset.x == FAR_OFFSET)
+        {
+            return { x, y };
+        }
+        return { x + offset.x, y + offset.y };
+    }
+}
@@ -0,0 +1,160 @@
+/******************************************************************************/
+/*!
+\file		DistanceField.h
+\author		Ang Jun Sheng Aloysius, a.junshengaloysius, 2201807
+
+\par		a.junshengaloysius@digipen.edu
+
+\date		14/04/2024
+
+\brief		Contains the declaration of the navigation distance field. Built
+			once per navigation map version from the occupancy grid, it answers
+			the clearance at a cell and the closest walkable cell to any cell
+			in constant time.
+Copyright (C) 2024 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+ */
+ /******************************************************************************/
+#ifndef ENGINE_DISTANCEFIELD_H
+#define ENGINE_DISTANCEFIELD_H
+
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include "OccupancyGrid.h"
+
+namespace Engine
+{
+    class DistanceField
+    {
+    public:
+        /*!
+        \brief Counters describing the last build.
+        */
+        struct Stats
+        {
+            double buildMs = 0.0;
+            size_t memoryBytes = 0;
+            int maxClearance = 0;
+        };
+
+        /**************************************************************************/
+        /*!
+        \brief Computes the clearance and closest free cell of every cell. Does
+        nothing if the field was already built for the given map version.
+
+        \param[in] grid
+        The occupancy grid to measure.
+
+        \param[in] mapVersion
+        The version of the navigation map the grid belongs to.
+        */
+        /**************************************************************************/
+        void Build(const OccupancyGrid& grid, unsigned int mapVersion);
+
+        /*!
+        \brief Checks if the field is current for a map version.
+        \param[in] mapVersion The current navigation map version.
+        \return True if Build has run for that version.
+        */
+        bool IsBuilt(unsigned int mapVersion) const { return built && version == mapVersion; }
+
+        /*!
+        \brief Gets the clearance of a cell: the distance in cells from its centre
+        to the closest obstacle or the edge of the map, rounded down. A unit
+        with a radius of r cells fits on cells with a clearance above r.
+        \param[in] x, y The cell.
+        \return The clearance, 0 for blocked cells and cells outside the map.
+        */
+        int GetClearance(int x, int y) const
+        {
+            if (x < 0 || y < 0 || x >= width || y >= height)
+            {
+                return 0;
+            }
+            return clearance[Index(x, y)];
+        }
+
+        /**************************************************************************/
+        /*!
+        \brief Finds the walkable cell closest to a cell.
+
+        \param[in] x, y
+        The cell. Cells outside the map are clamped to its edge first.
+
+        \return
+        The cell itself if it is free, otherwise the closest free cell. The
+        clamped cell if the map has no free cell at all.
+        */
+        /**************************************************************************/
+        std::pair<int, int> NearestFree(int x, int y) const;
+
+        /*!
+        \brief Checks if the straight line between two cells stays on cells with
+        more than a given clearance, without cutting corners.
+        \param[in] x0, y0 The first cell.
+        \param[in] x1, y1 The second cell.
+        \param[in] radius The radius of the unit in cells.
+        \return True if the line is clear for the unit.
+        */
+        bool HasLineOfSight(int x0, int y0, int x1, int y1, int radius) const
+        {
+            return OccupancyGrid::LineOfSight(x0, y0, x1, y1, [this, radius](int x, int y) { return GetClearance(x, y) <= radius; });
+        }
+
+        /*!
+        \brief Checks if a unit of the given radius cannot stand on a cell. Cells
+        within the radius of the start or goal only need to be free, so a wide
+        unit can still leave or reach a point next to a wall.
+        \param[in] x, y The cell.
+        \param[in] radius The radius of the unit in cells.
+        \param[in] startX, startY The start cell of the unit's path.
+        \param[in] goalX, goalY The goal cell of the unit's path.
+        \return True if the unit cannot stand on the cell.
+        */
+        bool BlocksUnit(int x, int y, int radius, int startX, int startY, int goalX, int goalY) const
+        {
+            int cellClearance = GetClearance(x, y);
+            if (cellClearance > radius)
+            {
+                return false;
+            }
+            auto isNearby = [radius, x, y](int px, int py) { return (x - px) * (x - px) + (y - py) * (y - py) <= radius * radius; };
+            return cellClearance == 0 || !(isNearby(startX, startY) || isNearby(goalX, goalY));
+        }
+
+        int GetWidth() const { return width; }
+        int GetHeight() const { return height; }
+
+        /*!
+        \brief Gets the statistics of the last build.
+        \return The statistics.
+        */
+        const Stats& GetStats() const { return stats; }
+
+    private:
+        // Offset from a cell to its closest source cell
+        struct Offset
+        {
+            int16_t x, y;
+            int LengthSquared() const { return x * x + y * y; }
+        };
+
+        int Index(int x, int y) const { return y * width + x; }
+
+        // Two-pass vector propagation (8SSEDT). Sources start at a zero offset,
+        // every other cell ends up pointing at its closest source
+        void Propagate(std::vector<Offset>& offsets) const;
+
+        int width = 0;
+        int height = 0;
+        bool built = false;
+        unsigned int version = 0;
+        std::vector<uint16_t> clearance;
+        std::vector<Offset> nearestFree;
+        Stats stats;
+    };
+}
+#endif ENGINE_DISTANCEFIELD_H
@@ -15,6 +15,7 @@ written consent of DigiPen Institute of Technology is prohibited.
 #include "pch.h"
 #include "EditorFBO.h"
 #include <GLFW/glfw3.h>
+#include "GLState.h"
 
 // Default constructor initializing member variables
 EditorFBO::EditorFBO() : fbo(0), texture(0), width(0), height(0) {}
@@ -22,6 +23,7 @@ EditorFBO::EditorFBO() : fbo(0), texture(0), width(0), height(0) {}
 // Destructor releasing OpenGL resources
 EditorFBO::~EditorFBO() {
     glDeleteFramebuffers(1, &fbo);
+    GLState::GetInstance().ForgetTexture(texture);
     glDeleteTextures(1, &texture);
 }
 
@@ -66,13 +68,13 @@ void EditorFBO::SetupTexture() {
     if (!glfwGetWindowAttrib(glfwGetCurrentContext(), GLFW_ICONIFIED)) {
 
         glGenTextures(1, &texture);
-        glBindTexture(GL_TEXTURE_2D, texture);
+        GLState::GetInstance().BindTexture(texture);
 
         glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, nullptr);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
-        glBindTexture(GL_TEXTURE_2D, 0);
+        GLState::GetInstance().BindTexture(0);
         glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture, 0);
 
         if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
@@ -90,6 +92,7 @@ void EditorFBO::SetupTexture() {
 void EditorFBO::Resize(int newWidth, int newHeight)
 {
     // Delete the old texture and FBO
+    GLState::GetInstance().ForgetTexture(texture);
     glDeleteTextures(1, &texture);
     glDeleteFramebuffers(1, &fbo);
 
@@ -44,6 +44,9 @@ std::string c_stateToString(c_state state);
 // Layer Enumeration
 enum class Layer { World, Interactive, Editable, inGameGUI, BeforeSpawn, Tower, Castle, Arrow }; //!< Enumeration for different layers in the game.
 
+// Body Type Enumeration
+enum class BodyType { Static, Kinematic, Dynamic }; //!< How a collider moves: never, by scripts and pathfinding, or by the physics.
+
 // Texture Class Enumeration
 enum TextureClass //!< Enumeration for different texture classes.
 {
@@ -16,6 +16,9 @@
  /******************************************************************************/
 #include "pch.h"
 #include "Font.h"
+#include "GLState.h"
+#include "Renderer.h"
+#include <charconv>
 
 
 namespace Engine
@@ -27,8 +30,8 @@ namespace Engine
         // OpenGL state
         // ------------
         glEnable(GL_CULL_FACE);
-        glEnable(GL_BLEND);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        GLState::GetInstance().SetBlend(true);
+        GLState::GetInstance().BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
         // compile and setup the shader
         // ----------------------------
@@ -51,6 +54,10 @@ namespace Engine
             //std::cout << "ERROR::FREETYPE: Could not init FreeType Library" << std::endl;
             exit(-1);
         }
+        // Half of FreeType's default spread of 8 keeps the glyph bitmaps and the atlas small. The spread
+        // also caps the outline width, about 5 pixels at REFERENCE_PIXEL_SIZE, see SetOutline
+        FT_Int spread = SDF_SPREAD;
+        FT_Property_Set(ft, "sdf", "spread", &spread);
 
         // find path to font
         //pathName = "Resource/Fonts/arial.ttf";
@@ -80,24 +87,27 @@ namespace Engine
         if (FT_New_Face(ft, pathName2.c_str(), 0, &face2)) {
             exit(-1);
         }
-        // Set size to load glyphs as
-        FT_Set_Pixel_Sizes(face1, 0, 48);
+        // Set size to render the distance fields at
+        FT_Set_Pixel_Sizes(face1, 0, SDF_PIXEL_SIZE);
 
-        FT_Set_Pixel_Sizes(face2, 0, 48);
+        FT_Set_Pixel_Sizes(face2, 0, SDF_PIXEL_SIZE);
 
         // Disable byte-alignment restriction
         glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
 
-        // configure VAO/VBO for texture quads
+        // configure VAO/VBO for a batch of glyph quads
         glGenVertexArrays(1, &VAO);
         glGenBuffers(1, &VBO);
-        glBindVertexArray(VAO);
-        glBindBuffer(GL_ARRAY_BUFFER, VBO);
-        glBufferData(GL_ARRAY_BUFFER, sizeof(float) * 6 * 4, NULL, GL_DYNAMIC_DRAW);
+        GLState::GetInstance().BindVertexArray(VAO);
+        GLState::GetInstance().BindBuffer(GL_ARRAY_BUFFER, VBO);
+        glBufferData(GL_ARRAY_BUFFER, sizeof(TextVertex) * 6 * MAX_BATCH_GLYPHS, NULL, GL_DYNAMIC_DRAW);
         glEnableVertexAttribArray(0);
-        glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float), 0);
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-        glBindVertexArray(0);
+        glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, sizeof(TextVertex), 0);
+        glEnableVertexAttribArray(1);
+        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(TextVertex), reinterpret_cast<const void*>(offsetof(TextVertex, r)));
+        GLState::GetInstance().BindBuffer(GL_ARRAY_BUFFER, 0);
+        GLState::GetInstance().BindVertexArray(0);
+        vertices.reserve(static_cast<size_t>(MAX_BATCH_GLYPHS) * 6);
 
         // Now you can call MakeDisplayList to load glyphs
         MakeDisplayList(pathName);
@@ -114,104 +124,153 @@ namespace Engine
 
     void font::LoadGlyphsForFace(FT_Face face)
     {
-        if (face == face1) {
-            for (unsigned char c = 0; c <= 128; c++)
+        FontFace* fontFace = face == face1 ? &Faces[0] : face == face2 ? &Faces[1] : nullptr;
+        if (!fontFace)
+        {
+            return;
+        }
+
+        // Copy every glyph out of FreeType first, placing them in rows across the atlas
+        const int padding = 1;  // Empty pixels between glyphs so filtering never samples a neighbour
+        struct Bitmap
+        {
+            int x, y, width, height;
+            std::vector<unsigned char> pixels;
+        };
+        std::vector<Bitmap> bitmaps(GLYPH_COUNT);
+        int penX = padding, penY = padding, rowHeight = 0;
+        const float toReference = static_cast<float>(REFERENCE_PIXEL_SIZE) / SDF_PIXEL_SIZE;
+        for (int c = 0; c < GLYPH_COUNT; c++)
+        {
+            if (FT_Load_Char(face, c, FT_LOAD_DEFAULT))
             {
-                if (FT_Load_Char(face, c, FT_LOAD_RENDER))
-                {
-                    //std::cout << "ERROR::FREETYTPE: Failed to load Glyph for character '" << c << "'" << std::endl;
-                    continue;
-                }
-
-                // generate texture
-     
-                glGenTextures(1, &texture);
-                glBindTexture(GL_TEXTURE_2D, texture);
-                glTexImage2D(
-                    GL_TEXTURE_2D,
-                    0,
-                    GL_RED,
-                    face->glyph->bitmap.width,
-                    face->glyph->bitmap.rows,
-                    0,
-                    GL_RED,
-                    GL_UNSIGNED_BYTE,
-                    face->glyph->bitmap.buffer
-                );
-                // set texture options
-                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-                // now store character for later use
-                Character character = {
-                    texture,
-                    glm::ivec2(face->glyph->bitmap.width, face->glyph->bitmap.rows),
-                    glm::ivec2(face->glyph->bitmap_left, face->glyph->bitmap_top),
-                    static_cast<unsigned int>(face->glyph->advance.x)
-                };
-                Characters1.insert(std::pair<char, Character>(c, character));
+                //std::cout << "ERROR::FREETYTPE: Failed to load Glyph for character '" << c << "'" << std::endl;
+                continue;
             }
+
+            Character& character = fontFace->Glyphs[c];
+            character.Advance = face->glyph->advance.x / 64.0f * toReference;
+
+            // Glyphs without an outline, such as spaces, only advance the text
+            if (face->glyph->format != FT_GLYPH_FORMAT_OUTLINE || face->glyph->outline.n_points == 0 ||
+                FT_Render_Glyph(face->glyph, FT_RENDER_MODE_SDF))
+            {
+                continue;
+            }
+
+            const FT_Bitmap& glyph = face->glyph->bitmap;
+            Bitmap& bitmap = bitmaps[c];
+            bitmap.width = static_cast<int>(glyph.width);
+            bitmap.height = static_cast<int>(glyph.rows);
+            if (penX + bitmap.width + padding > ATLAS_WIDTH)
+            {
+                penX = padding;
+                penY += rowHeight + padding;
+                rowHeight = 0;
+            }
+            bitmap.x = penX;
+            bitmap.y = penY;
+            penX += bitmap.width + padding;
+            rowHeight = std::max(rowHeight, bitmap.height);
+            for (int row = 0; row < bitmap.height; row++)
+            {
+                const unsigned char* source = glyph.buffer + row * glyph.pitch;
+                bitmap.pixels.insert(bitmap.pixels.end(), source, source + bitmap.width);
+            }
+
+            // now store character for later use, its texture coordinates are set once the atlas size is known
+            character.Size = glm::vec2(bitmap.width, bitmap.height) * toReference;
+            character.Bearing = glm::vec2(face->glyph->bitmap_left, face->glyph->bitmap_top) * toReference;
+        }
+
+        int atlasHeight = 1;
+        while (atlasHeight < penY + rowHeight + padding)
+        {
+            atlasHeight <<= 1;
         }
-        else if (face == face2){
-            for (unsigned char c = 0; c <= 128; c++)
+        std::vector<unsigned char> atlas(static_cast<size_t>(ATLAS_WIDTH) * atlasHeight, 0);
+        for (int c = 0; c < GLYPH_COUNT; c++)
+        {
+            const Bitmap& bitmap = bitmaps[c];
+            for (int row = 0; row < bitmap.height; row++)
             {
-                if (FT_Load_Char(face, c, FT_LOAD_RENDER))
-                {
-                    //std::cout << "ERROR::FREETYTPE: Failed to load Glyph for character '" << c << "'" << std::endl;
-                    continue;
-                }
-
-                // generate texture
-                glGenTextures(1, &texture);
-                glBindTexture(GL_TEXTURE_2D, texture);
-                glTexImage2D(
-                    GL_TEXTURE_2D,
-                    0,
-                    GL_RED,
-                    face->glyph->bitmap.width,
-                    face->glyph->bitmap.rows,
-                    0,
-                    GL_RED,
-                    GL_UNSIGNED_BYTE,
-                    face->glyph->bitmap.buffer
-                );
-                // set texture options
-                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-                // now store character for later use
-                Character character = {
-                    texture,
-                    glm::ivec2(face->glyph->bitmap.width, face->glyph->bitmap.rows),
-                    glm::ivec2(face->glyph->bitmap_left, face->glyph->bitmap_top),
-                    static_cast<unsigned int>(face->glyph->advance.x)
-                };
-                Characters2.insert(std::pair<char, Character>(c, character));
+                std::copy(bitmap.pixels.begin() + row * bitmap.width, bitmap.pixels.begin() + (row + 1) * bitmap.width,
+                    atlas.begin() + static_cast<size_t>(bitmap.y + row) * ATLAS_WIDTH + bitmap.x);
             }
+            // The first bitmap row is the top of the glyph
+            fontFace->Glyphs[c].UVRect = glm::vec4(
+                static_cast<float>(bitmap.x) / ATLAS_WIDTH, static_cast<float>(bitmap.y) / atlasHeight,
+                static_cast<float>(bitmap.x + bitmap.width) / ATLAS_WIDTH, static_cast<float>(bitmap.y + bitmap.height) / atlasHeight);
         }
-        glBindTexture(GL_TEXTURE_2D, 0);
+
+        // generate texture
+        glGenTextures(1, &fontFace->AtlasTexture);
+        GLState::GetInstance().BindTexture(fontFace->AtlasTexture);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RED, ATLAS_WIDTH, atlasHeight, 0, GL_RED, GL_UNSIGNED_BYTE, atlas.data());
+        // set texture options
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        GLState::GetInstance().BindTexture(0);
         FT_Done_Face(face);
     }
 
-    void font::RenderText(Shader& shader, std::string text, float x, float y, float scale, glm::vec3 color)
+    void font::Text::Set(std::string_view text, float _x, float _y, float _scale, glm::vec3 _color)
     {
-        // activate corresponding render state    
-        shader.SetActiveShaderSet(3);
-        shader.Bind();
-        glUniform3f(glGetUniformLocation(shader.GetID(), "textColor"), color.x, color.y, color.z);
-        glBindTexture(GL_TEXTURE_2D, texture);
-        glActiveTexture(GL_TEXTURE0);
-        glBindVertexArray(VAO);
+        if (text == string && _x == x && _y == y && _scale == scale && _color == color)
+        {
+            return;
+        }
+        string.assign(text.data(), text.size());
+        x = _x;
+        y = _y;
+        scale = _scale;
+        color = _color;
+        dirty = true;
+    }
 
+    void font::RenderText(Shader& shader, std::string_view text, float x, float y, float scale, glm::vec3 color)
+    {
+        if (currentFont < 0)
+        {
+            return;
+        }
+        scratch.clear();
+        Layout(Faces[currentFont], text, x, y, scale, color, scratch);
+        ++stats.layouts;
+        Queue(shader, Faces[currentFont].AtlasTexture, scratch);
+    }
+
+    void font::RenderText(Shader& shader, Text& text)
+    {
+        if (currentFont < 0)
+        {
+            return;
+        }
+        if (text.dirty || text.layoutFont != currentFont)
+        {
+            text.vertices.clear();
+            Layout(Faces[currentFont], text.string, text.x, text.y, text.scale, text.color, text.vertices);
+            text.layoutFont = currentFont;
+            text.dirty = false;
+            ++stats.layouts;
+        }
+        else
+        {
+            ++stats.cachedTexts;
+        }
+        Queue(shader, Faces[currentFont].AtlasTexture, text.vertices);
+    }
+
+    void font::Layout(const FontFace& fontFace, std::string_view text, float x, float y, float scale, glm::vec3 color, std::vector<TextVertex>& out) const
+    {
         float halfWidth;
         float lengthWidth{};
         for (char c : text)
         {
-            Character ch = Characters1[c];
-            lengthWidth += (ch.Advance >> 6) * scale;
-
+            const Character& ch = fontFace.Glyphs[static_cast<unsigned char>(c)];
+            lengthWidth += ch.Advance * scale;
         }
 
         halfWidth = lengthWidth / 2.0f;
@@ -220,14 +279,7 @@ namespace Engine
         // iterate through all characters
         for (char c : text)
         {
-
-            Character ch = {};
-            if (currentFace == face1) {
-                ch = Characters1[c];
-            }
-            else if (currentFace == face2) {
-                ch = Characters2[c];
-            }
+            const Character& ch = fontFace.Glyphs[static_cast<unsigned char>(c)];
 
             float xpos = newx + ch.Bearing.x * scale;
             float ypos = y - (ch.Size.y - ch.Bearing.y) * scale;
@@ -235,35 +287,108 @@ namespace Engine
             float width = ch.Size.x * scale;
             float height = ch.Size.y * scale;
 
-            // update VBO for each character
-            float vertices[6][4] = {
-                { xpos,         ypos + height,   0.0f, 0.0f },
-                { xpos,         ypos,            0.0f, 1.0f },
-                { xpos + width, ypos,            1.0f, 1.0f },
+            // now advance cursors for next glyph
+            newx += ch.Advance * scale;
 
-                { xpos,         ypos + height,   0.0f, 0.0f },
-                { xpos + width, ypos,            1.0f, 1.0f },
-                { xpos + width, ypos + height,   1.0f, 0.0f }
-            };
+            // Text is placed in clip space, skip spaces and glyphs outside the screen
+            if (width <= 0.0f || height <= 0.0f || xpos > 1.0f || xpos + width < -1.0f || ypos > 1.0f || ypos + height < -1.0f)
+            {
+                continue;
+            }
 
-            // render glyph texture over quad
-            glBindTexture(GL_TEXTURE_2D, ch.TextureID);
+            const glm::vec4& uv = ch.UVRect;
+            const TextVertex topLeft     = { xpos,         ypos + height, uv.x, uv.y, color.r, color.g, color.b };
+            const TextVertex bottomLeft  = { xpos,         ypos,          uv.x, uv.w, color.r, color.g, color.b };
+            const TextVertex bottomRight = { xpos + width, ypos,          uv.z, uv.w, color.r, color.g, color.b };
+            const TextVertex topRight    = { xpos + width, ypos + height, uv.z, uv.y, color.r, color.g, color.b };
+            out.push_back(topLeft);
+            out.push_back(bottomLeft);
+            out.push_back(bottomRight);
+            out.push_back(topLeft);
+            out.push_back(bottomRight);
+            out.push_back(topRight);
+        }
+    }
 
-            // update VBO for each character
-            glBindBuffer(GL_ARRAY_BUFFER, VBO);
-            glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
-            glBindBuffer(GL_ARRAY_BUFFER, 0);
+    void font::Queue(Shader& shader, unsigned int atlasTexture, const std::vector<TextVertex>& glyphVertices)
+    {
+        // Text of another font comes from another atlas, so it goes in the next batch
+        if (atlasTexture != batchTexture && !vertices.empty())
+        {
+            Flush(shader);
+        }
+        batchTexture = atlasTexture;
 
-            // render quad
-            glDrawArrays(GL_TRIANGLES, 0, 6);
+        const size_t capacity = static_cast<size_t>(MAX_BATCH_GLYPHS) * 6;
+        size_t copied = 0;
+        while (copied < glyphVertices.size())
+        {
+            if (vertices.size() == capacity)
+            {
+                Flush(shader);
+            }
+            // Whole glyphs only, the capacity and both sizes are multiples of six
+            size_t count = std::min(capacity - vertices.size(), glyphVertices.size() - copied);
+            vertices.insert(vertices.end(), glyphVertices.begin() + copied, glyphVertices.begin() + copied + count);
+            copied += count;
+        }
+        stats.glyphs += static_cast<int>(glyphVertices.size() / 6);
+    }
 
-            // now advance cursors for next glyph
-            newx += (ch.Advance >> 6) * scale; // bitshift by 6 to get value in pixels
+    void font::SetOutline(Shader& shader, float width, glm::vec3 color)
+    {
+        // The field holds SDF_SPREAD pixels of distance at SDF_PIXEL_SIZE in half its range,
+        // and the outline has to fade out before the edge of the glyph quad
+        const float maxWidth = 0.45f;
+        float distance = std::min(width * SDF_PIXEL_SIZE / REFERENCE_PIXEL_SIZE * 0.5f / SDF_SPREAD, maxWidth);
+        distance = std::max(distance, 0.0f);
+        if (distance == outlineWidth && (distance == 0.0f || color == outlineColor))
+        {
+            return;
+        }
+        // Text queued so far keeps the outline it was queued with
+        Flush(shader);
+        outlineWidth = distance;
+        outlineColor = color;
+    }
 
+    void font::Flush(Shader& shader)
+    {
+        if (vertices.empty())
+        {
+            return;
+        }
+        GLState& state = GLState::GetInstance();
+        if (state.IsMinimized())
+        {
+            vertices.clear();
+            return;
         }
 
-        glBindVertexArray(0);
-        glBindTexture(GL_TEXTURE_2D, 0);
+        // activate corresponding render state
+        shader.SetActiveShaderSet(3);
+        shader.Bind();
+        if (!effectUniformsResolved)
+        {
+            outlineWidthUniform = shader.GetUniform<float>("u_OutlineWidth");
+            outlineColorUniform = shader.GetUniform<glm::vec3>("u_OutlineColor");
+            effectUniformsResolved = true;
+        }
+        shader.SetUniform(outlineWidthUniform, outlineWidth);
+        shader.SetUniform(outlineColorUniform, outlineColor);
+        state.BindTexture(0, batchTexture);
+        state.BindVertexArray(VAO);
+
+        // One upload and one draw for every glyph queued
+        state.BindBuffer(GL_ARRAY_BUFFER, VBO);
+        GLCall(glBufferSubData(GL_ARRAY_BUFFER, 0, vertices.size() * sizeof(TextVertex), vertices.data()));
+        GLCall(glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(vertices.size())));
+        ++stats.drawCalls;
+        vertices.clear();
+
+        state.BindBuffer(GL_ARRAY_BUFFER, 0);
+        state.BindVertexArray(0);
+        state.BindTexture(0);
         shader.Unbind();
     }
 
@@ -277,11 +402,39 @@ namespace Engine
 
     void font::SwitchFont(int fontIndex) {
         if (fontIndex == 1) {
-            currentFace = face1;
+            currentFont = 0;
         }
         else if (fontIndex == 2) {
-            currentFace = face2;
+            currentFont = 1;
         }
         // Error handling for invalid fontIndex...
     }
+
+    SmallString& SmallString::Append(std::string_view text)
+    {
+        size_t count = std::min(text.size(), static_cast<size_t>(CAPACITY) - length);
+        std::copy(text.begin(), text.begin() + count, buffer + length);
+        length += count;
+        return *this;
+    }
+
+    SmallString& SmallString::Append(long long value)
+    {
+        std::to_chars_result result = std::to_chars(buffer + length, buffer + CAPACITY, value);
+        if (result.ec == std::errc())
+        {
+            length = static_cast<size_t>(result.ptr - buffer);
+        }
+        return *this;
+    }
+
+    SmallString& SmallString::Append(double value, int precision)
+    {
+        std::to_chars_result result = std::to_chars(buffer + length, buffer + CAPACITY, value, std::chars_format::fixed, precision);
+        if (result.ec == std::errc())
+        {
+            length = static_cast<size_t>(result.ptr - buffer);
+        }
+        return *this;
+    }
 }
@@ -18,8 +18,9 @@
 #define ENGINE_FONT_H
 
 #include <iostream>
-#include <map>
 #include <string>
+#include <string_view>
+#include <vector>
 #include "Vector2d.h"
 
 #include <GL/glew.h>
@@ -30,6 +31,7 @@
 
 #include <ft2build.h>
 #include FT_FREETYPE_H
+#include FT_MODULE_H
 
 #include "Shader.h"
 
@@ -45,15 +47,84 @@ namespace Engine {
 		FT_Library ft{};
 		const float fscreenWidth = 1280.0f;
 		const float fscreenHeight = 720.0f;
-		FT_Face currentFace{};
 
 	public:
+		static constexpr int GLYPH_COUNT = 256;			// One entry per byte value of the text
+		static constexpr int FONT_COUNT = 2;
+		static constexpr int ATLAS_WIDTH = 1024;		// Rows of glyphs are packed left to right across it
+		static constexpr int MAX_BATCH_GLYPHS = 4096;	// Glyphs drawn per call
+		static constexpr int SDF_PIXEL_SIZE = 32;		// Size the distance fields are rendered at, any size is drawn from them
+		static constexpr int SDF_SPREAD = 4;			// Pixels of distance kept on each side of the outline
+		static constexpr int REFERENCE_PIXEL_SIZE = 48;	// Size the text scales are given for, one unit of scale is one pixel of it
 
+		// Sizes are in pixels of REFERENCE_PIXEL_SIZE, and include the spread of the distance field
 		struct Character {
-			unsigned int TextureID; // ID handle of the glyph texture
-			glm::ivec2   Size;      // Size of glyph
-			glm::ivec2   Bearing;   // Offset from baseline to left/top of glyph
-			unsigned int Advance;   // Horizontal offset to advance to next glyph
+			glm::vec4    UVRect;    // Texture coordinates of the glyph in the atlas, top-left (x, y) and bottom-right (z, w)
+			glm::vec2    Size;      // Size of glyph
+			glm::vec2    Bearing;   // Offset from baseline to left/top of glyph
+			float        Advance;   // Horizontal offset to advance to next glyph
+		};
+
+		// The signed distance fields of the glyphs of a face, all packed into one texture
+		struct FontFace {
+			unsigned int AtlasTexture = 0;
+			Character Glyphs[GLYPH_COUNT]{};
+		};
+
+		// Counters of the current frame, reset by BeginFrame
+		struct Stats {
+			int glyphs = 0;
+			int drawCalls = 0;
+			int layouts = 0;		// Strings laid out glyph by glyph
+			int cachedTexts = 0;	// Text objects drawn from their cached vertices
+		};
+
+		// One corner of a glyph quad, in clip space
+		struct TextVertex {
+			float x, y;
+			float u, v;
+			float r, g, b;
+		};
+
+		/*!
+		\brief
+		A string laid out once. Its vertices are kept between frames and only
+		rebuilt when the string, font, position, scale or color changes.
+		*/
+		class Text {
+		public:
+			/*!
+			\brief
+			Set what the text shows. Setting the same values again keeps the layout.
+
+			\param text
+			Text to render.
+
+			\param x
+			X-coordinate of the centre of the text.
+
+			\param y
+			Y-coordinate of the baseline.
+
+			\param scale
+			Scale factor for the text.
+
+			\param color
+			Color of the text.
+			*/
+			void Set(std::string_view text, float x, float y, float scale, glm::vec3 color);
+
+			const std::string& GetString() const { return string; }
+
+		private:
+			friend class font;
+
+			std::string string;
+			float x = 0.0f, y = 0.0f, scale = 1.0f;
+			glm::vec3 color{};
+			int layoutFont = -1;				// Font the vertices were laid out with
+			bool dirty = true;
+			std::vector<TextVertex> vertices;
 		};
 
 		struct TextInfo
@@ -83,10 +154,11 @@ namespace Engine {
 
 		/*!
 		\brief
-		Render the specified text at the given position, scale, and color using the provided shader.
+		Queue the specified text at the given position, scale, and color. The text is
+		drawn by the next Flush, together with the text queued before it.
 
 		\param shader
-		Shader program to use for rendering.
+		Shader program to use for rendering, flushed with if the font changes.
 
 		\param text
 		Text to render.
@@ -103,7 +175,61 @@ namespace Engine {
 		\param color
 		Color of the text.
 		*/
-		void RenderText(Shader& shader, std::string text, float x, float y, float scale, glm::vec3 color);
+		void RenderText(Shader& shader, std::string_view text, float x, float y, float scale, glm::vec3 color);
+
+		/*!
+		\brief
+		Queue a text object with the current font, laying it out again only if
+		it changed since it was last drawn.
+
+		\param shader
+		Shader program to use for rendering, flushed with if the font changes.
+
+		\param text
+		Text object to render.
+		*/
+		void RenderText(Shader& shader, Text& text);
+
+		/*!
+		\brief
+		Outline the text queued from now on. The outline is drawn from the same
+		distance field as the text, so it needs no glyphs of its own.
+
+		\param shader
+		Shader program to use for rendering, flushed with if the outline changes.
+
+		\param width
+		Width of the outline in pixels of REFERENCE_PIXEL_SIZE, 0 for none. It
+		is limited by the spread of the distance field.
+
+		\param color
+		Color of the outline.
+		*/
+		void SetOutline(Shader& shader, float width, glm::vec3 color);
+
+		/*!
+		\brief
+		Draw the queued text in one call.
+
+		\param shader
+		Shader program to use for rendering, switched to shader set 3.
+		*/
+		void Flush(Shader& shader);
+
+		/*!
+		\brief
+		Reset the counters for a new frame.
+		*/
+		void BeginFrame() { stats = Stats(); }
+
+		/*!
+		\brief
+		Get the counters of the current frame.
+
+		\return
+		A reference to the statistics.
+		*/
+		const Stats& GetStats() const { return stats; }
 
 		/*!
 		\brief
@@ -124,7 +250,8 @@ namespace Engine {
 
 		/*!
 		\brief
-		Load glyphs for the specified FreeType face.
+		Render the glyphs of the specified FreeType face as signed distance fields
+		and pack them into one atlas texture.
 
 		\param face
 		FreeType face for which to load glyphs.
@@ -132,12 +259,51 @@ namespace Engine {
 		void LoadGlyphsForFace(FT_Face face);
 
 		std::string pathName, pathName2;
-		std::map <char, Character> Characters1;
-		std::map <char, Character> Characters2;
+		FontFace Faces[FONT_COUNT];		// Faces[0] is face1, Faces[1] is face2
 		std::string font_name;
-		unsigned int texture = 0;
+
+	private:
+		// Append the glyph quads of a string, centred on x, to the vertices
+		void Layout(const FontFace& fontFace, std::string_view text, float x, float y, float scale, glm::vec3 color, std::vector<TextVertex>& out) const;
+
+		// Copy laid out glyphs into the batch, flushing when the atlas changes or the batch is full
+		void Queue(Shader& shader, unsigned int atlasTexture, const std::vector<TextVertex>& glyphVertices);
+
+		int currentFont = -1;					// Index into Faces, -1 until SwitchFont
+		std::vector<TextVertex> vertices;		// Queued glyphs, six corners each
+		unsigned int batchTexture = 0;			// Atlas the queued glyphs come from
+		std::vector<TextVertex> scratch;		// Layout of the text queued without a text object
+		float outlineWidth = 0.0f;				// In distance field units, where the outline is at 0.5
+		glm::vec3 outlineColor{};
+		bool effectUniformsResolved = false;
+		UniformHandle<float> outlineWidthUniform;
+		UniformHandle<glm::vec3> outlineColorUniform;
+		Stats stats;
 
 		//GLFWwindow* window{};
 	};
+
+	/*!
+	\brief
+	Builds short HUD strings such as counters and frame rates in a fixed
+	buffer, without the allocations of a string stream. Text that does not
+	fit is cut off.
+	*/
+	class SmallString
+	{
+	public:
+		static constexpr int CAPACITY = 64;
+
+		SmallString& Append(std::string_view text);
+		SmallString& Append(long long value);
+		SmallString& Append(double value, int precision);
+		void Clear() { length = 0; }
+
+		std::string_view View() const { return std::string_view(buffer, length); }
+
+	private:
+		char buffer[CAPACITY];
+		size_t length = 0;
+	};
 }
 #endif  ENGINE_FONT_H
\ No newline at end of file
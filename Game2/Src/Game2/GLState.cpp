@@ -0,0 +1,284 @@
+/******************************************************************************/
+/*!
+\file		GLState.cpp
+\author 	Wayne Kwok Jun Lin
+\par    	email: k.junlinwayne@digipen.edu
+\date   	April 17, 2024
+\brief		This file contains the implementation of the GLState class.
+Copyright (C) 2024 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the prior
+written consent of DigiPen Institute of Technology is prohibited.
+ */
+ /******************************************************************************/
+#include "pch.h"
+#include "GLState.h"
+#include "Renderer.h"
+#include <cstring>
+
+GLState& GLState::GetInstance()
+{
+    static GLState instance;
+    return instance;
+}
+
+void GLState::BeginFrame(bool _minimized)
+{
+    minimized = _minimized;
+    Invalidate();
+    stats = Stats();
+}
+
+void GLState::Invalidate()
+{
+    program = UNKNOWN;
+    activeUnit = UNKNOWN;
+    for (unsigned int& texture : textures)
+    {
+        texture = UNKNOWN;
+    }
+    vertexArray = UNKNOWN;
+    arrayBuffer = UNKNOWN;
+    elementBuffer = UNKNOWN;
+    blendEnabled = -1;
+    blendSource = UNKNOWN;
+    blendDestination = UNKNOWN;
+}
+
+void GLState::UseProgram(unsigned int _program)
+{
+    if (program == _program)
+    {
+        ++stats.programs.elided;
+        return;
+    }
+    GLCall(glUseProgram(_program));
+    program = _program;
+    ++stats.programs.issued;
+}
+
+void GLState::ActiveTexture(unsigned int unit)
+{
+    if (activeUnit == unit)
+    {
+        ++stats.textures.elided;
+        return;
+    }
+    GLCall(glActiveTexture(GL_TEXTURE0 + unit));
+    activeUnit = unit;
+    ++stats.textures.issued;
+}
+
+void GLState::BindTexture(unsigned int unit, unsigned int texture)
+{
+    if (unit < MAX_TEXTURE_UNITS && textures[unit] == texture)
+    {
+        ++stats.textures.elided;
+        return;
+    }
+    ActiveTexture(unit);
+    GLCall(glBindTexture(GL_TEXTURE_2D, texture));
+    if (unit < MAX_TEXTURE_UNITS)
+    {
+        textures[unit] = texture;
+    }
+    ++stats.textures.issued;
+}
+
+void GLState::BindVertexArray(unsigned int _vertexArray)
+{
+    if (vertexArray == _vertexArray)
+    {
+        ++stats.vertexArrays.elided;
+        return;
+    }
+    GLCall(glBindVertexArray(_vertexArray));
+    vertexArray = _vertexArray;
+    // The element buffer binding belongs to the vertex array
+    elementBuffer = UNKNOWN;
+    ++stats.vertexArrays.issued;
+}
+
+void GLState::BindBuffer(unsigned int target, unsigned int buffer)
+{
+    unsigned int* bound = target == GL_ARRAY_BUFFER ? &arrayBuffer
+        : target == GL_ELEMENT_ARRAY_BUFFER ? &elementBuffer : nullptr;
+    if (bound && *bound == buffer)
+    {
+        ++stats.buffers.elided;
+        return;
+    }
+    GLCall(glBindBuffer(target, buffer));
+    if (bound)
+    {
+        *bound = buffer;
+    }
+    ++stats.buffers.issued;
+}
+
+void GLState::SetBlend(bool enabled)
+{
+    if (blendEnabled == static_cast<int>(enabled))
+    {
+        ++stats.blend.elided;
+        return;
+    }
+    if (enabled)
+    {
+        GLCall(glEnable(GL_BLEND));
+    }
+    else
+    {
+        GLCall(glDisable(GL_BLEND));
+    }
+    blendEnabled = static_cast<int>(enabled);
+    ++stats.blend.issued;
+}
+
+void GLState::BlendFunc(unsigned int source, unsigned int destination)
+{
+    if (blendSource == source && blendDestination == destination)
+    {
+        ++stats.blend.elided;
+        return;
+    }
+    GLCall(glBlendFunc(source, destination));
+    blendSource = source;
+    blendDestination = destination;
+    ++stats.blend.issued;
+}
+
+bool GLState::UpdateUniform(int location, const void* data, int size)
+{
+    // Values can only be remembered per program, and large arrays are not worth comparing
+    if (program == UNKNOWN || size > static_cast<int>(sizeof(UniformValue::words)))
+    {
+        ++stats.uniforms.issued;
+        return true;
+    }
+
+    uint64_t key = (static_cast<uint64_t>(program) << 32) | static_cast<uint32_t>(location);
+    auto it = uniforms.find(key);
+    if (it != uniforms.end() && it->second.size == size && std::memcmp(it->second.words, data, size) == 0)
+    {
+        ++stats.uniforms.elided;
+        return false;
+    }
+
+    UniformValue& value = it != uniforms.end() ? it->second : uniforms[key];
+    std::memcpy(value.words, data, size);
+    value.size = size;
+    ++stats.uniforms.issued;
+    return true;
+}
+
+void GLState::Uniform1i(int location, int value)
+{
+    if (location != -1 && UpdateUniform(location, &value, sizeof(value)))
+    {
+        GLCall(glUniform1i(location, value));
+    }
+}
+
+void GLState::Uniform1iv(int location, int count, const int* values)
+{
+    if (location != -1 && UpdateUniform(location, values, count * static_cast<int>(sizeof(int))))
+    {
+        GLCall(glUniform1iv(location, count, values));
+    }
+}
+
+void GLState::Uniform1f(int location, float value)
+{
+    if (location != -1 && UpdateUniform(location, &value, sizeof(value)))
+    {
+        GLCall(glUniform1f(location, value));
+    }
+}
+
+void GLState::Uniform2f(int location, float v0, float v1)
+{
+    const float values[2] = { v0, v1 };
+    if (location != -1 && UpdateUniform(location, values, sizeof(values)))
+    {
+        GLCall(glUniform2f(location, v0, v1));
+    }
+}
+
+void GLState::Uniform3f(int location, float v0, float v1, float v2)
+{
+    const float values[3] = { v0, v1, v2 };
+    if (location != -1 && UpdateUniform(location, values, sizeof(values)))
+    {
+        GLCall(glUniform3f(location, v0, v1, v2));
+    }
+}
+
+void GLState::Uniform4f(int location, float v0, float v1, float v2, float v3)
+{
+    const float values[4] = { v0, v1, v2, v3 };
+    if (location != -1 && UpdateUniform(location, values, sizeof(values)))
+    {
+        GLCall(glUniform4f(location, v0, v1, v2, v3));
+    }
+}
+
+void GLState::UniformMatrix4f(int location, const glm::mat4& matrix)
+{
+    if (location != -1 && UpdateUniform(location, &matrix[0][0], sizeof(glm::mat4)))
+    {
+        GLCall(glUniformMatrix4fv(location, 1, GL_FALSE, &matrix[0][0]));
+    }
+}
+
+void GLState::ForgetTexture(unsigned int texture)
+{
+    // OpenGL unbinds a deleted texture from every unit
+    for (unsigned int& bound : textures)
+    {
+        if (bound == texture)
+        {
+            bound = 0;
+        }
+    }
+}
+
+void GLState::ForgetVertexArray(unsigned int _vertexArray)
+{
+    if (vertexArray == _vertexArray)
+    {
+        vertexArray = 0;
+        elementBuffer = UNKNOWN;
+    }
+}
+
+void GLState::ForgetBuffer(unsigned int buffer)
+{
+    if (arrayBuffer == buffer)
+    {
+        arrayBuffer = 0;
+    }
+    if (elementBuffer == buffer)
+    {
+        elementBuffer = 0;
+    }
+}
+
+void GLState::ForgetProgram(unsigned int _program)
+{
+    // The name may come back for a new program with its own values
+    for (auto it = uniforms.begin(); it != uniforms.end();)
+    {
+        if (static_cast<unsigned int>(it->first >> 32) == _program)
+        {
+            it = uniforms.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    if (program == _program)
+    {
+        program = UNKNOWN;
+    }
+}
@@ -0,0 +1,160 @@
+/******************************************************************************/
+/*!
+\file		GLState.h
+\author 	Wayne Kwok Jun Lin
+\par    	email: k.junlinwayne@digipen.edu
+\date   	April 17, 2024
+\brief		This file contains the declaration of the GLState class, which sits
+            between the renderer and OpenGL and remembers the state it last
+            set: the bound program, the texture of each unit, the vertex array,
+            the buffers, the blend state and the last value written to each
+            uniform. Calls that would not change anything are skipped.
+Copyright (C) 2024 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the prior
+written consent of DigiPen Institute of Technology is prohibited.
+ */
+ /******************************************************************************/
+#ifndef ENGINE_GLSTATE_H
+#define ENGINE_GLSTATE_H
+
+#include <cstdint>
+#include <unordered_map>
+#include "glm/glm.hpp"
+
+// Tracks the OpenGL state and elides redundant state changes.
+class GLState
+{
+public:
+    // Calls made through the cache, split by whether they reached OpenGL
+    struct Counter
+    {
+        int issued = 0;
+        int elided = 0;
+    };
+
+    // Counters of the current frame, reset by BeginFrame
+    struct Stats
+    {
+        Counter programs;
+        Counter textures;       // Texture binds and texture unit switches
+        Counter vertexArrays;
+        Counter buffers;
+        Counter blend;
+        Counter uniforms;
+    };
+
+    static constexpr int MAX_TEXTURE_UNITS = 32;
+
+    /*!
+     * \brief Gets the state of the current OpenGL context.
+     * \return A reference to the only instance.
+     */
+    static GLState& GetInstance();
+
+    GLState(const GLState&) = delete;
+    GLState& operator=(const GLState&) = delete;
+
+    /*!
+     * \brief Starts a frame. Forgets the tracked bindings, in case anything
+     * outside the cache changed them, and resets the counters.
+     * \param minimized Whether the window is minimized this frame.
+     */
+    void BeginFrame(bool minimized);
+
+    /*!
+     * \brief Forgets every tracked binding so that the next call of each kind
+     * reaches OpenGL. Uniform values are kept, as they live in the programs.
+     */
+    void Invalidate();
+
+    /*!
+     * \brief Checks whether the window was minimized when the frame started,
+     * without asking GLFW on every bind.
+     */
+    bool IsMinimized() const { return minimized; }
+
+    void UseProgram(unsigned int program);
+    void ActiveTexture(unsigned int unit);
+
+    /*!
+     * \brief Binds a 2D texture to a texture unit, switching units only if needed.
+     * \param unit The texture unit, from 0.
+     * \param texture The texture, or 0 to unbind.
+     */
+    void BindTexture(unsigned int unit, unsigned int texture);
+
+    /*!
+     * \brief Binds a 2D texture to the active texture unit.
+     * \param texture The texture, or 0 to unbind.
+     */
+    void BindTexture(unsigned int texture) { BindTexture(activeUnit == UNKNOWN ? 0 : activeUnit, texture); }
+
+    void BindVertexArray(unsigned int vertexArray);
+
+    /*!
+     * \brief Binds a buffer.
+     * \param target GL_ARRAY_BUFFER or GL_ELEMENT_ARRAY_BUFFER. Other targets are not tracked.
+     * \param buffer The buffer, or 0 to unbind.
+     */
+    void BindBuffer(unsigned int target, unsigned int buffer);
+
+    void SetBlend(bool enabled);
+    void BlendFunc(unsigned int source, unsigned int destination);
+
+    // Uniforms of the bound program. Locations of -1 are ignored, like OpenGL does.
+    void Uniform1i(int location, int value);
+    void Uniform1iv(int location, int count, const int* values);
+    void Uniform1f(int location, float value);
+    void Uniform2f(int location, float v0, float v1);
+    void Uniform3f(int location, float v0, float v1, float v2);
+    void Uniform4f(int location, float v0, float v1, float v2, float v3);
+    void UniformMatrix4f(int location, const glm::mat4& matrix);
+
+    // Must be called before the objects are deleted, as OpenGL reuses the names
+    void ForgetTexture(unsigned int texture);
+    void ForgetVertexArray(unsigned int vertexArray);
+    void ForgetBuffer(unsigned int buffer);
+    void ForgetProgram(unsigned int program);
+
+    unsigned int GetActiveTextureUnit() const { return activeUnit == UNKNOWN ? 0 : activeUnit; }
+
+    /*!
+     * \brief Gets the counters of the current frame.
+     * \return A reference to the statistics.
+     */
+    const Stats& GetStats() const { return stats; }
+
+private:
+    // Largest uniform tracked, a 4x4 matrix
+    static constexpr int MAX_UNIFORM_WORDS = 16;
+
+    struct UniformValue
+    {
+        uint32_t words[MAX_UNIFORM_WORDS];
+        int size;
+    };
+
+    GLState() { Invalidate(); }
+
+    // Records the value of a uniform of the bound program, returning false if it is unchanged
+    bool UpdateUniform(int location, const void* data, int size);
+
+    static constexpr unsigned int UNKNOWN = 0xFFFFFFFFu;
+
+    unsigned int program;
+    unsigned int activeUnit;
+    unsigned int textures[MAX_TEXTURE_UNITS];
+    unsigned int vertexArray;
+    unsigned int arrayBuffer;
+    unsigned int elementBuffer;
+    int blendEnabled;           // -1 while unknown
+    unsigned int blendSource;
+    unsigned int blendDestination;
+
+    // Keyed by program in the upper 32 bits and location in the lower
+    std::unordered_map<uint64_t, UniformValue> uniforms;
+
+    bool minimized = false;
+    Stats stats;
+};
+#endif ENGINE_GLSTATE_H
@@ -20,7 +20,7 @@ written consent of DigiPen Institute of Technology is prohibited.
 #include "CollisionSystem.h"
 #include "Vector2d.h"
 #include "Input.h"
-#include "Animation.h"
+#include "AnimationSystem.h"
 #include "ImGuiWrapper.h"
 #include "inGameGUI.h"
 #include "Application.h"
@@ -33,6 +33,87 @@ bool renderCollisionBox = true; // Debug mode
 #endif
 double framesPerSecond = 0.0;
 bool fpsTimer = true;
+
+namespace
+{
+    // Draw layer of an entity. Within a layer, entities keep the order they were created in, which
+    // full-screen panels, the images on them and the health bars over the towers rely on
+    RenderLayer RenderLayerOf(Engine::Entity* entity, int mainIndex)
+    {
+        if (mainIndex == Background)
+        {
+            return RenderLayer::Background;
+        }
+        if (mainIndex == HUD)
+        {
+            return RenderLayer::Interface;
+        }
+        if (mainIndex == archerArrow || (mainIndex >= infantryVFX && mainIndex <= towerVFX))
+        {
+            return RenderLayer::Effects;
+        }
+
+        Engine::CollisionComponent* collision = dynamic_cast<Engine::CollisionComponent*>(entity->GetComponent(ComponentType::Collision));
+        if (collision)
+        {
+            if (collision->layer == Layer::inGameGUI)
+            {
+                return RenderLayer::Interface;
+            }
+            if (collision->layer == Layer::Arrow)
+            {
+                return RenderLayer::Effects;
+            }
+        }
+        return RenderLayer::World;
+    }
+
+    using TextLine = Engine::GraphicsSystem::TextLine;
+
+    // Lines of the how to play page, in clip space
+    const TextLine HOW_TO_PLAY_LINES[] =
+    {
+        { "HOW TO PLAY", 0.5f, 0.30f, 0.0015f },
+        { "OBJECTIVE: Take down enemy ", 0.5f, 0.2f, 0.001f },
+        { "stronghold. ", 0.5f, 0.1f, 0.001f },
+        { "Drag and Drop Units onto ", 0.5f, 0.f, 0.001f },
+        { "the designated starting area. ", 0.5f, -0.1f, 0.001f },
+        { "Take down structures protecting ", 0.5f, -0.2f, 0.001f },
+        { "enemy stronghold. ", 0.5f, -0.3f, 0.001f },
+        { "Take down stronghold to win ", 0.5f, -0.4f, 0.001f }
+    };
+
+    // Lines of the credits page, in clip space
+    const TextLine CREDITS_LINES[] =
+    {
+        { "CREDITS", 0.f, 0.55f, 0.0015f },
+        { "DEVELOPERS ", -0.3f, 0.4f, 0.0005f },
+        { "PRODUCT MANAGER: VANCE TAY  ", -0.3f, 0.35f, 0.0005f },
+        { "TECH LEAD: LIU XUJIE ", -0.3f, 0.30f, 0.0005f },
+        { "DESIGN LEAD: ALOYSIUS ANG ", -0.3f, 0.25f, 0.0005f },
+        { "LEVEL EDITOR: TRISTAN THAM ", -0.3f, 0.2f, 0.0005f },
+        { "GRAPHICS PROGRAMMER: SHEEN YEOH  ", -0.3f, 0.15f, 0.0005f },
+        { "GRAPHICS PROGRAMMER: WAYNE KWOK ", -0.3f, 0.10f, 0.0005f },
+        { "ART LEAD: NG WEI YING ", -0.3f, 0.05f, 0.0005f },
+        { "PRESIDENT ", -0.3f, -0.05f, 0.0005f },
+        { "CLAUDE COMAIR ", -0.3f, -0.10f, 0.0005f },
+        { "EXECUTIVES: BEN ELLINGER, JASON CHU, SAMIR ABOU SAMRA,", 0.f, -0.15f, 0.0005f },
+        { "CHRISTOPHER COMAIR, PRASANNA GHALI, MICHAEL GATS,", 0.f, -0.20f, 0.0005f },
+        { "JOHN BAUER, MICHELLE COMAIR, DR.ERIK MOHARAMANN,  ", 0.f, -0.25f, 0.0005f },
+        { "RAYMOND YAN, MELVIN GONSALVEZ, ANGELA KUGLER, DR.CHARLES DUBA, JOHNNY DEEK", 0.f, -0.30f, 0.0005f },
+        { "ALL CONTENT(C) 2024 DIGIPEN INSTITUTE OF TECHNOLOGY SINGAPORE, ALL RIGHTS RESERVED.", 0.f, -0.5f, 0.0005f },
+        { "FACULTY AND ADVISORS", 0.3f, 0.4f, 0.0005f },
+        { "ALWYN LEE  ", 0.3f, 0.35f, 0.0005f },
+        { "KEH CHOON WEE ", 0.3f, 0.30f, 0.0005f },
+        { "GOH JING YING ", 0.3f, 0.25f, 0.0005f },
+        { "DANIELLE FONG ", 0.3f, 0.2f, 0.0005f },
+        { "ELIE HOSRY  ", 0.3f, 0.15f, 0.0005f },
+        { "DIAN YANG GOH ", 0.3f, 0.10f, 0.0005f },
+        { "MALCOM GRANT ", 0.3f, 0.05f, 0.0005f },
+        { "VUK KRAKOVIC ", 0.3f, 0.f, 0.0005f },
+        { "HOLGER LIEBNITZ ", 0.3f, -0.05f, 0.0005f }
+    };
+}
 #pragma warning(disable: 4100) // disable "unreferenced parameter" 
 namespace Engine
 {
@@ -80,7 +161,11 @@ namespace Engine
             glfwTerminate();
         }
         else
+        {
             Logger::GetInstance().Log(LogLevel::Debug, "GLEW successfully initialized");
+            // Let the driver report errors instead of asking after every call
+            SetGLErrorPolicy(GLErrorPolicy::DebugCallback);
+        }
     }
 
     void GraphicsSystem::Initialize() 
@@ -119,8 +204,8 @@ namespace Engine
             }
 
             //enable blending for transparency
-            GLCall(glEnable(GL_BLEND));
-            GLCall(glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA));
+            GLState::GetInstance().SetBlend(true);
+            GLState::GetInstance().BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
             const float fscreenWidth = 1280.0f;
             const float fscreenHeight = 720.0f;
@@ -218,6 +303,8 @@ namespace Engine
 
             font.Initialize();
             editorFBO.Initialize(screenWidth, screenHeight);
+            frameUniformBuffer = std::make_unique<UniformBuffer>(static_cast<unsigned int>(sizeof(FrameUniforms)), FRAME_UNIFORM_BINDING);
+            spriteBatch.Initialize();
 
             //  font.Initialize("Resource/Fonts/arial.ttf");
             /*  font.Initialize("Resource/Fonts/Inkfree.ttf");
@@ -294,8 +381,12 @@ namespace Engine
             throw std::runtime_error("Failed to load shader source files.");
         }
 
+        // Resolve the uniforms once, drawing only goes through the handles
+        colorUniform = shader.GetUniform<glm::vec4>("u_Color");
+        renderTexturedUniform = shader.GetUniform<int>("u_RenderTextured");
+
         // Set uniform values (adjust as needed)
-        shader.SetUniform4f("u_Color", 1.0f, 1.0f, 1.0f, 1.0f);
+        shader.SetUniform(colorUniform, glm::vec4(1.0f, 1.0f, 1.0f, 1.0f));
 
         // Unbind the shader program after setting up uniforms
         shader.Unbind();
@@ -334,51 +425,57 @@ namespace Engine
                 }
             }
         }
-    }
 
-    void GraphicsSystem::RenderBackground(const glm::mat4& mvpMatrix)
-    {
-        if (!glfwGetWindowAttrib(glfwGetCurrentContext(), GLFW_ICONIFIED)) {
+        // Pack the loaded images into atlas pages, sprite sheets frame by frame
+        for (int i = 0; i < TextureClassCount; i++) {
+            for (int j = 0; j <= MAX_SUBINDEX; j++) {
+                Texture& texture = textures[i][j];
+                if (texture.GetLocalBuffer() && texture.GetTextureID() != 0) {
+                    textureAtlas.Add({ i, j }, texture.GetLocalBuffer(), texture.GetWidth(), texture.GetHeight(), AnimationLibrary::GetInstance().FrameCount(j));
+                }
+            }
+        }
+        textureAtlas.Build();
 
-            try {
-                shader.Bind();
-                textures[Background][0].Bind(0);
-                shader.SetUniform1f("texCoordX", 0.0f);
-                //shader.SetUniform1f("u_FrameCount", 1.0f);
-                shader.SetUniform1f("u_FrameWidth", 1.0f);
-                shader.SetUniform1f("u_FrameHeight", 1.0f);
-
-                glm::mat4 viewProjectionMatrix;
-                if (useEditorCamera) {
-                    viewProjectionMatrix = m_EditorCamera.GetViewProjectionMatrix();
+        // Frame layout of every sheet, from its atlas regions or across its own texture
+        SpriteSheetTable& sheets = spriteBatch.GetSheets();
+        sheets.Clear();
+        for (int i = 0; i < TextureClassCount; i++) {
+            for (int j = 0; j <= MAX_SUBINDEX; j++) {
+                int frameCount = AnimationLibrary::GetInstance().FrameCount(j);
+                if (frameCount < 2 || textures[i][j].GetTextureID() == 0) {
+                    continue;
+                }
+                if (textureAtlas.Find({ i, j }, 0)) {
+                    std::vector<glm::vec4> frameRects;
+                    for (int frame = 0; frame < frameCount; ++frame) {
+                        frameRects.push_back(textureAtlas.Find({ i, j }, frame)->uvRect);
+                    }
+                    sheets.Set({ i, j }, frameRects.data(), frameCount);
                 }
                 else {
-                    viewProjectionMatrix = m_Camera.GetViewProjectionMatrix();
+                    sheets.SetGrid({ i, j }, frameCount, 1);
                 }
-                shader.SetUniformMat4f("u_MVP", viewProjectionMatrix);
-
-                vaBackground.Bind(); // Bind the background vertex array
-                ibBackground.Bind(); // Bind the background index buffer
-
-                renderer.Draw(vaBackground, ibBackground, shader);
-                textures[Background][0].Unbind();
-                shader.Unbind();
-            }
-            catch (const std::exception& e) {
-                Logger::GetInstance().Log(LogLevel::Error, "Render background error: " + std::string(e.what()));
             }
         }
-        else
-        {
-           // Logger::GetInstance().Log(LogLevel::Info, "Window is minimized, skipping rendering.");
-        }
+        const TextureAtlas::Stats& atlasStats = textureAtlas.GetStats();
+        Logger::GetInstance().Log(LogLevel::Debug, "Texture atlas: " + std::to_string(atlasStats.images) + " textures in "
+            + std::to_string(atlasStats.pages) + " pages, " + std::to_string(atlasStats.standalone) + " standalone");
     }
 
-    void GraphicsSystem::RenderTexturedEntity(const glm::mat4& mvpMatrix, Entity* entity)
+    void GraphicsSystem::RenderBackground()
     {
-        if (!glfwGetWindowAttrib(glfwGetCurrentContext(), GLFW_ICONIFIED)) {
+        // The background covers the screen, so it is the entity quad scaled to the screen size
+        RenderCommand command;
+        command.transform = Transform2D::FromSinCos(0.0f, 0.0f, 0.0f, 1.0f, static_cast<float>(screenWidth) / 100.0f, static_cast<float>(screenHeight) / 100.0f);
+        command.textureID = textures[Background][0].GetTextureID();
+        renderQueue.Submit(RenderQueue::MakeKey(RenderLayer::Background, 0, 0, command.textureID, 0), command);
+    }
+
+    void GraphicsSystem::RenderTexturedEntity(const Transform2D& transform, Entity* entity)
+    {
+        if (!GLState::GetInstance().IsMinimized()) {
 
-            shader.Bind();
             if (!entity->HasComponent(ComponentType::Texture))
             {
                 Logger::GetInstance().Log(LogLevel::Error, "Entity does not have a TextureComponent!");
@@ -387,223 +484,65 @@ namespace Engine
 
             TextureComponent* texture = dynamic_cast<TextureComponent*>(entity->GetComponent(ComponentType::Texture));
 
+            unsigned int textureID = 0;
+            glm::vec4 uvRect(0.0f, 0.0f, 1.0f, 1.0f);
+            TextureKey atlasKey{ 0, 0 };
+            int frame = 0;
+            int sheet = -1;
             if (texture != nullptr)
             {
-                // Attempt to bind the texture based on the subindex
+                // Pick the texture based on the subindex
                 auto& textureVector = textures[texture->textureKey.mainIndex];
 
                 if (texture->textureKey.subIndex < textureVector.size())
                 {
-                    // Texture with the specified subindex exists, bind it
-                    textureVector[texture->textureKey.subIndex].Bind(0);
+                    // Texture with the specified subindex exists, use it
+                    textureID = textureVector[texture->textureKey.subIndex].GetTextureID();
+                    atlasKey = texture->textureKey;
                 }
                 else if (!textureVector.empty())
                 {
                     // Texture with the specified subindex does not exist, default to subindex 0
-                    textureVector[0].Bind(0);
+                    textureID = textureVector[0].GetTextureID();
+                    atlasKey = { texture->textureKey.mainIndex, 0 };
                 }
 
-                //If Sprite present
-                if ((texture->textureKey.subIndex == 1) && entity->HasComponent(ComponentType::Sprite))
+                // The animation system steps the clip, the shader looks the frame it reached up in the sheet table
+                SpriteComponent* sprite = entity->HasComponent(ComponentType::Sprite)
+                    ? dynamic_cast<SpriteComponent*>(entity->GetComponent(ComponentType::Sprite)) : nullptr;
+                const AnimationClip* clip = sprite ? AnimationLibrary::GetInstance().Find(texture->textureKey.subIndex) : nullptr;
+                if (clip)
                 {
-                    // Calculate deltaTime (time since the last frame)
-                    static double lastTime = glfwGetTime();
-                    double currentTime = glfwGetTime();
-                    double deltaTime = currentTime - lastTime;
-                    lastTime = currentTime;
-                    float frameRate = 10.0f;
-                    float horizontalFrames = 6.0f; // Number of horizontal frames
-                    float verticalFrames = 1.0f; // Number of vertical frames
-                    //float Length = 1536.0f; // length of sprite sheet
-                    Anim_Mode playMode = Anim_Mode::LOOP;
-
-                    // Create a static animation object if not created already
-                    static Animation animation(frameRate, horizontalFrames, verticalFrames, playMode);
-                    // Play the animation
-                    animation.Play();
-                    // Update the animation with deltaTime
-                    animation.Update(static_cast<float>(deltaTime));
-                    // Get the current frame index
-                    int currentFrame = animation.GetCurrentFrame();
-
-                    // Calculate the texture offset based on the current frame
-                    float frameWidth = 1.0f / horizontalFrames;
-                    float frameHeight = 1.0f / verticalFrames;
-                    float texCoordX = currentFrame * frameWidth;
-                    //float texCoordY = currentRow * frameHeight;
-
-                    // Set the texture offset in the shader
-                    shader.SetUniform1f("texCoordX", texCoordX);
-                    //shader.SetUniform1f("u_FrameCount", horizontalFrames);
-                    shader.SetUniform1f("u_FrameWidth", frameWidth);
-                    shader.SetUniform1f("u_FrameHeight", frameHeight);
-                }
-                else if ((texture->textureKey.subIndex == 2) && entity->HasComponent(ComponentType::Sprite))
-                {
-                    // Calculate deltaTime (time since the last frame)
-                    static double lastTime = glfwGetTime();
-                    double currentTime = glfwGetTime();
-                    double deltaTime = currentTime - lastTime;
-                    lastTime = currentTime;
-                    float frameRate = 10.0f;
-                    float horizontalFrames = 10.0f; // Number of horizontal frames
-                    float verticalFrames = 1.0f; // Number of vertical frames
-                    //float Length = 1536.0f; // length of sprite sheet
-                    Anim_Mode playMode = Anim_Mode::LOOP;
-
-                    // Create a static animation object if not created already
-                    static Animation animation(frameRate, horizontalFrames, verticalFrames, playMode);
-                    // Play the animation
-                    animation.Play();
-                    // Update the animation with deltaTime
-                    animation.Update(static_cast<float>(deltaTime));
-                    // Get the current frame index
-                    int currentFrame = animation.GetCurrentFrame();
-
-                    // Calculate the texture offset based on the current frame
-                    float frameWidth = 1.0f / horizontalFrames;
-                    float frameHeight = 1.0f / verticalFrames;
-                    float texCoordX = currentFrame * frameWidth;
-                    //float texCoordY = currentRow * frameHeight;
-
-                    // Set the texture offset in the shader
-                    shader.SetUniform1f("texCoordX", texCoordX);
-                    //shader.SetUniform1f("u_FrameCount", horizontalFrames);
-                    shader.SetUniform1f("u_FrameWidth", frameWidth);
-                    shader.SetUniform1f("u_FrameHeight", frameHeight);
-                }
-                else if ((texture->textureKey.subIndex == 3) && entity->HasComponent(ComponentType::Sprite))
-                {
-                    // Calculate deltaTime (time since the last frame)
-                    static double lastTime = glfwGetTime();
-                    double currentTime = glfwGetTime();
-                    double deltaTime = currentTime - lastTime;
-                    lastTime = currentTime;
-                    float frameRate = 10.0f;
-                    float horizontalFrames = 5.0f; // Number of horizontal frames
-                    float verticalFrames = 1.0f; // Number of vertical frames
-                    //float Length = 1536.0f; // length of sprite sheet
-                    Anim_Mode playMode = Anim_Mode::ONE_TIME;
-
-                    // Create a static animation object if not created already
-                    static Animation animation(frameRate, horizontalFrames, verticalFrames, playMode);
-                    // Play the animation
-                    animation.Play();
-                    // Update the animation with deltaTime
-                    animation.Update(static_cast<float>(deltaTime));
-                    // Get the current frame index
-                    int currentFrame = animation.GetCurrentFrame();
-
-                    // Calculate the texture offset based on the current frame
-                    float frameWidth = 1.0f / horizontalFrames;
-                    float frameHeight = 1.0f / verticalFrames;
-                    float texCoordX = currentFrame * frameWidth;
-
-                    // Set the texture offset in the shader
-                    shader.SetUniform1f("texCoordX", texCoordX);
-                    shader.SetUniform1f("u_FrameWidth", frameWidth);
-                    shader.SetUniform1f("u_FrameHeight", frameHeight);
-                }
-
-                else if ((texture->textureKey.subIndex == 4) && entity->HasComponent(ComponentType::Sprite))
-                {
-                    // Calculate deltaTime (time since the last frame)
-                    static double lastTime = glfwGetTime();
-                    double currentTime = glfwGetTime();
-                    double deltaTime = currentTime - lastTime;
-                    lastTime = currentTime;
-                    float frameRate = 5.0F;
-                    float horizontalFrames = 5.0f; // Number of horizontal frames
-                    float verticalFrames = 1.0f; // Number of vertical frames
-                    //float Length = 1536.0f; // length of sprite sheet
-                    Anim_Mode playMode = Anim_Mode::ONE_TIME;
-
-                    // Create a static animation object if not created already
-                    static Animation animation(frameRate, horizontalFrames, verticalFrames, playMode);
-                    // Play the animation
-                    animation.Play();
-                    // Update the animation with deltaTime
-                    animation.Update(static_cast<float>(deltaTime));
-                    // Get the current frame index
-                    int currentFrame = animation.GetCurrentFrame();
-
-                    // Calculate the texture offset based on the current frame
-                    float frameWidth = 1.0f / horizontalFrames;
-                    float frameHeight = 1.0f / verticalFrames;
-                    float texCoordX = currentFrame * frameWidth;
-                    //float texCoordY = currentRow * frameHeight;
-
-                    // Set the texture offset in the shader
-                    shader.SetUniform1f("texCoordX", texCoordX);
-                    //shader.SetUniform1f("u_FrameCount", horizontalFrames);
-                    shader.SetUniform1f("u_FrameWidth", frameWidth);
-                    shader.SetUniform1f("u_FrameHeight", frameHeight);
-                }
-
-                else if ((texture->textureKey.subIndex == 5) && entity->HasComponent(ComponentType::Sprite))
-                {
-                    // Calculate deltaTime (time since the last frame)
-                    static double lastTime = glfwGetTime();
-                    double currentTime = glfwGetTime();
-                    double deltaTime = currentTime - lastTime;
-                    lastTime = currentTime;
-                    float frameRate = 5.0F;
-                    float horizontalFrames = 6.0f; // Number of horizontal frames
-                    float verticalFrames = 1.0f; // Number of vertical frames
-                    //float Length = 1536.0f; // length of sprite sheet
-                    Anim_Mode playMode = Anim_Mode::ONE_TIME;
-
-                    // Create a static animation object if not created already
-                    static Animation animation(frameRate, horizontalFrames, verticalFrames, playMode);
-                    // Play the animation
-                    animation.Play();
-                    // Update the animation with deltaTime
-                    animation.Update(static_cast<float>(deltaTime));
-                    // Get the current frame index
-                    int currentFrame = animation.GetCurrentFrame();
-
-                    // Calculate the texture offset based on the current frame
-                    float frameWidth = 1.0f / horizontalFrames;
-                    float frameHeight = 1.0f / verticalFrames;
-                    float texCoordX = currentFrame * frameWidth;
-                    //float texCoordY = currentRow * frameHeight;
-
-                    // Set the texture offset in the shader
-                    shader.SetUniform1f("texCoordX", texCoordX);
-                    //shader.SetUniform1f("u_FrameCount", horizontalFrames);
-                    shader.SetUniform1f("u_FrameWidth", frameWidth);
-                    shader.SetUniform1f("u_FrameHeight", frameHeight);
+                    // Not stepped since the texture changed, such as while paused in the editor, shows the first frame
+                    frame = sprite->clip == texture->textureKey.subIndex ? sprite->currentframe : 0;
+                    sheet = spriteBatch.GetSheets().Find(atlasKey);
+                    float frameWidth = 1.0f / static_cast<float>(clip->frames);
+                    uvRect = glm::vec4(frame * frameWidth, 0.0f, (frame + 1) * frameWidth, 1.0f);
                 }
                 else //render as static
                 {
-                    textures[texture->textureKey.mainIndex][0].Bind(0); //render static version of texture at subindex = 0
-                    shader.SetUniform1f("texCoordX", 0.0f);
-                    //shader.SetUniform1f("u_FrameCount", 1.0f);
-                    shader.SetUniform1f("u_FrameWidth", 1.0f);
-                    shader.SetUniform1f("u_FrameHeight", 1.0f);
+                    textureID = textures[texture->textureKey.mainIndex][0].GetTextureID(); //render static version of texture at subindex = 0
+                    atlasKey = { texture->textureKey.mainIndex, 0 };
+                    frame = 0;
+                    uvRect = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f);
                 }
             }
-            shader.Bind();
-
-            glm::mat4 result;
-            if (useEditorCamera) {
-                result = m_EditorCamera.GetViewProjectionMatrix() * mvpMatrix;
-            }
-            else {
-                result = m_Camera.GetViewProjectionMatrix() * mvpMatrix;
+            // Draw from the atlas page when the texture was packed, so neighbouring sprites share a batch
+            if (const AtlasRegion* region = textureAtlas.Find(atlasKey, frame))
+            {
+                textureID = region->textureID;
+                uvRect = region->uvRect;
             }
 
-            shader.SetUniformMat4f("u_MVP", result);
-
-            va.Bind();
-            ib.Bind();
-            shader.SetUniform1i("u_RenderTextured", 1);
-            // Render the entity
-            //renderer.Draw(va, ib, shader);
-            GLCall(glDrawElements(GL_TRIANGLES, ib.GetCount(), GL_UNSIGNED_INT, nullptr));
-
-            // Unbind the texture and shader
-            shader.Unbind();
+            // Queued and drawn in key order once every entity is submitted
+            RenderCommand command;
+            command.transform = transform;
+            command.uvRect = uvRect;
+            command.textureID = textureID;
+            command.sheet = sheet;
+            command.frame = frame;
+            RenderLayer layer = texture ? RenderLayerOf(entity, texture->textureKey.mainIndex) : RenderLayer::World;
+            renderQueue.Submit(RenderQueue::MakeKey(layer, entity->GetID(), 0, textureID, 0), command);
         }
         else
         {
@@ -613,7 +552,7 @@ namespace Engine
 
     void GraphicsSystem::RenderLines(const glm::mat4& mvpMatrix)
     {
-        if (!glfwGetWindowAttrib(glfwGetCurrentContext(), GLFW_ICONIFIED)) {
+        if (!GLState::GetInstance().IsMinimized()) {
             // Bind the shader and set uniforms for line rendering
             shader.Bind();
             vaLines.Bind();
@@ -625,17 +564,17 @@ namespace Engine
                 Logger::GetInstance().Log(LogLevel::Error, "OpenGL Error before rendering lines: " + std::to_string(error));
             }
 
-            shader.SetUniform1i("u_RenderTextured", 0); // no texture
+            shader.SetUniform(renderTexturedUniform, 0); // no texture
             if (renderCollisionBox == true) {
-                shader.SetUniform4f("u_Color", 0.0f, 0.0f, 0.0f, 1.0f); // Set the line color
+                shader.SetUniform(colorUniform, glm::vec4(0.0f, 0.0f, 0.0f, 1.0f)); // Set the line color
             }
             else
-                shader.SetUniform4f("u_Color", 0.0f, 0.0f, 0.0f, 0.0f); // Set the line color
+                shader.SetUniform(colorUniform, glm::vec4(0.0f, 0.0f, 0.0f, 0.0f)); // Set the line color
 
             // Draw the lines directly without an IBO
             GLCall(glDrawArrays(GL_LINE_LOOP, 0, 4));
 
-            shader.SetUniform1i("u_RenderTextured", 1);
+            shader.SetUniform(renderTexturedUniform, 1);
             vaLines.Unbind();
             shader.Unbind();
         }
@@ -648,6 +587,10 @@ namespace Engine
     void GraphicsSystem::Update(std::unordered_map<EntityID, std::unique_ptr<Entity>>* entities)
     {
         //UpdateViewport(width, height);
+        // Anything outside the cache may have changed the bindings since the last frame
+        GLState::GetInstance().BeginFrame(glfwGetWindowAttrib(glfwGetCurrentContext(), GLFW_ICONIFIED) != 0);
+        // Read once here rather than by every entity drawn
+        glfwGetWindowSize(Window, &screenWidth, &screenHeight);
         renderer.Clear(); 
         if(renderImGuiGUI == true)
         editorFBO.Bind();
@@ -655,6 +598,14 @@ namespace Engine
         shader.Bind();
         
         int previousShaderSet = shader.GetCurrentShaderSet();
+        // The camera is uploaded once here and read by every program with the Frame block
+        FrameUniforms frameUniforms;
+        frameUniforms.viewProjection = useEditorCamera ? m_EditorCamera.GetViewProjectionMatrix() : m_Camera.GetViewProjectionMatrix();
+        frameUniformBuffer->SetData(&frameUniforms, sizeof(frameUniforms));
+        spriteBatch.Begin();
+        drawables.clear();
+        transformCache.BeginFrame();
+        cullingGrid.BeginSync();
         for (const auto& entityPair : *entities)
         {
             Entity* entity = entityPair.second.get();
@@ -673,17 +624,10 @@ namespace Engine
                         continue; // Continue processing other entities
                     }
 
-                    glm::vec3 transA(transform->position.x, transform->position.y, 0);
-                    float rotationA = transform->rot;
-                    glm::vec3 localScale(transform->scaleX, transform->scaleY, 1.0f);
-
-                    // Update the line start and end positions based on user input
-                    glm::vec2 lineStart(transA.x, transA.y);
-                    glm::vec2 lineEnd = lineStart + glm::vec2(70.0f, 0.0f); // Adjust as needed
-
-                    // Apply transformations from UpdateTransformations
-                    glm::mat4 modelA = SetupModelMatrix(transA, rotationA, localScale);
-                    
+                    // Draw between the last two fixed steps so motion stays smooth above the simulation rate
+                    VECTORMATH::Vector2D renderPosition;
+                    float rotationA = 0.0f;
+                    transform->GetRenderTransform(interpolationAlpha, renderPosition, rotationA);
                     // glm::mat4 mvpA = proj* m_Camera.GetViewProjectionMatrix()  * modelA;
 
                     if (entity->HasComponent(ComponentType::Texture))
@@ -692,19 +636,12 @@ namespace Engine
 
                         if (!renderTexturedSquare)
                         {
-                            if(texture->textureKey.mainIndex == Background)
-                                RenderBackground(modelA);
-                            else {
-                                RenderTexturedEntity(modelA, entity); // Here, we pass the specific entity
-                                //RenderLines(modelA);
-                                
-                            }
+                            // Only entities that moved get their transform rebuilt, in one pass after the loop
+                            int slot = transformCache.Submit(entity->GetID(), renderPosition.x, renderPosition.y, rotationA, transform->scaleX, transform->scaleY);
+                            drawables.push_back({ entity, texture, slot });
                         }
                        
                     }
-
-                    transform->position.x = transA.x;
-                    transform->position.y = transA.y;
                 }
                 catch (const std::exception& ex)
                 {
@@ -713,6 +650,40 @@ namespace Engine
             }
         }
 
+        transformCache.Compute();
+        for (const Drawable& drawable : drawables)
+        {
+            // The background fills the screen, so it skips culling
+            if (drawable.texture->textureKey.mainIndex != Background)
+            {
+                cullingGrid.Update(drawable.entity->GetID(), transformCache.Get(drawable.transformSlot), transformCache.IsDirty(drawable.transformSlot));
+            }
+        }
+
+        // Only queue what overlaps the view of the active camera
+        glm::vec2 viewMin, viewMax;
+        if (useEditorCamera)
+            m_EditorCamera.GetViewBounds(viewMin, viewMax);
+        else
+            m_Camera.GetViewBounds(viewMin, viewMax);
+        cullingGrid.Cull({ viewMin.x, viewMin.y, viewMax.x, viewMax.y });
+
+        for (const Drawable& drawable : drawables)
+        {
+            if (drawable.texture->textureKey.mainIndex == Background)
+            {
+                RenderBackground();
+            }
+            else if (cullingGrid.IsVisible(drawable.entity->GetID()))
+            {
+                RenderTexturedEntity(transformCache.Get(drawable.transformSlot), drawable.entity); // Here, we pass the specific entity
+            }
+        }
+        // Sprites are drawn before the text so the text stays on top
+        renderQueue.Swap();
+        renderQueue.Execute(spriteBatch);
+        spriteBatch.End();
+
         // CAMERA
         if (useEditorCamera) {
             m_EditorCamera.UpdatePosition(InputController, CameraSpeed);
@@ -721,6 +692,7 @@ namespace Engine
             m_Camera.UpdatePosition(InputController, CameraSpeed);
         }
 
+        font.BeginFrame();
         font.SwitchFont(2);
 
         //// Render text if cat placement is wrong
@@ -731,135 +703,90 @@ namespace Engine
         // Render text if game is paused
         if (isGamePaused)
         {
-            font.RenderText(shader, "Game is paused.", 0.f, 0.9f, 0.002f, glm::vec3(0.f, 0.f, 0.f));
+            pausedText.Set("Game is paused.", 0.f, 0.9f, 0.002f, glm::vec3(0.f, 0.f, 0.f));
+            font.RenderText(shader, pausedText);
         }
 
         // Render text if in settings
         if (inSettings)
         {
-            font.RenderText(shader, "Game is in settings.", 0.f, 0.9f, 0.002f, glm::vec3(0.f, 0.f, 0.f));
+            settingsText.Set("Game is in settings.", 0.f, 0.9f, 0.002f, glm::vec3(0.f, 0.f, 0.f));
+            font.RenderText(shader, settingsText);
         }
 
         if(mainMenuCheck == false && howToPlayCheck == false && creditsCheck == false)
         {
-            // Infantry count
-            if (totalInfantry == 3) 
-            {
-                font.RenderText(shader, "x3", -0.15f, -0.95f, 0.0015f, glm::vec3(100.f, 100.f, 100.f));
-            }
-
-            if (totalInfantry == 2)
-            {
-                font.RenderText(shader, "x2", -0.15f, -0.95f, 0.0015f, glm::vec3(100.f, 100.f, 100.f));
-            }
-
-            if (totalInfantry == 1)
-            {
-                font.RenderText(shader, "x1", -0.15f, -0.95f, 0.0015f, glm::vec3(100.f, 100.f, 100.f));
-            }
-
-            if (totalInfantry == 0)
-            {
-                font.RenderText(shader, "x0", -0.15f, -0.95f, 0.0015f, glm::vec3(100.f, 100.f, 100.f));
-            }
-
-            // Archer count
-            if (totalArcher == 2) 
-            {
-                font.RenderText(shader, "x2", 0.07f, -0.95f, 0.0015f, glm::vec3(100.f, 100.f, 100.f));
-            }
-
-            if (totalArcher == 1)
-            {
-                font.RenderText(shader, "x1", 0.07f, -0.95f, 0.0015f, glm::vec3(100.f, 100.f, 100.f));
-            }
-
-            if (totalArcher == 0)
-            {
-                font.RenderText(shader, "x0", 0.07f, -0.95f, 0.0015f, glm::vec3(100.f, 100.f, 100.f));
-            }
-
-            // Tank count
-            if (totalTank == 1) 
-            {
-                font.RenderText(shader, "x1", 0.275f, -0.95f, 0.0015f, glm::vec3(100.f, 100.f, 100.f));
-            }
-
-            if (totalTank == 0)
-            {
-                font.RenderText(shader, "x0", 0.275f, -0.95f, 0.0015f, glm::vec3(100.f, 100.f, 100.f));
-            }     
+            // Units left to place, laid out again only when a count changes
+            RenderUnitCount(infantryCountText, totalInfantry, 3, -0.15f);
+            RenderUnitCount(archerCountText, totalArcher, 2, 0.07f);
+            RenderUnitCount(tankCountText, totalTank, 1, 0.275f);
         }
  
-        std::stringstream ss;
-        ss << std::fixed << std::setprecision(2) << fps;
-        std::string fps_str = ss.str();
         if (fpsTimer == true) {
 #ifdef NDEBUG // Check if we are in release mode
 #else
-            font.RenderText(shader, fps_str, -0.75f, 0.9f, 0.0015f, glm::vec3(100.f, 100.f, 100.f));
+            SmallString fpsString;
+            fpsString.Append(fps, 2);
+            fpsText.Set(fpsString.View(), -0.75f, 0.9f, 0.0015f, glm::vec3(100.f, 100.f, 100.f));
+            font.RenderText(shader, fpsText);
 #endif
         }
 
         if (howToPlayCheck == true) {
-            font.RenderText(shader, "HOW TO PLAY", 0.5f, 0.30f, 0.0015f, glm::vec3(0,0,0));
-            font.RenderText(shader, "OBJECTIVE: Take down enemy ", 0.5f, 0.2f, 0.001f, glm::vec3(0, 0, 0));
-            font.RenderText(shader, "stronghold. ", 0.5f, 0.1f, 0.001f, glm::vec3(0, 0, 0));
-            font.RenderText(shader, "Drag and Drop Units onto ", 0.5f, 0.f, 0.001f, glm::vec3(0, 0, 0));
-            font.RenderText(shader, "the designated starting area. ", 0.5f, -0.1f, 0.001f, glm::vec3(0, 0, 0));
-            font.RenderText(shader, "Take down structures protecting ", 0.5f, -0.2f, 0.001f, glm::vec3(0, 0, 0));
-            font.RenderText(shader, "enemy stronghold. ", 0.5f, -0.3f, 0.001f, glm::vec3(0, 0, 0));
-            font.RenderText(shader, "Take down stronghold to win ", 0.5f, -0.4f, 0.001f, glm::vec3(0, 0, 0));
+            RenderTextLines(howToPlayTexts, HOW_TO_PLAY_LINES, std::size(HOW_TO_PLAY_LINES));
         }
 
         if (creditsCheck == true) {
-            font.RenderText(shader, "CREDITS", 0.f, 0.55f, 0.0015f, glm::vec3(0, 0, 0));
-            font.RenderText(shader, "DEVELOPERS ", -0.3f, 0.4f, 0.0005f, glm::vec3(0, 0, 0));
-            font.RenderText(shader, "PRODUCT MANAGER: VANCE TAY  ", -0.3f, 0.35f, 0.0005f, glm::vec3(0, 0, 0));
-            font.RenderText(shader, "TECH LEAD: LIU XUJIE ", -0.3f, 0.30f, 0.0005f, glm::vec3(0, 0, 0));
-            font.RenderText(shader, "DESIGN LEAD: ALOYSIUS ANG ", -0.3f, 0.25f, 0.0005f, glm::vec3(0, 0, 0));
-            font.RenderText(shader, "LEVEL EDITOR: TRISTAN THAM ", -0.3f, 0.2f, 0.0005f, glm::vec3(0, 0, 0));
-            font.RenderText(shader, "GRAPHICS PROGRAMMER: SHEEN YEOH  ", -0.3f, 0.15f, 0.0005f, glm::vec3(0, 0, 0));
-            font.RenderText(shader, "GRAPHICS PROGRAMMER: WAYNE KWOK ", -0.3f, 0.10f, 0.0005f, glm::vec3(0, 0, 0));
-            font.RenderText(shader, "ART LEAD: NG WEI YING ", -0.3f, 0.05f, 0.0005f, glm::vec3(0, 0, 0));
-
-            font.RenderText(shader, "PRESIDENT ", -0.3f, -0.05f, 0.0005f, glm::vec3(0, 0, 0));
-            font.RenderText(shader, "CLAUDE COMAIR ", -0.3f, -0.10f, 0.0005f, glm::vec3(0, 0, 0));
-
-            font.RenderText(shader, "EXECUTIVES: BEN ELLINGER, JASON CHU, SAMIR ABOU SAMRA,", 0.f, -0.15f, 0.0005f, glm::vec3(0, 0, 0));
-            font.RenderText(shader, "CHRISTOPHER COMAIR, PRASANNA GHALI, MICHAEL GATS,", 0.f, -0.20f, 0.0005f, glm::vec3(0, 0, 0));
-            font.RenderText(shader, "JOHN BAUER, MICHELLE COMAIR, DR.ERIK MOHARAMANN,  ", 0.f, -0.25f, 0.0005f, glm::vec3(0, 0, 0));
-            font.RenderText(shader, "RAYMOND YAN, MELVIN GONSALVEZ, ANGELA KUGLER, DR.CHARLES DUBA, JOHNNY DEEK", 0.f, -0.30f, 0.0005f, glm::vec3(0, 0, 0));
-
-            font.RenderText(shader, "ALL CONTENT(C) 2024 DIGIPEN INSTITUTE OF TECHNOLOGY SINGAPORE, ALL RIGHTS RESERVED.", 0.f, -0.5f, 0.0005f, glm::vec3(0, 0, 0));
-            
-            font.RenderText(shader, "FACULTY AND ADVISORS", 0.3f, 0.4f, 0.0005f, glm::vec3(0, 0, 0));
-            font.RenderText(shader, "ALWYN LEE  ", 0.3f, 0.35f, 0.0005f, glm::vec3(0, 0, 0));
-            font.RenderText(shader, "KEH CHOON WEE ", 0.3f, 0.30f, 0.0005f, glm::vec3(0, 0, 0));
-            font.RenderText(shader, "GOH JING YING ", 0.3f, 0.25f, 0.0005f, glm::vec3(0, 0, 0));
-            font.RenderText(shader, "DANIELLE FONG ", 0.3f, 0.2f, 0.0005f, glm::vec3(0, 0, 0));
-            font.RenderText(shader, "ELIE HOSRY  ", 0.3f, 0.15f, 0.0005f, glm::vec3(0, 0, 0));
-            font.RenderText(shader, "DIAN YANG GOH ", 0.3f, 0.10f, 0.0005f, glm::vec3(0, 0, 0));
-            font.RenderText(shader, "MALCOM GRANT ", 0.3f, 0.05f, 0.0005f, glm::vec3(0, 0, 0));
-            font.RenderText(shader, "VUK KRAKOVIC ", 0.3f, 0.f, 0.0005f, glm::vec3(0, 0, 0));
-            font.RenderText(shader, "HOLGER LIEBNITZ ", 0.3f, -0.05f, 0.0005f, glm::vec3(0, 0, 0));
+            RenderTextLines(creditsTexts, CREDITS_LINES, std::size(CREDITS_LINES));
         }
+        // Draw all the text queued this frame
+        font.Flush(shader);
         shader.SetActiveShaderSet(previousShaderSet);
         // CAMERA
         m_Camera.UpdatePosition(InputController, CameraSpeed);
         if (renderImGuiGUI == true)
         editorFBO.Unbind();
         shader.Unbind();
+
+        GLCheckFrameErrors();
     }
 
     void GraphicsSystem::UpdateTexture(int main, int sub, const std::string& newPath)
     {
         textures[main][sub].UpdateTexture(newPath);
+        // The atlas still holds the old image, draw the new texture on its own
+        textureAtlas.Remove({ main, sub });
+        if (spriteBatch.GetSheets().Find({ main, sub }) >= 0)
+        {
+            spriteBatch.GetSheets().SetGrid({ main, sub }, AnimationLibrary::GetInstance().FrameCount(sub), 1);
+        }
         std::shared_ptr<Texture> texture = assetManager->getTexture(main, sub);
         texture->SetFilePath(newPath);
         texture->SetID(textures[main][sub].GetTextureID());       
     }
 
+    void GraphicsSystem::RenderUnitCount(Engine::font::Text& text, int count, int maxCount, float x)
+    {
+        if (count < 0 || count > maxCount)
+        {
+            return;
+        }
+        SmallString countString;
+        countString.Append("x").Append(static_cast<long long>(count));
+        text.Set(countString.View(), x, -0.95f, 0.0015f, glm::vec3(100.f, 100.f, 100.f));
+        font.RenderText(shader, text);
+    }
+
+    void GraphicsSystem::RenderTextLines(std::vector<Engine::font::Text>& texts, const TextLine* lines, size_t count)
+    {
+        texts.resize(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            texts[i].Set(lines[i].text, lines[i].x, lines[i].y, lines[i].scale, glm::vec3(0, 0, 0));
+            font.RenderText(shader, texts[i]);
+        }
+    }
+
     void GraphicsSystem::UpdateViewport(int width, int height)
     {
         glViewport(0, 0, width, height);
@@ -867,8 +794,6 @@ namespace Engine
 
     glm::mat4 GraphicsSystem::SetupModelMatrix(const glm::vec3& translation, float rotationAngle, const glm::vec3& scale)
     {
-        glfwGetWindowSize(Window, &screenWidth, &screenHeight);
-
         glm::mat4 model = glm::mat4(1.0f); // Initialize the model matrix as identity
 
         // Apply the provided translation, scale, and rotation
@@ -39,6 +39,13 @@ written consent of DigiPen Institute of Technology is prohibited.
 #include "EditorCamera.h"
 #include "Font.h"
 #include "EditorFBO.h"
+#include "SpriteBatch.h"
+#include "TextureAtlas.h"
+#include "RenderQueue.h"
+#include "CullingGrid.h"
+#include "TransformCache.h"
+#include "GLState.h"
+#include "UniformBuffer.h"
 
 extern bool fpsTimer;
 
@@ -137,25 +144,102 @@ namespace Engine
 
         void UpdateTexture(int main, int sub, const std::string& newPath);
 
+        /*!
+         * \brief Sets how far the frame is between the last two fixed steps.
+         *
+         * Moving entities are drawn this far from their transform before the last
+         * step to their transform after it.
+         *
+         * \param alpha The leftover time of the accumulator over the step length, from 0 to 1.
+         */
+        void SetInterpolationAlpha(float alpha) { interpolationAlpha = alpha; }
+
+        /*!
+         * \brief Gets the sprite batch counters of the last frame.
+         * \return A reference to the statistics.
+         */
+        const SpriteBatch::Stats& GetSpriteStats() const { return spriteBatch.GetStats(); }
+
+        /*!
+         * \brief Gets the counters of the texture atlas built at load time.
+         * \return A reference to the statistics.
+         */
+        const TextureAtlas::Stats& GetAtlasStats() const { return textureAtlas.GetStats(); }
+
+        /*!
+         * \brief Gets the render queue counters of the last frame.
+         * \return A reference to the statistics.
+         */
+        const RenderQueue::Stats& GetQueueStats() const { return renderQueue.GetStats(); }
+
+        /*!
+         * \brief Gets the viewport culling counters of the last frame.
+         * \return A reference to the statistics.
+         */
+        const CullingGrid::Stats& GetCullingStats() const { return cullingGrid.GetStats(); }
+
+        /*!
+         * \brief Gets the counters of the last transform update.
+         * \return A reference to the statistics.
+         */
+        const TransformCache::Stats& GetTransformStats() const { return transformCache.GetStats(); }
+
+        /*!
+         * \brief Gets the text counters of the last frame.
+         * \return A reference to the statistics.
+         */
+        const Engine::font::Stats& GetTextStats() const { return font.GetStats(); }
+
+        /*!
+         * \brief Gets the GL state cache counters of the last frame.
+         * \return A reference to the statistics.
+         */
+        const GLState::Stats& GetStateStats() const { return GLState::GetInstance().GetStats(); }
+
         /*!
         * \brief Render a textured entity.
         *
-        * This function renders a textured entity with the specified MVP matrix and alternates
-        * between two textures based on time.
+        * This function queues a textured entity, picking the current animation frame of
+        * its sprite sheet. It is sorted by layer, then by creation order.
         *
-        * \param mvpMatrix The Model-View-Projection matrix for rendering.
+        * \param transform The cached transform of the entity. The camera is applied by the batch.
+        * \param entity The entity drawn.
         */
-        void RenderTexturedEntity(const glm::mat4& mvpMatrix, Entity* entity);
+        void RenderTexturedEntity(const Transform2D& transform, Entity* entity);
 
         /*!
-         * \brief Render the background using the provided Model-View-Projection matrix.
+         * \brief Render the background.
          *
-         * This function renders the background using the specified Model-View-Projection matrix.
-         * The background is rendered using the shader program set for rendering textured entities.
+         * This function queues a background quad the size of the window, as measured at
+         * the start of the frame, centered on the origin behind every other sprite.
+         */
+        void RenderBackground();
+
+        // A line of static text, black and centred on x
+        struct TextLine
+        {
+            const char* text;
+            float x, y, scale;
+        };
+
+        /*!
+         * \brief Render the number of a unit left to place, as "x" and the count.
          *
-         * \param mvpMatrix The Model-View-Projection matrix for rendering.
+         * \param text The text object kept for the counter, laid out again only when the count changes.
+         * \param count The number left. Nothing is drawn outside 0 to maxCount.
+         * \param maxCount The most of the unit that can be placed.
+         * \param x The x-coordinate of the centre of the counter, in clip space.
+         */
+        void RenderUnitCount(Engine::font::Text& text, int count, int maxCount, float x);
+
+        /*!
+         * \brief Render a page of static text from the text objects kept for it.
+         *
+         * \param texts The text objects of the page, one per line.
+         * \param lines The lines of the page.
+         * \param count The number of lines.
          */
-        void RenderBackground(const glm::mat4& mvpMatrix);
+        void RenderTextLines(std::vector<Engine::font::Text>& texts, const TextLine* lines, size_t count);
 
         /*!
          * \brief Render lines.
@@ -207,7 +291,7 @@ namespace Engine
         */
         //void DrawColoredSquare(const glm::mat4& mvpMatrix);
         //void SetMaxBatchSize(int maxSize);
-        int screenWidth{}, screenHeight{};
+        int screenWidth{}, screenHeight{};     // Window size, read once at the start of each frame
       
         double animationStartTime{};
         double frameDuration{}; 
@@ -233,6 +317,7 @@ namespace Engine
     private:
         Shader shader;
         std::vector<std::vector<Texture>> textures;
+        TextureAtlas textureAtlas;
 
         float rotationAngleA{}, rotationAngleB{};
         glm::vec3 translationA{}, translationB{};
@@ -269,6 +354,36 @@ namespace Engine
         VertexArray vaSingleLine;
 
         font font;
+        // Text drawn every frame, kept laid out between frames. Each banner has its own text so
+        // showing both does not lay them out again every frame
+        Engine::font::Text pausedText, settingsText;
+        Engine::font::Text infantryCountText, archerCountText, tankCountText;
+        Engine::font::Text fpsText;
+        std::vector<Engine::font::Text> howToPlayTexts, creditsTexts;
+        SpriteBatch spriteBatch;
+
+        // Data shared by every program through the Frame uniform block, laid out as std140
+        struct FrameUniforms
+        {
+            glm::mat4 viewProjection;
+        };
+        static constexpr unsigned int FRAME_UNIFORM_BINDING = 0;   // binding of the Frame block in the shaders
+        std::unique_ptr<UniformBuffer> frameUniformBuffer;
+
+        UniformHandle<glm::vec4> colorUniform;
+        UniformHandle<int> renderTexturedUniform;
+        RenderQueue renderQueue;
+        CullingGrid cullingGrid;
+        TransformCache transformCache;
+
+        // An entity drawn this frame, collected before culling
+        struct Drawable
+        {
+            Entity* entity;
+            TextureComponent* texture;
+            int transformSlot;      // Slot in transformCache
+        };
+        std::vector<Drawable> drawables;
 
         Renderer renderer;
 
@@ -284,6 +399,7 @@ namespace Engine
 
         float CameraSpeed = 0.0f;
         float yOffset = 1.0f;
+        float interpolationAlpha = 1.0f;
        
 
         float vtx_positions[16]{};
@@ -0,0 +1,553 @@
+/******************************************************************************/
+/*!
+\file		HierarchicalPathfinder.cpp
+\author		Ang Jun Sheng Aloysius, a.junshengaloysius, 2201807
+
+\par		a.junshengaloysius@digipen.edu
+
+\date		02/04/2024
+
+\brief		Contains the definitions of the hierarchical (HPA*) pathfinder.
+Copyright (C) 2024 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+ */
+ /******************************************************************************/
+
+#include "pch.h"
+#include "HierarchicalPathfinder.h"
+
+namespace Engine
+{
+    namespace
+    {
+        // Entrances shorter than this get a single transition in the middle,
+        // longer ones get a transition at each end
+        const int MAX_SINGLE_TRANSITION_LENGTH = 6;
+
+        const int DX[] = { -1, 1, 0, 0 };
+        const int DY[] = { 0, 0, -1, 1 };
+    }
+
+    HierarchicalPathfinder::HierarchicalPathfinder(int _clusterSize)
+        : clusterSize(_clusterSize > 1 ? _clusterSize : 2)
+    {
+    }
+
+    bool HierarchicalPathfinder::Blocked(int x, int y) const
+    {
+        if (x < 0 || y < 0 || x >= width || y >= height)
+        {
+            return true;
+        }
+        return isBlocked(x, y);
+    }
+
+    int HierarchicalPathfinder::AddNode(int x, int y)
+    {
+        int id;
+        if (!freeNodes.empty())
+        {
+            id = freeNodes.back();
+            freeNodes.pop_back();
+        }
+        else
+        {
+            id = static_cast<int>(nodes.size());
+            nodes.emplace_back();
+        }
+
+        Node& node = nodes[id];
+        node.x = x;
+        node.y = y;
+        node.cluster = ClusterAt(x, y);
+        node.alive = true;
+        node.edges.clear();
+        clusters[node.cluster].nodes.push_back(id);
+        return id;
+    }
+
+    void HierarchicalPathfinder::RemoveNode(int id)
+    {
+        Node& node = nodes[id];
+        std::vector<int>& clusterNodes = clusters[node.cluster].nodes;
+        clusterNodes.erase(std::remove(clusterNodes.begin(), clusterNodes.end(), id), clusterNodes.end());
+        node.alive = false;
+        node.edges.clear();
+        freeNodes.push_back(id);
+    }
+
+    void HierarchicalPathfinder::ClearBorder(int cx, int cy, bool east)
+    {
+        std::vector<int>& border = east ? eastBorders[ClusterIndex(cx, cy)] : northBorders[ClusterIndex(cx, cy)];
+        for (int id : border)
+        {
+            RemoveNode(id);
+        }
+        border.clear();
+    }
+
+    void HierarchicalPathfinder::BuildBorder(int cx, int cy, bool east)
+    {
+        const Cluster& cluster = clusters[ClusterIndex(cx, cy)];
+        std::vector<int>& border = east ? eastBorders[ClusterIndex(cx, cy)] : northBorders[ClusterIndex(cx, cy)];
+
+        // Cells along the border on this side, and the offset to the neighbouring side
+        int first = east ? cluster.minY : cluster.minX;
+        int last = east ? cluster.maxY : cluster.maxX;
+        auto cellAt = [&](int t) { return east ? std::make_pair(cluster.maxX, t) : std::make_pair(t, cluster.maxY); };
+        int offsetX = east ? 1 : 0;
+        int offsetY = east ? 0 : 1;
+
+        auto addTransition = [&](int t)
+            {
+                std::pair<int, int> cell = cellAt(t);
+                int a = AddNode(cell.first, cell.second);
+                int b = AddNode(cell.first + offsetX, cell.second + offsetY);
+                nodes[a].edges.push_back({ b, 1, true });
+                nodes[b].edges.push_back({ a, 1, true });
+                border.push_back(a);
+                border.push_back(b);
+            };
+
+        int runStart = -1;
+        for (int t = first; t <= last + 1; ++t)
+        {
+            bool open = false;
+            if (t <= last)
+            {
+                std::pair<int, int> cell = cellAt(t);
+                open = !Blocked(cell.first, cell.second) && !Blocked(cell.first + offsetX, cell.second + offsetY);
+            }
+
+            if (open && runStart < 0)
+            {
+                runStart = t;
+            }
+            else if (!open && runStart >= 0)
+            {
+                int runEnd = t - 1;
+                if (runEnd - runStart + 1 < MAX_SINGLE_TRANSITION_LENGTH)
+                {
+                    addTransition((runStart + runEnd) / 2);
+                }
+                else
+                {
+                    addTransition(runStart);
+                    addTransition(runEnd);
+                }
+                runStart = -1;
+            }
+        }
+    }
+
+    void HierarchicalPathfinder::ClusterSearch(const Cluster& cluster, int startX, int startY,
+        std::vector<int>& dist, std::vector<int>* parent) const
+    {
+        int localWidth = cluster.maxX - cluster.minX + 1;
+        int localHeight = cluster.maxY - cluster.minY + 1;
+        dist.assign(static_cast<size_t>(localWidth) * localHeight, -1);
+        if (parent)
+        {
+            parent->assign(dist.size(), -1);
+        }
+
+        if (Blocked(startX, startY))
+        {
+            return;
+        }
+
+        // Unit step costs, so a breadth first search gives the shortest distances
+        std::vector<int> open;
+        open.reserve(dist.size());
+        int startIndex = (startY - cluster.minY) * localWidth + (startX - cluster.minX);
+        dist[startIndex] = 0;
+        open.push_back(startIndex);
+
+        for (size_t head = 0; head < open.size(); ++head)
+        {
+            int current = open[head];
+            int x = current % localWidth + cluster.minX;
+            int y = current / localWidth + cluster.minY;
+
+            for (int i = 0; i < 4; ++i)
+            {
+                int newX = x + DX[i];
+                int newY = y + DY[i];
+                if (newX < cluster.minX || newX > cluster.maxX || newY < cluster.minY || newY > cluster.maxY)
+                {
+                    continue;
+                }
+
+                int next = (newY - cluster.minY) * localWidth + (newX - cluster.minX);
+                if (dist[next] >= 0 || Blocked(newX, newY))
+                {
+                    continue;
+                }
+
+                dist[next] = dist[current] + 1;
+                if (parent)
+                {
+                    (*parent)[next] = current;
+                }
+                open.push_back(next);
+            }
+        }
+    }
+
+    void HierarchicalPathfinder::BuildIntraEdges(int clusterIndex)
+    {
+        Cluster& cluster = clusters[clusterIndex];
+        int localWidth = cluster.maxX - cluster.minX + 1;
+
+        // Only the edges to the neighbouring cluster survive a rebuild
+        for (int id : cluster.nodes)
+        {
+            std::vector<Edge>& edges = nodes[id].edges;
+            edges.erase(std::remove_if(edges.begin(), edges.end(), [](const Edge& edge) { return !edge.inter; }), edges.end());
+        }
+
+        std::vector<int> dist;
+        for (size_t i = 0; i < cluster.nodes.size(); ++i)
+        {
+            int from = cluster.nodes[i];
+            ClusterSearch(cluster, nodes[from].x, nodes[from].y, dist, nullptr);
+
+            for (size_t j = i + 1; j < cluster.nodes.size(); ++j)
+            {
+                int to = cluster.nodes[j];
+                int cost = dist[(nodes[to].y - cluster.minY) * localWidth + (nodes[to].x - cluster.minX)];
+                if (cost >= 0)
+                {
+                    nodes[from].edges.push_back({ to, cost, false });
+                    nodes[to].edges.push_back({ from, cost, false });
+                }
+            }
+        }
+    }
+
+    void HierarchicalPathfinder::Build(int _width, int _height, BlockedFunction _isBlocked)
+    {
+        auto buildStart = std::chrono::high_resolution_clock::now();
+
+        width = _width;
+        height = _height;
+        isBlocked = std::move(_isBlocked);
+        clustersX = (width + clusterSize - 1) / clusterSize;
+        clustersY = (height + clusterSize - 1) / clusterSize;
+
+        clusters.assign(static_cast<size_t>(clustersX) * clustersY, Cluster());
+        for (int cy = 0; cy < clustersY; ++cy)
+        {
+            for (int cx = 0; cx < clustersX; ++cx)
+            {
+                Cluster& cluster = clusters[ClusterIndex(cx, cy)];
+                cluster.minX = cx * clusterSize;
+                cluster.minY = cy * clusterSize;
+                cluster.maxX = std::min(cluster.minX + clusterSize, width) - 1;
+                cluster.maxY = std::min(cluster.minY + clusterSize, height) - 1;
+            }
+        }
+
+        nodes.clear();
+        freeNodes.clear();
+        eastBorders.assign(clusters.size(), {});
+        northBorders.assign(clusters.size(), {});
+
+        for (int cy = 0; cy < clustersY; ++cy)
+        {
+            for (int cx = 0; cx < clustersX; ++cx)
+            {
+                if (cx + 1 < clustersX)
+                {
+                    BuildBorder(cx, cy, true);
+                }
+                if (cy + 1 < clustersY)
+                {
+                    BuildBorder(cx, cy, false);
+                }
+            }
+        }
+
+        for (int i = 0; i < static_cast<int>(clusters.size()); ++i)
+        {
+            BuildIntraEdges(i);
+        }
+
+        built = true;
+
+        stats.clusters = static_cast<int>(clusters.size());
+        stats.lastRebuiltClusters = stats.clusters;
+        stats.abstractNodes = 0;
+        stats.abstractEdges = 0;
+        for (const Node& node : nodes)
+        {
+            if (node.alive)
+            {
+                ++stats.abstractNodes;
+                stats.abstractEdges += static_cast<int>(node.edges.size());
+            }
+        }
+        stats.lastBuildMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - buildStart).count();
+    }
+
+    void HierarchicalPathfinder::OnRegionChanged(int minX, int minY, int maxX, int maxY)
+    {
+        if (!built)
+        {
+            return;
+        }
+
+        auto buildStart = std::chrono::high_resolution_clock::now();
+
+        // A changed cell can open or close an entrance on the border it touches
+        int cx0 = std::max(0, (minX - 1) / clusterSize);
+        int cy0 = std::max(0, (minY - 1) / clusterSize);
+        int cx1 = std::min(clustersX - 1, (maxX + 1) / clusterSize);
+        int cy1 = std::min(clustersY - 1, (maxY + 1) / clusterSize);
+        if (cx0 > cx1 || cy0 > cy1)
+        {
+            return;
+        }
+
+        // Every border of the changed clusters, including the ones owned by the west and south neighbours
+        std::vector<std::pair<int, bool>> borders;
+        for (int cy = cy0; cy <= cy1; ++cy)
+        {
+            for (int cx = cx0; cx <= cx1; ++cx)
+            {
+                if (cx + 1 < clustersX) borders.push_back({ ClusterIndex(cx, cy), true });
+                if (cy + 1 < clustersY) borders.push_back({ ClusterIndex(cx, cy), false });
+                if (cx > 0 && cx == cx0) borders.push_back({ ClusterIndex(cx - 1, cy), true });
+                if (cy > 0 && cy == cy0) borders.push_back({ ClusterIndex(cx, cy - 1), false });
+            }
+        }
+
+        for (const auto& border : borders)
+        {
+            ClearBorder(border.first % clustersX, border.first / clustersX, border.second);
+        }
+        for (const auto& border : borders)
+        {
+            BuildBorder(border.first % clustersX, border.first / clustersX, border.second);
+        }
+
+        // The neighbours share the rebuilt borders, so their intra-cluster edges change too
+        int rebuilt = 0;
+        for (int cy = std::max(0, cy0 - 1); cy <= std::min(clustersY - 1, cy1 + 1); ++cy)
+        {
+            for (int cx = std::max(0, cx0 - 1); cx <= std::min(clustersX - 1, cx1 + 1); ++cx)
+            {
+                BuildIntraEdges(ClusterIndex(cx, cy));
+                ++rebuilt;
+            }
+        }
+
+        stats.lastRebuiltClusters = rebuilt;
+        stats.abstractNodes = 0;
+        stats.abstractEdges = 0;
+        for (const Node& node : nodes)
+        {
+            if (node.alive)
+            {
+                ++stats.abstractNodes;
+                stats.abstractEdges += static_cast<int>(node.edges.size());
+            }
+        }
+        stats.lastBuildMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - buildStart).count();
+    }
+
+    bool HierarchicalPathfinder::RefineSegment(const Cluster& cluster, int fromX, int fromY, int toX, int toY,
+        std::vector<std::pair<int, int>>& outPath) const
+    {
+        if (fromX == toX && fromY == toY)
+        {
+            return true;
+        }
+
+        // Search backwards from the target so parents lead from the source towards it
+        std::vector<int> dist;
+        std::vector<int> parent;
+        ClusterSearch(cluster, toX, toY, dist, &parent);
+
+        int localWidth = cluster.maxX - cluster.minX + 1;
+        int current = (fromY - cluster.minY) * localWidth + (fromX - cluster.minX);
+        if (dist[current] < 0)
+        {
+            return false;
+        }
+
+        while (parent[current] >= 0)
+        {
+            current = parent[current];
+            outPath.push_back({ current % localWidth + cluster.minX, current / localWidth + cluster.minY });
+        }
+        return true;
+    }
+
+    std::vector<std::pair<int, int>> HierarchicalPathfinder::FindPath(int startX, int startY, int goalX, int goalY)
+    {
+        stats.lastAbstractExpanded = 0;
+        stats.lastRefinedSegments = 0;
+
+        if (!built || Blocked(startX, startY) || Blocked(goalX, goalY))
+        {
+            return {};
+        }
+
+        std::vector<std::pair<int, int>> path = { { startX, startY } };
+        int startCluster = ClusterAt(startX, startY);
+        int goalCluster = ClusterAt(goalX, goalY);
+
+        // Same cluster, try the direct route first
+        if (startCluster == goalCluster)
+        {
+            ++stats.lastRefinedSegments;
+            if (RefineSegment(clusters[startCluster], startX, startY, goalX, goalY, path))
+            {
+                return path;
+            }
+        }
+
+        // Temporarily connect the start and goal to the entrances of their clusters.
+        // They are kept out of the graph so queries never modify it.
+        const int nodeCount = static_cast<int>(nodes.size());
+        const int startNode = nodeCount;
+        const int goalNode = nodeCount + 1;
+
+        std::vector<int> dist;
+        std::vector<Edge> startEdges;
+        const Cluster& first = clusters[startCluster];
+        ClusterSearch(first, startX, startY, dist, nullptr);
+        for (int id : first.nodes)
+        {
+            int cost = dist[(nodes[id].y - first.minY) * (first.maxX - first.minX + 1) + (nodes[id].x - first.minX)];
+            if (cost >= 0)
+            {
+                startEdges.push_back({ id, cost, false });
+            }
+        }
+
+        std::vector<int> goalCost(nodeCount, -1);
+        bool goalReachable = false;
+        const Cluster& last = clusters[goalCluster];
+        ClusterSearch(last, goalX, goalY, dist, nullptr);
+        for (int id : last.nodes)
+        {
+            goalCost[id] = dist[(nodes[id].y - last.minY) * (last.maxX - last.minX + 1) + (nodes[id].x - last.minX)];
+            goalReachable = goalReachable || goalCost[id] >= 0;
+        }
+
+        if (startEdges.empty() || !goalReachable)
+        {
+            return {};
+        }
+
+        // A* over the abstract graph
+        auto heuristic = [&](int id)
+            {
+                if (id == goalNode) return 0;
+                int x = id == startNode ? startX : nodes[id].x;
+                int y = id == startNode ? startY : nodes[id].y;
+                return std::abs(x - goalX) + std::abs(y - goalY);
+            };
+
+        std::vector<int> gScore(nodeCount + 2, std::numeric_limits<int>::max());
+        std::vector<int> parent(nodeCount + 2, -1);
+        std::vector<char> closed(nodeCount + 2, 0);
+        std::priority_queue<std::pair<int, int>, std::vector<std::pair<int, int>>, std::greater<std::pair<int, int>>> open;
+
+        gScore[startNode] = 0;
+        open.push({ heuristic(startNode), startNode });
+
+        auto relax = [&](int from, int to, int cost)
+            {
+                int newCost = gScore[from] + cost;
+                if (!closed[to] && newCost < gScore[to])
+                {
+                    gScore[to] = newCost;
+                    parent[to] = from;
+                    open.push({ newCost + heuristic(to), to });
+                }
+            };
+
+        while (!open.empty())
+        {
+            int current = open.top().second;
+            open.pop();
+            if (closed[current])
+            {
+                continue;
+            }
+            closed[current] = 1;
+            ++stats.lastAbstractExpanded;
+
+            if (current == goalNode)
+            {
+                break;
+            }
+
+            if (current == startNode)
+            {
+                for (const Edge& edge : startEdges)
+                {
+                    relax(current, edge.to, edge.cost);
+                }
+                continue;
+            }
+
+            for (const Edge& edge : nodes[current].edges)
+            {
+                relax(current, edge.to, edge.cost);
+            }
+            if (goalCost[current] >= 0)
+            {
+                relax(current, goalNode, goalCost[current]);
+            }
+        }
+
+        if (!closed[goalNode])
+        {
+            return {};
+        }
+
+        std::vector<int> abstractPath;
+        for (int id = goalNode; id != startNode; id = parent[id])
+        {
+            abstractPath.push_back(id);
+        }
+        std::reverse(abstractPath.begin(), abstractPath.end());
+
+        // Refine only the segments the abstract path uses
+        int fromX = startX;
+        int fromY = startY;
+        int fromCluster = startCluster;
+        for (int id : abstractPath)
+        {
+            int toX = id == goalNode ? goalX : nodes[id].x;
+            int toY = id == goalNode ? goalY : nodes[id].y;
+            int toCluster = id == goalNode ? goalCluster : nodes[id].cluster;
+
+            if (fromCluster != toCluster)
+            {
+                // Crossing an entrance is a single step into the neighbouring cluster
+                path.push_back({ toX, toY });
+            }
+            else
+            {
+                ++stats.lastRefinedSegments;
+                if (!RefineSegment(clusters[fromCluster], fromX, fromY, toX, toY, path))
+                {
+                    return {};
+                }
+            }
+
+            fromX = toX;
+            fromY = toY;
+            fromCluster = toCluster;
+        }
+
+        return path;
+    }
+}
@@ -0,0 +1,190 @@
+/******************************************************************************/
+/*!
+\file		HierarchicalPathfinder.h
+\author		Ang Jun Sheng Aloysius, a.junshengaloysius, 2201807
+
+\par		a.junshengaloysius@digipen.edu
+
+\date		02/04/2024
+
+\brief		Contains the declaration of the hierarchical (HPA*) pathfinder.
+			The navigation grid is partitioned into square clusters, entrances
+			between neighbouring clusters become abstract nodes, and queries
+			search the abstract graph first before refining only the cluster
+			segments the abstract path passes through.
+Copyright (C) 2024 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+ */
+ /******************************************************************************/
+#ifndef ENGINE_HIERARCHICALPATHFINDER_H
+#define ENGINE_HIERARCHICALPATHFINDER_H
+
+#include <vector>
+#include <functional>
+#include <utility>
+
+namespace Engine
+{
+    class HierarchicalPathfinder
+    {
+    public:
+        // Returns true if the grid cell at (x, y) cannot be walked through
+        using BlockedFunction = std::function<bool(int, int)>;
+
+        /*!
+        \brief Counters describing the abstract graph and the last query.
+        */
+        struct Stats
+        {
+            int clusters = 0;
+            int abstractNodes = 0;
+            int abstractEdges = 0;
+            int lastAbstractExpanded = 0;   // Abstract nodes expanded by the last query
+            int lastRefinedSegments = 0;    // Intra-cluster segments refined by the last query
+            int lastRebuiltClusters = 0;    // Clusters touched by the last build or local update
+            double lastBuildMs = 0.0;
+        };
+
+        /**************************************************************************/
+        /*!
+        \brief Constructor for the hierarchical pathfinder.
+
+        \param[in] clusterSize
+        The width and height of a cluster in grid cells.
+        */
+        /**************************************************************************/
+        explicit HierarchicalPathfinder(int clusterSize = 32);
+
+        /**************************************************************************/
+        /*!
+        \brief Partitions the grid into clusters and builds the whole abstract graph.
+
+        \param[in] width
+        The width of the navigation grid in cells.
+
+        \param[in] height
+        The height of the navigation grid in cells.
+
+        \param[in] isBlocked
+        Query used to test whether a grid cell is an obstacle. It is kept and used
+        again by local updates and queries.
+        */
+        /**************************************************************************/
+        void Build(int width, int height, BlockedFunction isBlocked);
+
+        /**************************************************************************/
+        /*!
+        \brief Updates the abstract graph after obstacles inside a region changed.
+        Only the clusters overlapping the region and their direct neighbours are
+        rebuilt.
+
+        \param[in] minX, minY
+        The inclusive lower corner of the changed region in grid cells.
+
+        \param[in] maxX, maxY
+        The inclusive upper corner of the changed region in grid cells.
+        */
+        /**************************************************************************/
+        void OnRegionChanged(int minX, int minY, int maxX, int maxY);
+
+        /**************************************************************************/
+        /*!
+        \brief Finds a path between two grid cells.
+
+        \param[in] startX, startY
+        The start cell.
+
+        \param[in] goalX, goalY
+        The goal cell.
+
+        \return
+        The list of 4-connected grid cells from start to goal, or an empty vector
+        if no path exists.
+        */
+        /**************************************************************************/
+        std::vector<std::pair<int, int>> FindPath(int startX, int startY, int goalX, int goalY);
+
+        /*!
+        \brief Checks if the abstract graph has been built.
+        \return True once Build has been called.
+        */
+        bool IsBuilt() const { return built; }
+
+        /*!
+        \brief Gets the width of the grid the graph was built for.
+        \return The width in cells.
+        */
+        int GetWidth() const { return width; }
+
+        /*!
+        \brief Gets the height of the grid the graph was built for.
+        \return The height in cells.
+        */
+        int GetHeight() const { return height; }
+
+        /*!
+        \brief Gets the graph and query statistics.
+        \return The statistics.
+        */
+        const Stats& GetStats() const { return stats; }
+
+    private:
+        struct Edge
+        {
+            int to;
+            int cost;
+            bool inter; // True for the edge crossing into the neighbouring cluster
+        };
+
+        struct Node
+        {
+            int x, y;
+            int cluster;
+            bool alive;
+            std::vector<Edge> edges;
+        };
+
+        struct Cluster
+        {
+            int minX, minY, maxX, maxY; // Inclusive bounds in grid cells
+            std::vector<int> nodes;
+        };
+
+        int ClusterIndex(int cx, int cy) const { return cy * clustersX + cx; }
+        int ClusterAt(int x, int y) const { return ClusterIndex(x / clusterSize, y / clusterSize); }
+        bool Blocked(int x, int y) const;
+
+        int AddNode(int x, int y);
+        void RemoveNode(int id);
+
+        // Borders are numbered per cluster: the east border and the north border
+        void ClearBorder(int cx, int cy, bool east);
+        void BuildBorder(int cx, int cy, bool east);
+        void BuildIntraEdges(int clusterIndex);
+
+        // Breadth first search limited to the bounds of one cluster
+        void ClusterSearch(const Cluster& cluster, int startX, int startY,
+            std::vector<int>& dist, std::vector<int>* parent) const;
+        bool RefineSegment(const Cluster& cluster, int fromX, int fromY, int toX, int toY,
+            std::vector<std::pair<int, int>>& outPath) const;
+
+        int clusterSize;
+        int width = 0;
+        int height = 0;
+        int clustersX = 0;
+        int clustersY = 0;
+        bool built = false;
+        BlockedFunction isBlocked;
+
+        std::vector<Cluster> clusters;
+        std::vector<Node> nodes;
+        std::vector<int> freeNodes;
+        // Node ids of the entrances on the east and north border of every cluster
+        std::vector<std::vector<int>> eastBorders;
+        std::vector<std::vector<int>> northBorders;
+        Stats stats;
+    };
+}
+#endif ENGINE_HIERARCHICALPATHFINDER_H
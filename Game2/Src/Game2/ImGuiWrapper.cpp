@@ -476,6 +476,168 @@ namespace Engine {
 		}
 	}
 
+	void ImGuiWrapper::DisplayPathfindingStats() {
+		const PathCache::Stats& cacheStats = PathfindingSystem::GetPathCache().GetStats();
+
+		if (ImGui::CollapsingHeader("Pathfinding")) {
+			ImGui::Text("Nav Map Version: %u", PathfindingSystem::GetNavMapVersion());
+			const OccupancyGrid& collisionMap = PathfindingSystem::GetCollisionMap();
+			ImGui::Text("Collision Map: %d x %d, %.1f KB, %zu cells blocked", collisionMap.GetWidth(), collisionMap.GetHeight(), collisionMap.GetMemoryBytes() / 1024.0, collisionMap.CountBlocked());
+			ImGui::Text("Collision Map Rebuild: %.3f ms", PathfindingSystem::GetCollisionMapBuildMs());
+			const DistanceField::Stats& fieldStats = PathfindingSystem::GetDistanceField().GetStats();
+			ImGui::Text("Distance Field Rebuild: %.3f ms, %.1f KB, max clearance %d", fieldStats.buildMs, fieldStats.memoryBytes / 1024.0, fieldStats.maxClearance);
+			ImGui::Text("Path Cache Hit Rate: %.1f%% (%llu hits, %llu misses)", cacheStats.HitRate() * 100.0, cacheStats.hits, cacheStats.misses);
+			ImGui::Text("Path Cache Entries: %zu", cacheStats.entries);
+			ImGui::Text("Path Cache Memory: %.2f KB", cacheStats.memoryBytes / 1024.0);
+			ImGui::Text("Evictions: %llu stale, %llu capacity", cacheStats.staleEvictions, cacheStats.capacityEvictions);
+			if (ImGui::Button("Reset Path Cache Stats")) {
+				PathfindingSystem::GetPathCache().ResetStats();
+			}
+
+			const HierarchicalPathfinder::Stats& hpaStats = PathfindingSystem::GetHierarchicalPathfinder().GetStats();
+			ImGui::Separator();
+			ImGui::Text("HPA* Clusters: %d, Abstract Nodes: %d, Edges: %d", hpaStats.clusters, hpaStats.abstractNodes, hpaStats.abstractEdges);
+			ImGui::Text("HPA* Last Query: %d nodes expanded, %d segments refined", hpaStats.lastAbstractExpanded, hpaStats.lastRefinedSegments);
+			ImGui::Text("HPA* Last Build: %d clusters in %.2f ms", hpaStats.lastRebuiltClusters, hpaStats.lastBuildMs);
+			const JumpPointSearch::Stats& jpsStats = PathfindingSystem::GetJumpPointSearch().GetStats();
+			ImGui::Separator();
+			ImGui::Text("Grid Search Last Query: %d nodes expanded, %d jump points, cost %.1f", jpsStats.lastExpanded, jpsStats.lastJumpPoints, jpsStats.lastPathCost);
+			ImGui::Text("JPS+ Tables: %.2f KB, built in %.2f ms", jpsStats.tableBytes / 1024.0, jpsStats.precomputeMs);
+
+			PathRequestQueue::Stats queueStats = PathfindingSystem::GetPathRequestQueue().GetStats();
+			ImGui::Separator();
+			bool asyncPathfinding = PathfindingSystem::IsAsyncPathfinding();
+			if (ImGui::Checkbox("Async Path Requests", &asyncPathfinding)) {
+				PathfindingSystem::SetAsyncPathfinding(asyncPathfinding);
+			}
+			ImGui::Text("Workers: %d, Queued Searches: %zu, Outstanding Tickets: %zu", queueStats.workers, queueStats.queued, queueStats.outstanding);
+			ImGui::Text("Submitted: %llu, Coalesced: %llu, Cancelled: %llu", queueStats.submitted, queueStats.coalesced, queueStats.cancelled);
+			ImGui::Text("Completed: %llu (avg %.3f ms), Stale: %llu", queueStats.completed, queueStats.averageSearchMs, queueStats.stale);
+			ImGui::Text("Last Collect: %d results in %.3f ms", queueStats.lastCollected, queueStats.lastCollectMs);
+			if (ImGui::Button("Reset Path Request Stats")) {
+				PathfindingSystem::GetPathRequestQueue().ResetStats();
+			}
+
+			const CrowdAvoidance::Stats& crowdStats = PathfindingSystem::GetCrowdAvoidance().GetStats();
+			ImGui::Separator();
+			bool crowdAvoidance = PathfindingSystem::IsCrowdAvoidance();
+			if (ImGui::Checkbox("Crowd Avoidance", &crowdAvoidance)) {
+				PathfindingSystem::SetCrowdAvoidance(crowdAvoidance);
+			}
+			ImGui::Text("Crowd Agents: %d, avg %.1f neighbours, %d hash buckets", crowdStats.agents, crowdStats.averageNeighbours, crowdStats.hashCells);
+			ImGui::Text("Crowd Solve: %.3f ms (hash %.3f ms)", crowdStats.lastSolveMs, crowdStats.lastBuildMs);
+
+			// Timed on a synthetic crowd, the game's own agents are untouched
+			static std::vector<CrowdAvoidance::BenchmarkResult> crowdBenchmark;
+			if (ImGui::Button("Run Crowd Benchmark")) {
+				crowdBenchmark.clear();
+				for (int agents : { 100, 1000, 5000 }) {
+					crowdBenchmark.push_back(CrowdAvoidance::RunBenchmark(agents, 120));
+				}
+			}
+			for (const CrowdAvoidance::BenchmarkResult& result : crowdBenchmark) {
+				ImGui::Text("%5d agents: %.3f ms per step, avg %.1f neighbours", result.agents, result.averageSolveMs, result.averageNeighbours);
+			}
+		}
+	}
+
+	void ImGuiWrapper::DisplayPhysicsStats() {
+		if (ImGui::CollapsingHeader("Physics")) {
+			const PhysicsWorld::Stats& worldStats = PhysicsSystem::GetPhysicsWorld().GetStats();
+			ImGui::Text("Bodies: %d, Moved Last Step: %d", worldStats.bodies, worldStats.moved);
+			ImGui::Text("Last Step: %.3f ms integrate, %.3f ms sync", worldStats.lastStepMs, worldStats.lastSyncMs);
+
+			// Static and sleeping bodies are skipped by the integration and the broad phase
+			const CollisionSystem::BodyStats& bodyStats = CollisionSystem::GetBodyStats();
+			ImGui::Text("Static: %d", bodyStats.staticBodies);
+			ImGui::Text("Kinematic: %d awake, %d sleeping", bodyStats.kinematicAwake, bodyStats.kinematicSleeping);
+			ImGui::Text("Dynamic: %d awake, %d sleeping", worldStats.awake, worldStats.sleeping);
+			ImGui::Text("Collision Pairs: %d tested, %d skipped", bodyStats.pairsTested, bodyStats.pairsSkipped);
+
+			// Timed on synthetic bodies, the game's own bodies are untouched
+			static PhysicsWorld::BenchmarkResult physicsBenchmark;
+			if (ImGui::Button("Run Integrator Benchmark")) {
+				physicsBenchmark = PhysicsWorld::RunBenchmark(10000, 120);
+			}
+			if (physicsBenchmark.bodies > 0) {
+				ImGui::Text("%d bodies: %.3f ms with Rigidbody temporaries, %.3f ms in the world with sync (%.2fx)", physicsBenchmark.bodies,
+					physicsBenchmark.rigidbodyMs, physicsBenchmark.worldMs, physicsBenchmark.rigidbodyMs / std::max(physicsBenchmark.worldMs, 0.0001));
+			}
+		}
+	}
+
+	void ImGuiWrapper::DisplayRenderStats() {
+		if (ImGui::CollapsingHeader("Rendering")) {
+			GraphicsSystem* graphicSystem = SystemsManager::GetInstance().GetSystem<GraphicsSystem>();
+			if (graphicSystem) {
+				const SpriteBatch::Stats& spriteStats = graphicSystem->GetSpriteStats();
+				ImGui::Text("Sprites: %d, Vertices: %d", spriteStats.sprites, spriteStats.vertices);
+				ImGui::Text("Draw Calls: %d (%d instanced), Early Flushes: %d", spriteStats.drawCalls, spriteStats.instancedDrawCalls, spriteStats.flushes);
+				ImGui::Text("Instanced Sprites: %d", spriteStats.instances);
+
+				const TextureAtlas::Stats& atlasStats = graphicSystem->GetAtlasStats();
+				ImGui::Text("Atlas: %d textures (%d frames) in %d pages, %.0f%% used", atlasStats.images, atlasStats.regions,
+					atlasStats.pages, atlasStats.occupancy * 100.0f);
+				ImGui::Text("Standalone Textures: %d", atlasStats.standalone);
+
+				const RenderQueue::Stats& queueStats = graphicSystem->GetQueueStats();
+				ImGui::Text("Commands: %d, Texture Changes: %d", queueStats.commands, queueStats.textureChanges);
+				ImGui::Text("Queue: %.3f ms sort, %.3f ms total", queueStats.sortMs, queueStats.executeMs);
+
+				const AnimationSystem::Stats& animationStats = SystemsManager::GetInstance().GetSystem<AnimationSystem>()->GetStats();
+				ImGui::Text("Animations: %d playing, %d frame changes, %d restarted", animationStats.animated, animationStats.frameChanges, animationStats.clipChanges);
+
+				const TransformCache::Stats& transformStats = graphicSystem->GetTransformStats();
+				ImGui::Text("Transforms: %d recomputed of %d, %.3f ms", transformStats.recomputed, transformStats.transforms, transformStats.computeMs);
+
+				const Engine::font::Stats& textStats = graphicSystem->GetTextStats();
+				ImGui::Text("Text: %d glyphs in %d draw calls", textStats.glyphs, textStats.drawCalls);
+				ImGui::Text("Text Layouts: %d laid out, %d cached", textStats.layouts, textStats.cachedTexts);
+
+				const CullingGrid::Stats& cullingStats = graphicSystem->GetCullingStats();
+				ImGui::Text("Culling: %d visible, %d culled of %d", cullingStats.visible, cullingStats.culled, cullingStats.renderables);
+				ImGui::Text("Bounds Updates: %d, Cells Visited: %d, %.3f ms", cullingStats.boundsUpdates, cullingStats.cellsVisited, cullingStats.lastCullMs);
+
+				// Issued calls reached OpenGL, elided ones would not have changed anything
+				const GLState::Stats& stateStats = graphicSystem->GetStateStats();
+				const std::pair<const char*, const GLState::Counter*> counters[] = {
+					{ "Programs", &stateStats.programs }, { "Textures", &stateStats.textures },
+					{ "Vertex Arrays", &stateStats.vertexArrays }, { "Buffers", &stateStats.buffers },
+					{ "Blend", &stateStats.blend }, { "Uniforms", &stateStats.uniforms } };
+				for (const auto& counter : counters) {
+					ImGui::Text("%s: %d issued, %d elided", counter.first, counter.second->issued, counter.second->elided);
+				}
+			}
+
+			// Switching policy also resets the error counters
+#if ENGINE_GL_ERROR_CHECKS
+			static const char* policyNames[] = { "Off", "Every Call", "Per Frame", "Sampled", "Debug Callback" };
+			int policy = static_cast<int>(GetGLErrorPolicy());
+			int sampleInterval = static_cast<int>(GetGLErrorSampleInterval());
+			bool changed = ImGui::Combo("GL Error Checks", &policy, policyNames, IM_ARRAYSIZE(policyNames));
+			if (policy == static_cast<int>(GLErrorPolicy::Sampled)) {
+				changed |= ImGui::SliderInt("Sample Interval", &sampleInterval, 1, 1024);
+			}
+			if (changed) {
+				SetGLErrorPolicy(static_cast<GLErrorPolicy>(policy), static_cast<unsigned int>(sampleInterval));
+			}
+			const GLErrorStats& errorStats = GetGLErrorStats();
+			ImGui::Text("GL Errors: %d, Debug Messages: %d, glGetError Checks: %d", errorStats.errors, errorStats.debugMessages, errorStats.checks);
+#else
+			ImGui::Text("GL Error Checks: compiled out");
+#endif
+
+			// Sorted on synthetic keys, the frame's own commands are untouched
+			static double sortBenchmarkMs = -1.0;
+			if (ImGui::Button("Run Sort Benchmark")) {
+				sortBenchmarkMs = RenderQueue::RunBenchmark(50000, 20);
+			}
+			if (sortBenchmarkMs >= 0.0) {
+				ImGui::Text("50000 commands: %.3f ms per radix sort", sortBenchmarkMs);
+			}
+		}
+	}
+
 	void ImGuiWrapper::RenderAssetBrowser() {
 
 		auto& textures = assetManager->GetAllTextures(); //buffer
@@ -712,6 +874,9 @@ namespace Engine {
 			// Display the FPS graph
 			ImGui::PlotLines("FPS", fpsValues, FPSCount, 0, NULL, 0.0f, 240.0f, ImVec2(0, 80)); // Assuming max FPS as 240 for Y-axis bounds
 			DisplaySystemTimes();
+			DisplayPathfindingStats();
+			DisplayPhysicsStats();
+			DisplayRenderStats();
 		}
 
 		if (ImGui::CollapsingHeader("Memory Usage")) {
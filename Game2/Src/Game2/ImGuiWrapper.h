@@ -133,6 +133,21 @@ namespace Engine {
 		 */
 		void DisplaySystemTimes();
 
+		/*!
+		 * \brief Displays pathfinding statistics such as the path cache hit rate in ImGui.
+		 */
+		void DisplayPathfindingStats();
+
+		/*!
+		 * \brief Displays physics statistics such as the body count and step time in ImGui.
+		 */
+		void DisplayPhysicsStats();
+
+		/*!
+		 * \brief Displays rendering statistics such as the draw calls of the last frame in ImGui.
+		 */
+		void DisplayRenderStats();
+
 		/*!
 		 * \brief Renders the asset browser in ImGui.
 		 */
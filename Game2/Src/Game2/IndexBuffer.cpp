@@ -16,6 +16,7 @@
 #include "pch.h"
 #include "IndexBuffer.h"
 #include "Renderer.h"
+#include "GLState.h"
 #include <GLFW/glfw3.h>
 
 IndexBuffer::IndexBuffer()
@@ -33,6 +34,7 @@ IndexBuffer::~IndexBuffer()
     if (m_RendererID != 0)
     {
         // Delete OpenGL buffers if they exist
+        GLState::GetInstance().ForgetBuffer(m_RendererID);
         GLCall(glDeleteBuffers(1, &m_RendererID));
         m_RendererID = 0;
     }
@@ -50,7 +52,7 @@ void IndexBuffer::GenerateBuffer() const
         GLCall(glGenBuffers(1, &rendererID));
         const_cast<GLuint&>(m_RendererID) = rendererID;
 
-        GLCall(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID));
+        GLState::GetInstance().BindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID);
         GLCall(glBufferData(GL_ELEMENT_ARRAY_BUFFER, m_Count * sizeof(unsigned int), m_Data, GL_STATIC_DRAW));
     }
 }
@@ -58,10 +60,10 @@ void IndexBuffer::GenerateBuffer() const
 void IndexBuffer::Bind() const
 {
     // Check if the window is minimized
-    if (!glfwGetWindowAttrib(glfwGetCurrentContext(), GLFW_ICONIFIED))
+    if (!GLState::GetInstance().IsMinimized())
     {
         GenerateBuffer();  // Ensure the buffer is generated before binding
-        GLCall(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID)); // Bind the element array buffer
+        GLState::GetInstance().BindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID); // Bind the element array buffer
     }
     else
     {
@@ -73,9 +75,9 @@ void IndexBuffer::Bind() const
 void IndexBuffer::Unbind() const
 {
     // Check if the window is minimized
-    if (!glfwGetWindowAttrib(glfwGetCurrentContext(), GLFW_ICONIFIED))
+    if (!GLState::GetInstance().IsMinimized())
     {
-        GLCall(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0)); // Unbind the element array buffer
+        GLState::GetInstance().BindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0); // Unbind the element array buffer
     }
     else
     {
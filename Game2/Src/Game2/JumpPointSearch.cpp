@@ -0,0 +1,441 @@
+/******************************************************************************/
+/*!
+\file		JumpPointSearch.cpp
+\author		Ang Jun Sheng Aloysius, a.junshengaloysius, 2201807
+
+\par		a.junshengaloysius@digipen.edu
+
+\date		05/04/2024
+
+\brief		Contains the definitions of the A*, Jump Point Search and JPS+
+			grid searches.
+Copyright (C) 2024 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+ */
+ /******************************************************************************/
+
+#include "pch.h"
+#include "JumpPointSearch.h"
+
+namespace Engine
+{
+    namespace
+    {
+        const float SQRT2 = 1.41421356f;
+
+        float Octile(int x1, int y1, int x2, int y2)
+        {
+            int dx = std::abs(x2 - x1);
+            int dy = std::abs(y2 - y1);
+            return static_cast<float>(dx + dy) + (SQRT2 - 2.0f) * static_cast<float>(std::min(dx, dy));
+        }
+
+        int Sign(int value)
+        {
+            return (value > 0) - (value < 0);
+        }
+
+        // Per-thread search state, reused between queries. Generation stamps avoid
+        // clearing the arrays for every search.
+        struct SearchScratch
+        {
+            std::vector<float> gScore;
+            std::vector<int> parent;
+            std::vector<uint32_t> seen;
+            std::vector<uint32_t> closed;
+            uint32_t generation = 0;
+
+            void Prepare(size_t cellCount)
+            {
+                if (seen.size() != cellCount)
+                {
+                    gScore.assign(cellCount, 0.0f);
+                    parent.assign(cellCount, -1);
+                    seen.assign(cellCount, 0);
+                    closed.assign(cellCount, 0);
+                    generation = 0;
+                }
+                if (++generation == 0)
+                {
+                    std::fill(seen.begin(), seen.end(), 0);
+                    std::fill(closed.begin(), closed.end(), 0);
+                    generation = 1;
+                }
+            }
+        };
+
+        thread_local SearchScratch scratch;
+    }
+
+    void JumpPointSearch::SetGrid(int _width, int _height, BlockedFunction _isBlocked, unsigned int mapVersion)
+    {
+        width = _width;
+        height = _height;
+        isBlocked = std::move(_isBlocked);
+        gridVersion = mapVersion;
+    }
+
+    bool JumpPointSearch::HasForcedNeighbour(int x, int y, int dx, int dy) const
+    {
+        if (dx != 0)
+        {
+            return (Walkable(x, y - 1) && !Walkable(x - dx, y - 1)) ||
+                (Walkable(x, y + 1) && !Walkable(x - dx, y + 1));
+        }
+        return (Walkable(x - 1, y) && !Walkable(x - 1, y - dy)) ||
+            (Walkable(x + 1, y) && !Walkable(x + 1, y - dy));
+    }
+
+    void JumpPointSearch::Precompute(unsigned int mapVersion)
+    {
+        if (IsPrecomputed(mapVersion))
+        {
+            return;
+        }
+
+        auto precomputeStart = std::chrono::high_resolution_clock::now();
+        size_t cellCount = static_cast<size_t>(width) * height;
+
+        // Distances are stored as 16 bit values, maps this large use plain JPS instead
+        if (width <= 0 || height <= 0 || width > INT16_MAX - 1 || height > INT16_MAX - 1)
+        {
+            tables.reset();
+            return;
+        }
+
+        // Built into new tables, searches sharing the old ones keep reading them
+        auto built = std::make_shared<JumpTables>();
+        built->width = width;
+        built->height = height;
+        built->version = mapVersion;
+        for (auto& table : built->directions)
+        {
+            table.assign(cellCount, -1);
+        }
+        std::vector<int16_t>* jumpTables = built->directions;
+
+        // Scan every row and column against the direction of travel so each
+        // cell can extend the answer of the cell after it
+        auto fill = [&](std::vector<int16_t>& table, int x, int y, int dx, int dy)
+            {
+                int16_t& value = table[Index(x, y)];
+                if (!Walkable(x, y))
+                {
+                    value = -1;
+                    return;
+                }
+                if (HasForcedNeighbour(x, y, dx, dy))
+                {
+                    value = 0;
+                    return;
+                }
+                int nextX = x + dx;
+                int nextY = y + dy;
+                int16_t next = (nextX >= 0 && nextY >= 0 && nextX < width && nextY < height) ? table[Index(nextX, nextY)] : -1;
+                value = static_cast<int16_t>(next >= 0 ? next + 1 : next - 1);
+            };
+
+        for (int y = 0; y < height; ++y)
+        {
+            for (int x = width - 1; x >= 0; --x) fill(jumpTables[East], x, y, 1, 0);
+            for (int x = 0; x < width; ++x) fill(jumpTables[West], x, y, -1, 0);
+        }
+        for (int x = 0; x < width; ++x)
+        {
+            for (int y = height - 1; y >= 0; --y) fill(jumpTables[North], x, y, 0, 1);
+            for (int y = 0; y < height; ++y) fill(jumpTables[South], x, y, 0, -1);
+        }
+
+        tables = std::move(built);
+        stats.tableBytes = cellCount * DirectionCount * sizeof(int16_t);
+        stats.precomputeMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - precomputeStart).count();
+    }
+
+    bool JumpPointSearch::JumpStraight(int x, int y, int dx, int dy, int& outX, int& outY) const
+    {
+        while (Walkable(x, y))
+        {
+            if ((x == goalX && y == goalY) || HasForcedNeighbour(x, y, dx, dy))
+            {
+                outX = x;
+                outY = y;
+                return true;
+            }
+            x += dx;
+            y += dy;
+        }
+        return false;
+    }
+
+    bool JumpPointSearch::JumpStraightPlus(int x, int y, int dx, int dy, int& outX, int& outY) const
+    {
+        if (!Walkable(x, y))
+        {
+            return false;
+        }
+
+        Direction direction = dx > 0 ? East : dx < 0 ? West : dy > 0 ? North : South;
+        int value = tables->directions[direction][Index(x, y)];
+
+        // Stop at the goal if it lies on this ray before the jump point or wall
+        int goalSteps = -1;
+        if (dx != 0 && goalY == y && (goalX - x) * dx >= 0)
+        {
+            goalSteps = std::abs(goalX - x);
+        }
+        else if (dy != 0 && goalX == x && (goalY - y) * dy >= 0)
+        {
+            goalSteps = std::abs(goalY - y);
+        }
+
+        if (goalSteps >= 0 && (value >= 0 ? goalSteps <= value : goalSteps < -1 - value))
+        {
+            outX = goalX;
+            outY = goalY;
+            return true;
+        }
+
+        if (value < 0)
+        {
+            return false;
+        }
+        outX = x + dx * value;
+        outY = y + dy * value;
+        return true;
+    }
+
+    bool JumpPointSearch::Jump(int x, int y, int dx, int dy, bool usePlus, int& outX, int& outY) const
+    {
+        if (dx == 0 || dy == 0)
+        {
+            return usePlus ? JumpStraightPlus(x, y, dx, dy, outX, outY) : JumpStraight(x, y, dx, dy, outX, outY);
+        }
+
+        int ignoredX, ignoredY;
+        while (Walkable(x, y))
+        {
+            // A diagonal jump stops wherever one of its straight components finds something
+            bool straightHit = usePlus ?
+                (JumpStraightPlus(x + dx, y, dx, 0, ignoredX, ignoredY) || JumpStraightPlus(x, y + dy, 0, dy, ignoredX, ignoredY)) :
+                (JumpStraight(x + dx, y, dx, 0, ignoredX, ignoredY) || JumpStraight(x, y + dy, 0, dy, ignoredX, ignoredY));
+
+            if ((x == goalX && y == goalY) || straightHit)
+            {
+                outX = x;
+                outY = y;
+                return true;
+            }
+
+            // No corner cutting
+            if (!Walkable(x + dx, y) || !Walkable(x, y + dy))
+            {
+                return false;
+            }
+            x += dx;
+            y += dy;
+        }
+        return false;
+    }
+
+    void JumpPointSearch::Successors(int x, int y, int parentX, int parentY, bool jump, bool usePlus,
+        std::vector<std::pair<int, int>>& out) const
+    {
+        out.clear();
+
+        std::pair<int, int> neighbours[8];
+        int count = 0;
+        auto add = [&](int nx, int ny) { neighbours[count++] = { nx, ny }; };
+
+        if (!jump || parentX < 0)
+        {
+            // Every walkable neighbour, diagonals only when both sides are open
+            for (int dy = -1; dy <= 1; ++dy)
+            {
+                for (int dx = -1; dx <= 1; ++dx)
+                {
+                    if ((dx == 0 && dy == 0) || !Walkable(x + dx, y + dy))
+                    {
+                        continue;
+                    }
+                    if (dx != 0 && dy != 0 && (!Walkable(x + dx, y) || !Walkable(x, y + dy)))
+                    {
+                        continue;
+                    }
+                    add(x + dx, y + dy);
+                }
+            }
+        }
+        else
+        {
+            // Prune the neighbours a path through the parent would never need
+            int dx = Sign(x - parentX);
+            int dy = Sign(y - parentY);
+            if (dx != 0 && dy != 0)
+            {
+                bool openY = Walkable(x, y + dy);
+                bool openX = Walkable(x + dx, y);
+                if (openY) add(x, y + dy);
+                if (openX) add(x + dx, y);
+                if (openX && openY && Walkable(x + dx, y + dy)) add(x + dx, y + dy);
+            }
+            else if (dx != 0)
+            {
+                bool openNext = Walkable(x + dx, y);
+                bool openUp = Walkable(x, y + 1);
+                bool openDown = Walkable(x, y - 1);
+                if (openNext)
+                {
+                    add(x + dx, y);
+                    if (openUp && Walkable(x + dx, y + 1)) add(x + dx, y + 1);
+                    if (openDown && Walkable(x + dx, y - 1)) add(x + dx, y - 1);
+                }
+                if (openUp) add(x, y + 1);
+                if (openDown) add(x, y - 1);
+            }
+            else
+            {
+                bool openNext = Walkable(x, y + dy);
+                bool openRight = Walkable(x + 1, y);
+                bool openLeft = Walkable(x - 1, y);
+                if (openNext)
+                {
+                    add(x, y + dy);
+                    if (openRight && Walkable(x + 1, y + dy)) add(x + 1, y + dy);
+                    if (openLeft && Walkable(x - 1, y + dy)) add(x - 1, y + dy);
+                }
+                if (openRight) add(x + 1, y);
+                if (openLeft) add(x - 1, y);
+            }
+        }
+
+        for (int i = 0; i < count; ++i)
+        {
+            if (!jump)
+            {
+                out.push_back(neighbours[i]);
+                continue;
+            }
+
+            int jumpX, jumpY;
+            if (Jump(neighbours[i].first, neighbours[i].second, neighbours[i].first - x, neighbours[i].second - y, usePlus, jumpX, jumpY))
+            {
+                out.push_back({ jumpX, jumpY });
+            }
+        }
+    }
+
+    std::vector<std::pair<int, int>> JumpPointSearch::FindPath(int startX, int startY, int _goalX, int _goalY, Mode mode)
+    {
+        stats.lastExpanded = 0;
+        stats.lastJumpPoints = 0;
+        stats.lastPathCost = 0.0;
+
+        goalX = _goalX;
+        goalY = _goalY;
+        if (!Walkable(startX, startY) || !Walkable(goalX, goalY))
+        {
+            return {};
+        }
+
+        bool jump = mode != Mode::AStar;
+        // Tables built for another version of the map would jump through new obstacles
+        bool usePlus = mode == Mode::JumpPointPlus && IsPrecomputed(gridVersion);
+
+        scratch.Prepare(static_cast<size_t>(width) * height);
+        const uint32_t generation = scratch.generation;
+
+        using OpenEntry = std::pair<float, int>;
+        std::priority_queue<OpenEntry, std::vector<OpenEntry>, std::greater<OpenEntry>> open;
+
+        int startIndex = Index(startX, startY);
+        int goalIndex = Index(goalX, goalY);
+        scratch.gScore[startIndex] = 0.0f;
+        scratch.parent[startIndex] = -1;
+        scratch.seen[startIndex] = generation;
+        open.push({ Octile(startX, startY, goalX, goalY), startIndex });
+
+        std::vector<std::pair<int, int>> successors;
+        successors.reserve(8);
+        bool found = false;
+
+        while (!open.empty())
+        {
+            int current = open.top().second;
+            open.pop();
+            if (scratch.closed[current] == generation)
+            {
+                continue;
+            }
+            scratch.closed[current] = generation;
+            ++stats.lastExpanded;
+
+            if (current == goalIndex)
+            {
+                found = true;
+                break;
+            }
+
+            int x = current % width;
+            int y = current / width;
+            int parentX = -1;
+            int parentY = -1;
+            if (scratch.parent[current] >= 0)
+            {
+                parentX = scratch.parent[current] % width;
+                parentY = scratch.parent[current] / width;
+            }
+
+            Successors(x, y, parentX, parentY, jump, usePlus, successors);
+            for (const auto& next : successors)
+            {
+                int nextIndex = Index(next.first, next.second);
+                if (scratch.closed[nextIndex] == generation)
+                {
+                    continue;
+                }
+
+                float newCost = scratch.gScore[current] + Octile(x, y, next.first, next.second);
+                if (scratch.seen[nextIndex] != generation || newCost < scratch.gScore[nextIndex])
+                {
+                    scratch.seen[nextIndex] = generation;
+                    scratch.gScore[nextIndex] = newCost;
+                    scratch.parent[nextIndex] = current;
+                    open.push({ newCost + Octile(next.first, next.second, goalX, goalY), nextIndex });
+                }
+            }
+        }
+
+        if (!found)
+        {
+            return {};
+        }
+
+        std::vector<std::pair<int, int>> waypoints;
+        for (int index = goalIndex; index >= 0; index = scratch.parent[index])
+        {
+            waypoints.push_back({ index % width, index / width });
+        }
+        std::reverse(waypoints.begin(), waypoints.end());
+        stats.lastJumpPoints = static_cast<int>(waypoints.size());
+        stats.lastPathCost = scratch.gScore[goalIndex];
+
+        // Jump points are joined by straight or diagonal runs, expand them into single steps
+        std::vector<std::pair<int, int>> path = { waypoints.front() };
+        for (size_t i = 1; i < waypoints.size(); ++i)
+        {
+            int x = waypoints[i - 1].first;
+            int y = waypoints[i - 1].second;
+            int dx = Sign(waypoints[i].first - x);
+            int dy = Sign(waypoints[i].second - y);
+            while (x != waypoints[i].first || y != waypoints[i].second)
+            {
+                x += dx;
+                y += dy;
+                path.push_back({ x, y });
+            }
+        }
+        return path;
+    }
+}
@@ -0,0 +1,177 @@
+/******************************************************************************/
+/*!
+\file		JumpPointSearch.h
+\author		Ang Jun Sheng Aloysius, a.junshengaloysius, 2201807
+
+\par		a.junshengaloysius@digipen.edu
+
+\date		05/04/2024
+
+\brief		Contains the declaration of the 8-connected grid searches used on the
+			uniform-cost navigation map: plain A*, Jump Point Search, and JPS+
+			which reads straight jump distances from tables precomputed once
+			per navigation map version. Diagonal moves never cut corners, and
+			all three modes return paths of the same optimal length.
+Copyright (C) 2024 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+ */
+ /******************************************************************************/
+#ifndef ENGINE_JUMPPOINTSEARCH_H
+#define ENGINE_JUMPPOINTSEARCH_H
+
+#include <vector>
+#include <memory>
+#include <functional>
+#include <utility>
+#include <cstdint>
+
+namespace Engine
+{
+    class JumpPointSearch
+    {
+    public:
+        // Returns true if the grid cell at (x, y) cannot be walked through
+        using BlockedFunction = std::function<bool(int, int)>;
+
+        enum class Mode { AStar, JumpPoint, JumpPointPlus };
+
+        /*!
+        \brief Counters describing the last query and the precomputed tables.
+        */
+        struct Stats
+        {
+            int lastExpanded = 0;       // Nodes popped from the open list by the last query
+            int lastJumpPoints = 0;     // Waypoints before the path was expanded into steps
+            double lastPathCost = 0.0;  // Octile length of the last path
+            double precomputeMs = 0.0;
+            size_t tableBytes = 0;
+        };
+
+        // JPS+ straight jump distances of one map version. Read-only once built, so
+        // searches on other threads can share them
+        struct JumpTables
+        {
+            int width = 0;
+            int height = 0;
+            unsigned int version = 0;
+            // East, West, North, South. For every cell: steps to the first forced
+            // neighbour if >= 0, otherwise -1 - (number of walkable cells before a wall)
+            std::vector<int16_t> directions[4];
+        };
+
+        /**************************************************************************/
+        /*!
+        \brief Sets the grid the searches run on.
+
+        \param[in] width
+        The width of the navigation grid in cells.
+
+        \param[in] height
+        The height of the navigation grid in cells.
+
+        \param[in] isBlocked
+        Query used to test whether a grid cell is an obstacle.
+
+        \param[in] mapVersion
+        The navigation map version isBlocked describes. JPS+ queries only use
+        tables precomputed for this version.
+        */
+        /**************************************************************************/
+        void SetGrid(int width, int height, BlockedFunction isBlocked, unsigned int mapVersion);
+
+        /**************************************************************************/
+        /*!
+        \brief Builds the JPS+ straight jump tables. Does nothing if the tables were
+        already built for the given navigation map version.
+
+        \param[in] mapVersion
+        The current navigation map version.
+        */
+        /**************************************************************************/
+        void Precompute(unsigned int mapVersion);
+
+        /*!
+        \brief Checks if the JPS+ tables are current for a map version.
+        \param[in] mapVersion The current navigation map version.
+        \return True if Precompute has run for that version.
+        */
+        bool IsPrecomputed(unsigned int mapVersion) const
+        {
+            return tables && tables->version == mapVersion && tables->width == width && tables->height == height;
+        }
+
+        /*!
+        \brief Gets the JPS+ tables built by the last Precompute.
+        \return The tables, or null if none were built.
+        */
+        std::shared_ptr<const JumpTables> GetTables() const { return tables; }
+
+        /*!
+        \brief Uses JPS+ tables built by another search on the same grid instead of
+        precomputing them again. They are only read if their version matches the grid.
+        \param[in] sharedTables The tables to use.
+        */
+        void SetTables(std::shared_ptr<const JumpTables> sharedTables) { tables = std::move(sharedTables); }
+
+        /**************************************************************************/
+        /*!
+        \brief Finds an optimal 8-connected path between two grid cells.
+
+        \param[in] startX, startY
+        The start cell.
+
+        \param[in] goalX, goalY
+        The goal cell.
+
+        \param[in] mode
+        The search to run. JumpPointPlus falls back to JumpPoint if the tables
+        have not been precomputed for the version of the grid.
+
+        \return
+        Every grid cell stepped through from start to goal, or an empty vector if
+        no path exists.
+        */
+        /**************************************************************************/
+        std::vector<std::pair<int, int>> FindPath(int startX, int startY, int goalX, int goalY, Mode mode);
+
+        /*!
+        \brief Gets the statistics of the last query and the tables.
+        \return The statistics.
+        */
+        const Stats& GetStats() const { return stats; }
+
+    private:
+        enum Direction { East, West, North, South, DirectionCount };
+
+        bool Walkable(int x, int y) const
+        {
+            return x >= 0 && y >= 0 && x < width && y < height && !isBlocked(x, y);
+        }
+
+        int Index(int x, int y) const { return y * width + x; }
+
+        // True if a straight move in (dx, dy) arriving at (x, y) has a forced neighbour there
+        bool HasForcedNeighbour(int x, int y, int dx, int dy) const;
+
+        bool JumpStraight(int x, int y, int dx, int dy, int& outX, int& outY) const;
+        bool JumpStraightPlus(int x, int y, int dx, int dy, int& outX, int& outY) const;
+        bool Jump(int x, int y, int dx, int dy, bool usePlus, int& outX, int& outY) const;
+
+        void Successors(int x, int y, int parentX, int parentY, bool jump, bool usePlus,
+            std::vector<std::pair<int, int>>& out) const;
+
+        int width = 0;
+        int height = 0;
+        int goalX = 0;
+        int goalY = 0;
+        BlockedFunction isBlocked;
+
+        std::shared_ptr<const JumpTables> tables;
+        unsigned int gridVersion = 0;       // Version given to the last SetGrid
+
+        Stats stats;
+    };
+}
+#endif ENGINE_JUMPPOINTSEARCH_H
@@ -0,0 +1,132 @@
+/******************************************************************************/
+/*!
+\file		OccupancyGrid.cpp
+\author		Ang Jun Sheng Aloysius, a.junshengaloysius, 2201807
+
+\par		a.junshengaloysius@digipen.edu
+
+\date		10/04/2024
+
+\brief		Contains the definitions of the bit-packed occupancy grid.
+Copyright (C) 2024 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+ */
+ /******************************************************************************/
+
+#include "pch.h"
+#include "OccupancyGrid.h"
+#include <bit>
+
+namespace Engine
+{
+    void OccupancyGrid::Resize(int _width, int _height)
+    {
+        width = std::max(_width, 0);
+        height = std::max(_height, 0);
+        wordsPerRow = (width + 63) / 64;
+        words.assign(static_cast<size_t>(wordsPerRow) * height, 0);
+    }
+
+    void OccupancyGrid::Clear()
+    {
+        std::fill(words.begin(), words.end(), 0);
+    }
+
+    void OccupancyGrid::Set(int x, int y, bool blocked)
+    {
+        if (x < 0 || y < 0 || x >= width || y >= height)
+        {
+            return;
+        }
+
+        uint64_t& word = words[static_cast<size_t>(y) * wordsPerRow + (x >> 6)];
+        uint64_t bit = 1ull << (x & 63);
+        word = blocked ? (word | bit) : (word & ~bit);
+    }
+
+    void OccupancyGrid::FillRect(int minX, int minY, int maxX, int maxY, bool blocked)
+    {
+        minX = std::max(minX, 0);
+        minY = std::max(minY, 0);
+        maxX = std::min(maxX, width - 1);
+        maxY = std::min(maxY, height - 1);
+        if (minX > maxX || minY > maxY)
+        {
+            return;
+        }
+
+        int firstWord = minX >> 6;
+        int lastWord = maxX >> 6;
+        for (int y = minY; y <= maxY; ++y)
+        {
+            uint64_t* row = &words[static_cast<size_t>(y) * wordsPerRow];
+            for (int w = firstWord; w <= lastWord; ++w)
+            {
+                uint64_t mask = SpanMask(w == firstWord ? (minX & 63) : 0, w == lastWord ? (maxX & 63) : 63);
+                row[w] = blocked ? (row[w] | mask) : (row[w] & ~mask);
+            }
+        }
+    }
+
+    int OccupancyGrid::FirstBlockedInSpan(int y, int minX, int maxX) const
+    {
+        if (minX > maxX)
+        {
+            return -1;
+        }
+        if (y < 0 || y >= height || minX < 0 || minX >= width)
+        {
+            return minX;
+        }
+
+        // Past the right edge counts as blocked from the first cell outside
+        int clippedMaxX = std::min(maxX, width - 1);
+        int firstWord = minX >> 6;
+        int lastWord = clippedMaxX >> 6;
+        const uint64_t* row = &words[static_cast<size_t>(y) * wordsPerRow];
+        for (int w = firstWord; w <= lastWord; ++w)
+        {
+            uint64_t bits = row[w] & SpanMask(w == firstWord ? (minX & 63) : 0, w == lastWord ? (clippedMaxX & 63) : 63);
+            if (bits != 0)
+            {
+                return (w << 6) + std::countr_zero(bits);
+            }
+        }
+        return maxX > clippedMaxX ? width : -1;
+    }
+
+    bool OccupancyGrid::IsRectFree(int minX, int minY, int maxX, int maxY) const
+    {
+        for (int y = minY; y <= maxY; ++y)
+        {
+            if (!IsSpanFree(y, minX, maxX))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool OccupancyGrid::HasLineOfSight(int x0, int y0, int x1, int y1) const
+    {
+        // Rows are tested a word at a time
+        if (y0 == y1)
+        {
+            return IsSpanFree(y0, std::min(x0, x1), std::max(x0, x1));
+        }
+
+        return LineOfSight(x0, y0, x1, y1, [this](int x, int y) { return IsBlocked(x, y); });
+    }
+
+    size_t OccupancyGrid::CountBlocked() const
+    {
+        size_t count = 0;
+        for (uint64_t word : words)
+        {
+            count += std::popcount(word);
+        }
+        return count;
+    }
+}
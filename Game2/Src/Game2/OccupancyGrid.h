@@ -0,0 +1,235 @@
+/******************************************************************************/
+/*!
+\file		OccupancyGrid.h
+\author		Ang Jun Sheng Aloysius, a.junshengaloysius, 2201807
+
+\par		a.junshengaloysius@digipen.edu
+
+\date		10/04/2024
+
+\brief		Contains the declaration of the bit-packed occupancy grid used as
+			the navigation collision map. Every cell is one bit, rows are
+			stored contiguously and padded to 64 bit words so spans and
+			rectangles can be filled and tested a word at a time.
+Copyright (C) 2024 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+ */
+ /******************************************************************************/
+#ifndef ENGINE_OCCUPANCYGRID_H
+#define ENGINE_OCCUPANCYGRID_H
+
+#include <vector>
+#include <cstdint>
+
+namespace Engine
+{
+    class OccupancyGrid
+    {
+    public:
+        /**************************************************************************/
+        /*!
+        \brief Resizes the grid and marks every cell free.
+
+        \param[in] width
+        The width of the grid in cells.
+
+        \param[in] height
+        The height of the grid in cells.
+        */
+        /**************************************************************************/
+        void Resize(int width, int height);
+
+        /*!
+        \brief Marks every cell free without changing the size.
+        */
+        void Clear();
+
+        /*!
+        \brief Checks if a cell is blocked. Cells outside the grid are blocked.
+        \param[in] x, y The cell to test.
+        \return True if the cell is blocked.
+        */
+        bool IsBlocked(int x, int y) const
+        {
+            if (x < 0 || y < 0 || x >= width || y >= height)
+            {
+                return true;
+            }
+            return (words[static_cast<size_t>(y) * wordsPerRow + (x >> 6)] >> (x & 63)) & 1ull;
+        }
+
+        /*!
+        \brief Marks a single cell. Cells outside the grid are ignored.
+        \param[in] x, y The cell to mark.
+        \param[in] blocked True to block the cell, false to free it.
+        */
+        void Set(int x, int y, bool blocked);
+
+        /**************************************************************************/
+        /*!
+        \brief Marks every cell in a rectangle. The rectangle is clipped to the grid.
+
+        \param[in] minX, minY
+        The inclusive lower corner.
+
+        \param[in] maxX, maxY
+        The inclusive upper corner. Nothing is marked if it is below the lower corner.
+
+        \param[in] blocked
+        True to block the cells, false to free them.
+        */
+        /**************************************************************************/
+        void FillRect(int minX, int minY, int maxX, int maxY, bool blocked);
+
+        /**************************************************************************/
+        /*!
+        \brief Finds the first blocked cell of a horizontal span.
+
+        \param[in] y
+        The row of the span.
+
+        \param[in] minX, maxX
+        The inclusive ends of the span.
+
+        \return
+        The x of the first blocked cell, or -1 if the whole span is free. Spans
+        leaving the grid are blocked where they leave it.
+        */
+        /**************************************************************************/
+        int FirstBlockedInSpan(int y, int minX, int maxX) const;
+
+        /*!
+        \brief Checks if every cell of a horizontal span is free.
+        \param[in] y The row of the span.
+        \param[in] minX, maxX The inclusive ends of the span.
+        \return True if no cell of the span is blocked.
+        */
+        bool IsSpanFree(int y, int minX, int maxX) const { return FirstBlockedInSpan(y, minX, maxX) < 0; }
+
+        /*!
+        \brief Checks if every cell of a rectangle is free.
+        \param[in] minX, minY The inclusive lower corner.
+        \param[in] maxX, maxY The inclusive upper corner.
+        \return True if no cell of the rectangle is blocked.
+        */
+        bool IsRectFree(int minX, int minY, int maxX, int maxY) const;
+
+        /**************************************************************************/
+        /*!
+        \brief Checks if the straight segment between two cell centres only passes
+        through free cells. Every cell the segment touches is tested, and a
+        segment passing exactly through a cell corner needs both cells beside
+        the corner free, so a clear line never cuts a corner.
+
+        \param[in] x0, y0
+        The first cell.
+
+        \param[in] x1, y1
+        The second cell.
+
+        \return
+        True if the line is clear.
+        */
+        /**************************************************************************/
+        bool HasLineOfSight(int x0, int y0, int x1, int y1) const;
+
+        /**************************************************************************/
+        /*!
+        \brief The supercover walk behind HasLineOfSight, for any blocked test.
+
+        \param[in] x0, y0
+        The first cell.
+
+        \param[in] x1, y1
+        The second cell.
+
+        \param[in] isBlocked
+        Callable returning true if the cell at (x, y) cannot be crossed.
+
+        \return
+        True if the line is clear.
+        */
+        /**************************************************************************/
+        template <typename BlockedFunction>
+        static bool LineOfSight(int x0, int y0, int x1, int y1, BlockedFunction isBlocked)
+        {
+            int dx = x1 > x0 ? x1 - x0 : x0 - x1;
+            int dy = y1 > y0 ? y1 - y0 : y0 - y1;
+            int stepX = x1 > x0 ? 1 : -1;
+            int stepY = y1 > y0 ? 1 : -1;
+            int x = x0;
+            int y = y0;
+            if (isBlocked(x, y))
+            {
+                return false;
+            }
+
+            // Error tracks which cell border the segment crosses next
+            int error = dx - dy;
+            dx *= 2;
+            dy *= 2;
+            for (int remaining = (dx + dy) / 2; remaining > 0; --remaining)
+            {
+                if (error > 0)
+                {
+                    x += stepX;
+                    error -= dy;
+                }
+                else if (error < 0)
+                {
+                    y += stepY;
+                    error += dx;
+                }
+                else
+                {
+                    // Through a corner, both cells beside it must be free
+                    if (isBlocked(x + stepX, y) || isBlocked(x, y + stepY))
+                    {
+                        return false;
+                    }
+                    x += stepX;
+                    y += stepY;
+                    error += dx - dy;
+                    --remaining;
+                }
+
+                if (isBlocked(x, y))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        /*!
+        \brief Counts the blocked cells.
+        \return The number of blocked cells.
+        */
+        size_t CountBlocked() const;
+
+        int GetWidth() const { return width; }
+        int GetHeight() const { return height; }
+
+        /*!
+        \brief Gets the memory used by the cell storage.
+        \return The size in bytes.
+        */
+        size_t GetMemoryBytes() const { return words.capacity() * sizeof(uint64_t); }
+
+    private:
+        // Bits lo to hi inclusive of a word
+        static uint64_t SpanMask(int lo, int hi)
+        {
+            uint64_t upper = hi >= 63 ? ~0ull : ((1ull << (hi + 1)) - 1);
+            return upper & ~((1ull << lo) - 1);
+        }
+
+        int width = 0;
+        int height = 0;
+        int wordsPerRow = 0;
+        std::vector<uint64_t> words; // Row-major, bit x & 63 of word x >> 6 is cell x
+    };
+}
+#endif ENGINE_OCCUPANCYGRID_H
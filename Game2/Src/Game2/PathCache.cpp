@@ -0,0 +1,159 @@
+/******************************************************************************/
+/*!
+\file		PathCache.cpp
+\author		Ang Jun Sheng Aloysius, a.junshengaloysius, 2201807
+
+\par		a.junshengaloysius@digipen.edu
+
+\date		28/03/2024
+
+\brief		Contains the definitions of the LRU path cache used by the
+			pathfinding system.
+Copyright (C) 2024 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+ */
+ /******************************************************************************/
+
+#include "pch.h"
+#include "PathCache.h"
+
+namespace Engine
+{
+    namespace
+    {
+        // Floor division so that negative coordinates quantize consistently
+        int QuantizeCoord(int value, int cellSize)
+        {
+            return value >= 0 ? value / cellSize : (value - cellSize + 1) / cellSize;
+        }
+    }
+
+    size_t PathCache::KeyHash::operator()(const Key& key) const
+    {
+        size_t hash = std::hash<int>()(key.startCellX);
+        hash ^= std::hash<int>()(key.startCellY) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        hash ^= std::hash<int>()(key.goalX) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        hash ^= std::hash<int>()(key.goalY) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        hash ^= std::hash<int>()(key.clearance) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        return hash;
+    }
+
+    PathCache::PathCache(size_t _capacity, int _cellSize)
+        : capacity(_capacity > 0 ? _capacity : 1), cellSize(_cellSize > 0 ? _cellSize : 1)
+    {
+    }
+
+    PathCache::Key PathCache::MakeKey(int startX, int startY, int goalX, int goalY, int clearance) const
+    {
+        return { QuantizeCoord(startX, cellSize), QuantizeCoord(startY, cellSize), goalX, goalY, clearance };
+    }
+
+    size_t PathCache::EntryBytes(const Entry& entry)
+    {
+        // Path storage plus the list node and the lookup bucket entry
+        return entry.path.capacity() * sizeof(std::pair<int, int>) + sizeof(Entry) +
+            sizeof(Key) + sizeof(std::list<Entry>::iterator) + 4 * sizeof(void*);
+    }
+
+    void PathCache::Erase(std::list<Entry>::iterator it)
+    {
+        stats.memoryBytes -= EntryBytes(*it);
+        lookup.erase(it->key);
+        entries.erase(it);
+        stats.entries = entries.size();
+    }
+
+    bool PathCache::Find(int startX, int startY, int goalX, int goalY, unsigned int mapVersion,
+        std::vector<std::pair<int, int>>& outPath, int clearance)
+    {
+        auto found = lookup.find(MakeKey(startX, startY, goalX, goalY, clearance));
+        if (found == lookup.end())
+        {
+            ++stats.misses;
+            return false;
+        }
+
+        // Computed against an older map, the path may walk through new obstacles
+        if (found->second->mapVersion != mapVersion)
+        {
+            Erase(found->second);
+            ++stats.staleEvictions;
+            ++stats.misses;
+            return false;
+        }
+
+        // Move to the front of the LRU list
+        entries.splice(entries.begin(), entries, found->second);
+        outPath = found->second->path;
+        ++stats.hits;
+        return true;
+    }
+
+    void PathCache::Insert(int startX, int startY, int goalX, int goalY, unsigned int mapVersion,
+        const std::vector<std::pair<int, int>>& path, int clearance)
+    {
+        Key key = MakeKey(startX, startY, goalX, goalY, clearance);
+
+        auto found = lookup.find(key);
+        if (found != lookup.end())
+        {
+            Erase(found->second);
+        }
+
+        entries.push_front({ key, mapVersion, path });
+        lookup[key] = entries.begin();
+        stats.memoryBytes += EntryBytes(entries.front());
+
+        while (entries.size() > capacity)
+        {
+            Erase(std::prev(entries.end()));
+            ++stats.capacityEvictions;
+        }
+        stats.entries = entries.size();
+    }
+
+    size_t PathCache::PurgeStale(unsigned int mapVersion)
+    {
+        size_t removed = 0;
+        for (auto it = entries.begin(); it != entries.end();)
+        {
+            auto next = std::next(it);
+            if (it->mapVersion != mapVersion)
+            {
+                Erase(it);
+                ++removed;
+            }
+            it = next;
+        }
+        stats.staleEvictions += removed;
+        return removed;
+    }
+
+    void PathCache::Clear()
+    {
+        entries.clear();
+        lookup.clear();
+        stats.entries = 0;
+        stats.memoryBytes = 0;
+    }
+
+    void PathCache::SetCapacity(size_t _capacity)
+    {
+        capacity = _capacity > 0 ? _capacity : 1;
+        while (entries.size() > capacity)
+        {
+            Erase(std::prev(entries.end()));
+            ++stats.capacityEvictions;
+        }
+    }
+
+    void PathCache::ResetStats()
+    {
+        stats.hits = 0;
+        stats.misses = 0;
+        stats.staleEvictions = 0;
+        stats.capacityEvictions = 0;
+    }
+}
@@ -0,0 +1,199 @@
+/******************************************************************************/
+/*!
+\file		PathCache.h
+\author		Ang Jun Sheng Aloysius, a.junshengaloysius, 2201807
+
+\par		a.junshengaloysius@digipen.edu
+
+\date		28/03/2024
+
+\brief		Contains the declaration of the LRU cache of computed paths used by
+			the pathfinding system. Entries are keyed by quantized start cell and
+			goal, and tagged with the navigation map version they were computed
+			against so that a map change only invalidates stale entries.
+Copyright (C) 2024 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+ */
+ /******************************************************************************/
+#ifndef ENGINE_PATHCACHE_H
+#define ENGINE_PATHCACHE_H
+
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+namespace Engine
+{
+    class PathCache
+    {
+    public:
+        /*!
+        \brief Running counters describing how well the cache is performing.
+        */
+        struct Stats
+        {
+            unsigned long long hits = 0;
+            unsigned long long misses = 0;
+            unsigned long long staleEvictions = 0;    // Entries dropped because the map changed
+            unsigned long long capacityEvictions = 0; // Entries dropped by the LRU policy
+            size_t entries = 0;
+            size_t memoryBytes = 0;
+
+            /*!
+            \brief Fraction of lookups that were served from the cache.
+            \return Hit rate in the range [0, 1].
+            */
+            double HitRate() const
+            {
+                unsigned long long total = hits + misses;
+                return total ? static_cast<double>(hits) / static_cast<double>(total) : 0.0;
+            }
+        };
+
+        /**************************************************************************/
+        /*!
+        \brief Constructor for the path cache.
+
+        \param[in] capacity
+        The maximum number of paths kept before the least recently used one is evicted.
+
+        \param[in] cellSize
+        Size in pixels of the cell the start position is quantized to.
+        */
+        /**************************************************************************/
+        explicit PathCache(size_t capacity = 256, int cellSize = 16);
+
+        /**************************************************************************/
+        /*!
+        \brief Looks up a path for the given query.
+
+        \param[in] startX, startY
+        The start position of the query.
+
+        \param[in] goalX, goalY
+        The goal position of the query.
+
+        \param[in] mapVersion
+        The current navigation map version. Entries computed against an older
+        version are evicted instead of returned.
+
+        \param[out] outPath
+        Receives a copy of the cached path on a hit.
+
+        \param[in] clearance
+        The radius in cells of the unit asking. Paths for wider units are kept apart.
+
+        \return
+        True on a hit, false on a miss.
+        */
+        /**************************************************************************/
+        bool Find(int startX, int startY, int goalX, int goalY, unsigned int mapVersion,
+            std::vector<std::pair<int, int>>& outPath, int clearance = 0);
+
+        /**************************************************************************/
+        /*!
+        \brief Stores a computed path, evicting the least recently used entry if full.
+
+        \param[in] startX, startY
+        The start position the path was computed from.
+
+        \param[in] goalX, goalY
+        The goal position the path was computed to.
+
+        \param[in] mapVersion
+        The navigation map version the path was computed against.
+
+        \param[in] path
+        The computed path. Empty paths are cached as well so failed queries are
+        not repeated.
+
+        \param[in] clearance
+        The radius in cells of the unit the path was computed for.
+        */
+        /**************************************************************************/
+        void Insert(int startX, int startY, int goalX, int goalY, unsigned int mapVersion,
+            const std::vector<std::pair<int, int>>& path, int clearance = 0);
+
+        /**************************************************************************/
+        /*!
+        \brief Drops every entry that was not computed against the given version.
+
+        \param[in] mapVersion
+        The current navigation map version.
+
+        \return
+        The number of entries removed.
+        */
+        /**************************************************************************/
+        size_t PurgeStale(unsigned int mapVersion);
+
+        /*!
+        \brief Removes all entries. Statistics are kept.
+        */
+        void Clear();
+
+        /*!
+        \brief Changes the maximum number of entries, evicting as needed.
+        \param[in] capacity The new capacity.
+        */
+        void SetCapacity(size_t capacity);
+
+        /*!
+        \brief Gets the cache statistics.
+        \return The running statistics.
+        */
+        const Stats& GetStats() const { return stats; }
+
+        /*!
+        \brief Resets the hit, miss and eviction counters.
+        */
+        void ResetStats();
+
+        /*!
+        \brief Gets the size of the cell the start position is quantized to.
+        \return The cell size in pixels.
+        */
+        int GetCellSize() const { return cellSize; }
+
+    private:
+        struct Key
+        {
+            int startCellX, startCellY;
+            int goalX, goalY;
+            int clearance;
+
+            bool operator==(const Key& other) const
+            {
+                return startCellX == other.startCellX && startCellY == other.startCellY &&
+                    goalX == other.goalX && goalY == other.goalY && clearance == other.clearance;
+            }
+        };
+
+        struct KeyHash
+        {
+            size_t operator()(const Key& key) const;
+        };
+
+        struct Entry
+        {
+            Key key;
+            unsigned int mapVersion;
+            std::vector<std::pair<int, int>> path;
+        };
+
+        Key MakeKey(int startX, int startY, int goalX, int goalY, int clearance) const;
+        static size_t EntryBytes(const Entry& entry);
+        void Erase(std::list<Entry>::iterator it);
+
+        // Most recently used entries are kept at the front
+        std::list<Entry> entries;
+        std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> lookup;
+        size_t capacity;
+        int cellSize;
+        Stats stats;
+    };
+}
+#endif ENGINE_PATHCACHE_H
@@ -0,0 +1,384 @@
+/******************************************************************************/
+/*!
+\file		PathRequestQueue.cpp
+\author		Ang Jun Sheng Aloysius, a.junshengaloysius, 2201807
+
+\par		a.junshengaloysius@digipen.edu
+
+\date		08/04/2024
+
+\brief		Contains the definitions of the asynchronous path request queue.
+Copyright (C) 2024 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+ */
+ /******************************************************************************/
+
+#include "pch.h"
+#include "PathRequestQueue.h"
+#include "HierarchicalPathfinder.h"
+#include "PathSmoothing.h"
+
+namespace Engine
+{
+    namespace
+    {
+        // Same cluster size as the pathfinder used on the main thread
+        const int HIERARCHICAL_CLUSTER_SIZE = 32;
+    }
+
+    size_t PathRequestQueue::KeyHash::operator()(const Key& key) const
+    {
+        size_t hash = std::hash<int>()(key.startX);
+        hash ^= std::hash<int>()(key.startY) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        hash ^= std::hash<int>()(key.goalX) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        hash ^= std::hash<int>()(key.goalY) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        hash ^= std::hash<int>()(key.clearance) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        hash ^= std::hash<int>()(static_cast<int>(key.mode)) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        return hash;
+    }
+
+    PathRequestQueue::PathRequestQueue(int _workerCount)
+        : workerCount(_workerCount)
+    {
+        if (workerCount <= 0)
+        {
+            // Leave a core for the main thread
+            int hardwareThreads = static_cast<int>(std::thread::hardware_concurrency());
+            workerCount = std::clamp(hardwareThreads - 1, 1, 4);
+        }
+    }
+
+    PathRequestQueue::~PathRequestQueue()
+    {
+        Shutdown();
+    }
+
+    void PathRequestQueue::StartWorkers()
+    {
+        stopping = false;
+        for (int i = 0; i < workerCount; ++i)
+        {
+            workers.emplace_back(&PathRequestQueue::WorkerLoop, this);
+        }
+        stats.workers = workerCount;
+    }
+
+    void PathRequestQueue::Shutdown()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto& worker : workers)
+        {
+            worker.join();
+        }
+        workers.clear();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        queue.clear();
+        jobsByKey.clear();
+        jobsByTicket.clear();
+        outstanding.clear();
+        finished.clear();
+        collected.clear();
+        stats.workers = 0;
+    }
+
+    void PathRequestQueue::SetNavGrid(const OccupancyGrid& cells, std::shared_ptr<const DistanceField> field, unsigned int mapVersion)
+    {
+        // Copy outside the lock so the workers are not held up
+        auto grid = std::make_shared<NavGrid>();
+        grid->cells = cells;
+        grid->field = std::move(field);
+        grid->version = mapVersion;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        navGrid = std::move(grid);
+        navVersion = mapVersion;
+    }
+
+    PathRequestQueue::RequestID PathRequestQueue::Submit(int startX, int startY, int goalX, int goalY, int priority, int clearance, SearchMode mode)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (workers.empty())
+        {
+            StartWorkers();
+        }
+
+        RequestID id = nextID++;
+        outstanding.insert(id);
+        ++stats.submitted;
+
+        Key key = { startX, startY, goalX, goalY, clearance, mode };
+        auto found = jobsByKey.find(key);
+        if (found != jobsByKey.end())
+        {
+            // Share the search already queued or running for the same query
+            std::shared_ptr<Job> job = found->second;
+            job->tickets.push_back(id);
+            jobsByTicket[id] = job;
+            ++stats.coalesced;
+
+            // A higher priority submission moves the shared search forward
+            if (!job->started)
+            {
+                queue.push_back({ priority, nextSequence++, job });
+                std::push_heap(queue.begin(), queue.end());
+            }
+            return id;
+        }
+
+        auto job = std::make_shared<Job>();
+        job->key = key;
+        job->width = navGrid ? navGrid->cells.GetWidth() : 0;
+        job->height = navGrid ? navGrid->cells.GetHeight() : 0;
+        job->tickets.push_back(id);
+        jobsByKey[key] = job;
+        jobsByTicket[id] = job;
+
+        queue.push_back({ priority, nextSequence++, job });
+        std::push_heap(queue.begin(), queue.end());
+
+        lock.unlock();
+        wake.notify_one();
+        return id;
+    }
+
+    void PathRequestQueue::CancelLocked(RequestID id)
+    {
+        if (outstanding.erase(id) == 0)
+        {
+            return;
+        }
+        ++stats.cancelled;
+
+        auto found = jobsByTicket.find(id);
+        if (found == jobsByTicket.end())
+        {
+            return;
+        }
+
+        std::shared_ptr<Job> job = found->second;
+        jobsByTicket.erase(found);
+        job->tickets.erase(std::remove(job->tickets.begin(), job->tickets.end(), id), job->tickets.end());
+
+        // Nobody is waiting on it any more, the worker skips it when popped
+        if (job->tickets.empty() && !job->started)
+        {
+            jobsByKey.erase(job->key);
+        }
+    }
+
+    void PathRequestQueue::Cancel(RequestID id)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        CancelLocked(id);
+        collected.erase(id);
+    }
+
+    void PathRequestQueue::CancelAllExcept(const std::unordered_set<RequestID>& liveIDs)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::vector<RequestID> orphans;
+        for (RequestID id : outstanding)
+        {
+            if (liveIDs.find(id) == liveIDs.end())
+            {
+                orphans.push_back(id);
+            }
+        }
+        for (RequestID id : orphans)
+        {
+            CancelLocked(id);
+            collected.erase(id);
+        }
+    }
+
+    void PathRequestQueue::CollectResults(double budgetMs)
+    {
+        auto collectStart = std::chrono::high_resolution_clock::now();
+        int count = 0;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        while (!finished.empty())
+        {
+            Result result = std::move(finished.front());
+            finished.pop_front();
+
+            // Skip tickets cancelled while the search was running
+            if (outstanding.find(result.id) != outstanding.end())
+            {
+                if (result.version != navVersion)
+                {
+                    result.valid = false;
+                    ++stats.stale;
+                }
+                collected[result.id] = std::move(result);
+                ++count;
+            }
+
+            double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - collectStart).count();
+            if (elapsedMs >= budgetMs)
+            {
+                break;
+            }
+        }
+
+        stats.lastCollected = count;
+        stats.lastCollectMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - collectStart).count();
+    }
+
+    PathRequestQueue::Status PathRequestQueue::TakeResult(RequestID id, Path& outPath)
+    {
+        auto found = collected.find(id);
+        if (found == collected.end())
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            return outstanding.find(id) != outstanding.end() ? Status::Pending : Status::Failed;
+        }
+
+        Result result = std::move(found->second);
+        collected.erase(found);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            outstanding.erase(id);
+        }
+
+        if (!result.valid)
+        {
+            return Status::Failed;
+        }
+        outPath = *result.path;
+        return Status::Ready;
+    }
+
+    void PathRequestQueue::WorkerLoop()
+    {
+        // Each worker keeps its own search state, only the grid snapshot is shared
+        JumpPointSearch search;
+        JumpPointSearch wideSearch;
+        std::shared_ptr<const NavGrid> searchGrid;
+        HierarchicalPathfinder hierarchical(HIERARCHICAL_CLUSTER_SIZE);
+        std::shared_ptr<const NavGrid> hierarchicalGrid;
+
+        while (true)
+        {
+            std::shared_ptr<Job> job;
+            std::shared_ptr<const NavGrid> grid;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [this] { return stopping || !queue.empty(); });
+                if (stopping)
+                {
+                    return;
+                }
+
+                std::pop_heap(queue.begin(), queue.end());
+                job = std::move(queue.back().job);
+                queue.pop_back();
+
+                // Already taken by another worker through a duplicate entry, or cancelled
+                if (job->started || job->tickets.empty())
+                {
+                    continue;
+                }
+                job->started = true;
+                grid = navGrid;
+            }
+
+            auto searchStart = std::chrono::high_resolution_clock::now();
+            auto path = std::make_shared<Path>();
+            bool valid = grid && grid->cells.GetWidth() == job->width && grid->cells.GetHeight() == job->height;
+            if (valid)
+            {
+                const Key& key = job->key;
+                if (key.clearance > 0 && grid->field)
+                {
+                    // Wide units search the cells they fit on
+                    const DistanceField* field = grid->field.get();
+                    wideSearch.SetGrid(field->GetWidth(), field->GetHeight(), [field, key](int x, int y)
+                        {
+                            return field->BlocksUnit(x, y, key.clearance, key.startX, key.startY, key.goalX, key.goalY);
+                        }, grid->version);
+                    *path = SmoothPath(*field, key.clearance, wideSearch.FindPath(key.startX, key.startY, key.goalX, key.goalY, JumpPointSearch::Mode::JumpPoint));
+                }
+                else if (key.mode == SearchMode::Hierarchical)
+                {
+                    // Built again only when a new grid was published
+                    if (hierarchicalGrid != grid)
+                    {
+                        const OccupancyGrid* cells = &grid->cells;
+                        hierarchical.Build(cells->GetWidth(), cells->GetHeight(), [cells](int x, int y) { return cells->IsBlocked(x, y); });
+                        hierarchicalGrid = grid;
+                    }
+                    *path = SmoothPath(grid->cells, hierarchical.FindPath(key.startX, key.startY, key.goalX, key.goalY));
+                }
+                else
+                {
+                    if (searchGrid != grid)
+                    {
+                        const OccupancyGrid* cells = &grid->cells;
+                        search.SetGrid(cells->GetWidth(), cells->GetHeight(), [cells](int x, int y) { return cells->IsBlocked(x, y); }, grid->version);
+                        searchGrid = grid;
+                    }
+
+                    JumpPointSearch::Mode searchMode = JumpPointSearch::Mode::JumpPoint;
+                    if (key.mode == SearchMode::JumpPointPlus)
+                    {
+                        // One worker builds the tables, the others wait for them and share them
+                        std::call_once(grid->plusTablesOnce, [&search, &grid]()
+                            {
+                                search.Precompute(grid->version);
+                                grid->plusTables = search.GetTables();
+                            });
+                        search.SetTables(grid->plusTables);
+                        searchMode = JumpPointSearch::Mode::JumpPointPlus;
+                    }
+                    *path = SmoothPath(grid->cells, search.FindPath(key.startX, key.startY, key.goalX, key.goalY, searchMode));
+                }
+            }
+            double searchMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - searchStart).count();
+
+            std::lock_guard<std::mutex> lock(mutex);
+            auto found = jobsByKey.find(job->key);
+            if (found != jobsByKey.end() && found->second == job)
+            {
+                jobsByKey.erase(found);
+            }
+            for (RequestID id : job->tickets)
+            {
+                jobsByTicket.erase(id);
+                finished.push_back({ id, grid ? grid->version : 0, valid, path });
+            }
+
+            ++stats.completed;
+            totalSearchMs += searchMs;
+            stats.averageSearchMs = totalSearchMs / static_cast<double>(stats.completed);
+        }
+    }
+
+    PathRequestQueue::Stats PathRequestQueue::GetStats() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        Stats copy = stats;
+        copy.queued = jobsByKey.size();
+        copy.outstanding = outstanding.size();
+        return copy;
+    }
+
+    void PathRequestQueue::ResetStats()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stats.submitted = 0;
+        stats.coalesced = 0;
+        stats.cancelled = 0;
+        stats.completed = 0;
+        stats.stale = 0;
+        totalSearchMs = 0.0;
+        stats.averageSearchMs = 0.0;
+    }
+}
@@ -0,0 +1,312 @@
+/******************************************************************************/
+/*!
+\file		PathRequestQueue.h
+\author		Ang Jun Sheng Aloysius, a.junshengaloysius, 2201807
+
+\par		a.junshengaloysius@digipen.edu
+
+\date		08/04/2024
+
+\brief		Contains the declaration of the asynchronous path request queue.
+			Units submit start and goal cells with a priority and receive a
+			ticket. Worker threads search a read-only snapshot of the navigation
+			grid with the search the caller asked for, and the main thread
+			collects finished paths once per update within a time budget.
+			Identical pending queries share one search.
+Copyright (C) 2024 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+ */
+ /******************************************************************************/
+#ifndef ENGINE_PATHREQUESTQUEUE_H
+#define ENGINE_PATHREQUESTQUEUE_H
+
+#include <vector>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <unordered_map>
+#include <unordered_set>
+#include <functional>
+#include <utility>
+#include <cstdint>
+#include "OccupancyGrid.h"
+#include "DistanceField.h"
+#include "JumpPointSearch.h"
+
+namespace Engine
+{
+    class PathRequestQueue
+    {
+    public:
+        // Ticket handed out by Submit, 0 is never a valid ticket
+        using RequestID = uint64_t;
+        using Path = std::vector<std::pair<int, int>>;
+
+        // Search run for a request. Wide units always search the distance field with plain JPS
+        enum class SearchMode
+        {
+            JumpPoint,
+            JumpPointPlus,  // JPS+ tables are built once per map version and shared by the workers
+            Hierarchical    // Each worker builds its own abstract graph once per map version
+        };
+
+        enum class Status
+        {
+            Pending,    // Still queued or being searched
+            Ready,      // The path was written out and the ticket is released
+            Failed      // Unknown, cancelled, or searched on an outdated map. Submit again
+        };
+
+        /*!
+        \brief Counters describing the queue. Totals grow until ResetStats is called.
+        */
+        struct Stats
+        {
+            unsigned long long submitted = 0;
+            unsigned long long coalesced = 0;   // Submissions that joined an identical pending search
+            unsigned long long cancelled = 0;
+            unsigned long long completed = 0;   // Searches finished by the workers
+            unsigned long long stale = 0;       // Results dropped because the map changed
+            size_t queued = 0;                  // Searches waiting for or running on a worker
+            size_t outstanding = 0;             // Tickets not yet taken or cancelled
+            int workers = 0;
+            int lastCollected = 0;              // Results moved to the main thread by the last CollectResults
+            double lastCollectMs = 0.0;
+            double averageSearchMs = 0.0;
+        };
+
+        /**************************************************************************/
+        /*!
+        \brief Constructor for the path request queue. Worker threads are started
+        on the first submission.
+
+        \param[in] workerCount
+        The number of worker threads. 0 picks a count from the hardware.
+        */
+        /**************************************************************************/
+        explicit PathRequestQueue(int workerCount = 0);
+
+        /**************************************************************************/
+        /*!
+        \brief Destructor, stops and joins the worker threads.
+        */
+        /**************************************************************************/
+        ~PathRequestQueue();
+
+        PathRequestQueue(const PathRequestQueue&) = delete;
+        PathRequestQueue& operator=(const PathRequestQueue&) = delete;
+
+        /**************************************************************************/
+        /*!
+        \brief Publishes a copy of the navigation grid for the workers to search.
+        Searches already running finish on the grid they started with, and their
+        results are reported as Failed once collected.
+
+        \param[in] cells
+        The navigation grid to copy.
+
+        \param[in] field
+        The distance field of the grid, used by wide units. Shared, not copied.
+
+        \param[in] mapVersion
+        The version of the navigation map being copied.
+        */
+        /**************************************************************************/
+        void SetNavGrid(const OccupancyGrid& cells, std::shared_ptr<const DistanceField> field, unsigned int mapVersion);
+
+        /*!
+        \brief Gets the version of the last published navigation grid.
+        \return The map version, or 0 if no grid was published yet.
+        */
+        unsigned int GetNavVersion() const { return navVersion; }
+
+        /**************************************************************************/
+        /*!
+        \brief Queues a path search between two grid cells.
+
+        \param[in] startX, startY
+        The start cell.
+
+        \param[in] goalX, goalY
+        The goal cell.
+
+        \param[in] priority
+        Higher priorities are searched first. Equal priorities are searched in
+        submission order.
+
+        \param[in] clearance
+        The radius of the unit in cells. Wider units only path through cells with
+        more clearance than this.
+
+        \param[in] mode
+        The search to run.
+
+        \return
+        The ticket used to collect or cancel the result.
+        */
+        /**************************************************************************/
+        RequestID Submit(int startX, int startY, int goalX, int goalY, int priority = 0, int clearance = 0,
+            SearchMode mode = SearchMode::JumpPoint);
+
+        /**************************************************************************/
+        /*!
+        \brief Cancels a ticket. The search itself is skipped if no other ticket
+        shares it.
+
+        \param[in] id
+        The ticket to cancel.
+        */
+        /**************************************************************************/
+        void Cancel(RequestID id);
+
+        /**************************************************************************/
+        /*!
+        \brief Cancels every outstanding ticket not in the given set. Used to drop
+        the requests of units that no longer exist.
+
+        \param[in] liveIDs
+        The tickets still held by units.
+        */
+        /**************************************************************************/
+        void CancelAllExcept(const std::unordered_set<RequestID>& liveIDs);
+
+        /**************************************************************************/
+        /*!
+        \brief Moves finished searches to the main thread. Called once per update
+        before the results are taken. Results left over when the budget runs out
+        are collected on the next call. Applying the taken paths is budgeted by
+        the caller.
+
+        \param[in] budgetMs
+        The time budget in milliseconds.
+        */
+        /**************************************************************************/
+        void CollectResults(double budgetMs);
+
+        /**************************************************************************/
+        /*!
+        \brief Takes the collected result of a ticket.
+
+        \param[in] id
+        The ticket to look up.
+
+        \param[out] outPath
+        The smoothed path in grid cells when Ready. Empty if no path exists.
+
+        \return
+        The status of the ticket.
+        */
+        /**************************************************************************/
+        Status TakeResult(RequestID id, Path& outPath);
+
+        /**************************************************************************/
+        /*!
+        \brief Stops and joins the worker threads and drops every request. Must be
+        called before the application exits, as joining threads from a static
+        destructor can deadlock while the module unloads.
+        */
+        /**************************************************************************/
+        void Shutdown();
+
+        /*!
+        \brief Gets the queue statistics.
+        \return A copy of the statistics.
+        */
+        Stats GetStats() const;
+
+        /*!
+        \brief Resets the accumulated totals.
+        */
+        void ResetStats();
+
+    private:
+        // Read-only copy of the navigation grid shared by the workers
+        struct NavGrid
+        {
+            OccupancyGrid cells;
+            std::shared_ptr<const DistanceField> field;
+            unsigned int version = 0;
+
+            // JPS+ tables of the grid, built by the first worker that needs them
+            mutable std::once_flag plusTablesOnce;
+            mutable std::shared_ptr<const JumpPointSearch::JumpTables> plusTables;
+        };
+
+        struct Key
+        {
+            int startX, startY, goalX, goalY;
+            int clearance;
+            SearchMode mode;
+            bool operator==(const Key& other) const
+            {
+                return startX == other.startX && startY == other.startY &&
+                    goalX == other.goalX && goalY == other.goalY && clearance == other.clearance && mode == other.mode;
+            }
+        };
+
+        struct KeyHash
+        {
+            size_t operator()(const Key& key) const;
+        };
+
+        struct Job
+        {
+            Key key;
+            int width, height;              // Grid size the cells were given for
+            std::vector<RequestID> tickets; // Tickets waiting on this search
+            bool started = false;
+        };
+
+        struct QueueEntry
+        {
+            int priority;
+            uint64_t sequence;
+            std::shared_ptr<Job> job;
+            bool operator<(const QueueEntry& other) const
+            {
+                // std::priority_queue pops the largest entry first
+                return priority != other.priority ? priority < other.priority : sequence > other.sequence;
+            }
+        };
+
+        struct Result
+        {
+            RequestID id;
+            unsigned int version;
+            bool valid;
+            std::shared_ptr<const Path> path;
+        };
+
+        void StartWorkers();
+        void WorkerLoop();
+        void CancelLocked(RequestID id);
+
+        int workerCount;
+        std::vector<std::thread> workers;
+        bool stopping = false;
+
+        mutable std::mutex mutex;
+        std::condition_variable wake;
+
+        // Everything below is guarded by the mutex
+        std::shared_ptr<const NavGrid> navGrid;
+        unsigned int navVersion = 0;
+        std::vector<QueueEntry> queue; // Binary heap
+        std::unordered_map<Key, std::shared_ptr<Job>, KeyHash> jobsByKey;
+        std::unordered_map<RequestID, std::shared_ptr<Job>> jobsByTicket;
+        std::unordered_set<RequestID> outstanding;
+        std::deque<Result> finished;
+        RequestID nextID = 1;
+        uint64_t nextSequence = 0;
+        double totalSearchMs = 0.0;
+        Stats stats;
+
+        // Collected results, only touched by the main thread
+        std::unordered_map<RequestID, Result> collected;
+    };
+}
+#endif ENGINE_PATHREQUESTQUEUE_H
@@ -0,0 +1,95 @@
+/******************************************************************************/
+/*!
+\file		PathSmoothing.cpp
+\author		Ang Jun Sheng Aloysius, a.junshengaloysius, 2201807
+
+\par		a.junshengaloysius@digipen.edu
+
+\date		12/04/2024
+
+\brief		Contains the definition of the path smoothing post-process.
+Copyright (C) 2024 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+ */
+ /******************************************************************************/
+
+#include "pch.h"
+#include "PathSmoothing.h"
+
+namespace Engine
+{
+    namespace
+    {
+        // Greedy string pulling, visible(from, to) tests line of sight between two waypoints by index
+        template <typename VisibleFunction>
+        std::vector<std::pair<int, int>> PullString(const std::vector<std::pair<int, int>>& path, VisibleFunction visible)
+        {
+            if (path.size() <= 2)
+            {
+                return path;
+            }
+
+            std::vector<std::pair<int, int>> smoothed = { path.front() };
+            size_t last = path.size() - 1;
+            size_t anchor = 0;
+            while (anchor < last)
+            {
+                // The next waypoint is one grid step away, so it can always be reached
+                size_t reach = anchor + 1;
+
+                // Gallop forward while the line of sight holds, then binary search the gap
+                size_t step = 1;
+                size_t blocked = 0;
+                while (reach < last)
+                {
+                    size_t next = std::min(reach + step, last);
+                    if (!visible(anchor, next))
+                    {
+                        blocked = next;
+                        break;
+                    }
+                    reach = next;
+                    step *= 2;
+                }
+                while (blocked != 0 && blocked - reach > 1)
+                {
+                    size_t middle = reach + (blocked - reach) / 2;
+                    if (visible(anchor, middle))
+                    {
+                        reach = middle;
+                    }
+                    else
+                    {
+                        blocked = middle;
+                    }
+                }
+
+                smoothed.push_back(path[reach]);
+                anchor = reach;
+            }
+            return smoothed;
+        }
+    }
+
+    std::vector<std::pair<int, int>> SmoothPath(const OccupancyGrid& grid, const std::vector<std::pair<int, int>>& path,
+        int offsetX, int offsetY)
+    {
+        return PullString(path, [&](size_t from, size_t to)
+            {
+                return grid.HasLineOfSight(path[from].first + offsetX, path[from].second + offsetY,
+                    path[to].first + offsetX, path[to].second + offsetY);
+            });
+    }
+
+    std::vector<std::pair<int, int>> SmoothPath(const DistanceField& field, int radius, const std::vector<std::pair<int, int>>& path,
+        int offsetX, int offsetY)
+    {
+        return PullString(path, [&](size_t from, size_t to)
+            {
+                return field.HasLineOfSight(path[from].first + offsetX, path[from].second + offsetY,
+                    path[to].first + offsetX, path[to].second + offsetY, radius);
+            });
+    }
+}
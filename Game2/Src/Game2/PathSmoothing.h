@@ -0,0 +1,75 @@
+/******************************************************************************/
+/*!
+\file		PathSmoothing.h
+\author		Ang Jun Sheng Aloysius, a.junshengaloysius, 2201807
+
+\par		a.junshengaloysius@digipen.edu
+
+\date		12/04/2024
+
+\brief		Contains the declaration of the path smoothing post-process. Grid
+			paths with one waypoint per cell are reduced to the corners where
+			the straight line of sight to the next waypoint is lost.
+Copyright (C) 2024 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+ */
+ /******************************************************************************/
+#ifndef ENGINE_PATHSMOOTHING_H
+#define ENGINE_PATHSMOOTHING_H
+
+#include <vector>
+#include <utility>
+#include "OccupancyGrid.h"
+#include "DistanceField.h"
+
+namespace Engine
+{
+    /**************************************************************************/
+    /*!
+    \brief Removes the waypoints of a grid path that can be skipped by walking in
+    a straight line. Every segment of the result has line of sight on the grid.
+
+    \param[in] grid
+    The occupancy grid the path was found on.
+
+    \param[in] path
+    The path, one waypoint per grid cell stepped.
+
+    \param[in] offsetX, offsetY
+    Added to the path coordinates to get grid cells. Used for paths stored in
+    world coordinates.
+
+    \return
+    The start, the corner waypoints, and the goal.
+    */
+    /**************************************************************************/
+    std::vector<std::pair<int, int>> SmoothPath(const OccupancyGrid& grid, const std::vector<std::pair<int, int>>& path,
+        int offsetX = 0, int offsetY = 0);
+
+    /**************************************************************************/
+    /*!
+    \brief Smooths the path of a wide unit. Segments only pass over cells with
+    more clearance than the unit's radius.
+
+    \param[in] field
+    The distance field of the grid the path was found on.
+
+    \param[in] radius
+    The radius of the unit in cells.
+
+    \param[in] path
+    The path, one waypoint per grid cell stepped.
+
+    \param[in] offsetX, offsetY
+    Added to the path coordinates to get grid cells.
+
+    \return
+    The start, the corner waypoints, and the goal.
+    */
+    /**************************************************************************/
+    std::vector<std::pair<int, int>> SmoothPath(const DistanceField& field, int radius, const std::vector<std::pair<int, int>>& path,
+        int offsetX = 0, int offsetY = 0);
+}
+#endif ENGINE_PATHSMOOTHING_H
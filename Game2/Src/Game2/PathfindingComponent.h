@@ -13,6 +13,7 @@
 
 #include "Component.h"
 #include "PathfindingSystem.h"
+#include "PathRequestQueue.h"
 #include "EngineTypes.h"
 #include "Vector2d.h"
 
@@ -35,6 +36,8 @@ namespace Engine
 		std::pair<int, int> previousPos1 = { 0, 0 };
 		std::pair<int, int> previousPos2 = { 0, 0 };
 		bool stoppedWalking = false;
+		PathRequestQueue::RequestID pathRequest = 0; // Outstanding asynchronous path request, 0 if none
+		VECTORMATH::Vector2D avoidanceVelocity; // Movement after crowd avoidance on the last update
 
 		/*!
 		\brief Get the type of the component.
@@ -49,9 +49,83 @@ namespace Engine
     std::pair<int, int> prevPos1 = { 0, 0 };
     std::pair<int, int> prevPos2 = { 0, 0 };
 
-    // Define the collision map as a dynamically allocated 2D array
-    // int** collisionMap = nullptr;
-    std::unique_ptr<std::unique_ptr<int[]>[]> collisionMap;
+    // One bit per pixel of the window, rasterized from the terrain and the static colliders
+    OccupancyGrid collisionMap;
+    double collisionMapBuildMs = 0.0;
+
+    // Terrain the units walk around, as { min, max } corners in world coordinates with max exclusive
+    const std::pair<std::pair<int, int>, std::pair<int, int>> TERRAIN_OBSTACLES[] = {
+        { {190, -60}, {640, 360} },
+        { {-640, -360}, {10, 0} },
+        { {10, -220}, {640, -220} },
+        { {-640, 150}, {5, 360} }
+    };
+
+    // Inclusive world-space bounds of the colliders that never move, gathered every update
+    struct StaticObstacle
+    {
+        int minX, minY, maxX, maxY;
+        bool operator==(const StaticObstacle& other) const
+        {
+            return minX == other.minX && minY == other.minY && maxX == other.maxX && maxY == other.maxY;
+        }
+    };
+    std::vector<StaticObstacle> staticObstacles;
+    std::vector<StaticObstacle> gatheredObstacles;
+
+    // Bumped whenever the collision map is rebuilt so cached paths can be invalidated
+    unsigned int navMapVersion = 0;
+
+    // Paths shared between units heading from the same area to the same goal
+    PathCache pathCache;
+    unsigned int pathCacheVersion = 0;  // Map version the cache was last purged against
+
+    // Abstract graph for large maps, and the map version it was last brought up to date with
+    HierarchicalPathfinder hierarchicalPathfinder(32);
+    unsigned int hierarchicalVersion = 0;
+
+    // 8-connected grid searches, the JPS+ tables are rebuilt lazily on the first query after a map change
+    JumpPointSearch jumpPointSearch;
+
+    // Clearance of every cell, rebuilt once per map version. A new field is made for each version
+    // since the workers may still be reading the previous one
+    std::shared_ptr<DistanceField> distanceField;
+
+    // Searches for units too wide for the plain grid. Kept apart from jumpPointSearch so its JPS+
+    // tables always describe the collision map
+    JumpPointSearch wideJumpPointSearch;
+
+    // Paths computed on worker threads. Finished paths are picked up at the start of the next update
+    PathRequestQueue pathRequests;
+    bool asyncPathfinding = true;
+    std::unordered_set<PathRequestQueue::RequestID> livePathRequests;
+
+    // Keeps walking units from stacking on each other after they followed their paths
+    struct CrowdUnit
+    {
+        TransformComponent* transform;
+        PathfindingComponent* pathfinding;
+        float startX, startY;           // Position before this update's movement
+        float preferredX, preferredY;   // Movement the path asked for
+        int clearance;                  // Radius the unit needs around it, in cells
+    };
+    CrowdAvoidance crowdAvoidance;
+    std::vector<CrowdUnit> crowdUnits;
+    bool crowdAvoidanceEnabled = true;
+
+    // Time the main thread may spend collecting finished paths each update
+    const double PATH_RESULT_BUDGET_MS = 1.0;
+
+    // Time the main thread may spend applying collected paths to units each update
+    const double PATH_APPLY_BUDGET_MS = 1.0;
+
+    // Walking speeds in pixels per second. Infantry and archers used to move a pixel every frame
+    // and tanks every other frame, at 60 frames per second
+    const float UNIT_WALK_SPEED = 60.0f;
+    const float TANK_WALK_SPEED = 30.0f;
+
+    // Maps with more cells than this use the hierarchical pathfinder
+    const int HIERARCHICAL_MIN_CELLS = 1920 * 1080;
 
     // Bool to check if unit has switched towers
     bool changedTowers = false;
@@ -59,60 +133,38 @@ namespace Engine
 
     void PathfindingSystem::createLogicalCollisionMap() 
     {
-        // Vector to store obstacle rectangles
-        std::vector<std::pair<std::pair<int, int>, std::pair<int, int>>> obstacles;
+        auto buildStart = std::chrono::high_resolution_clock::now();
+        int halfWidth = displayWidth / 2;
+        int halfHeight = displayHeight / 2;
 
-        // Add obstacles to the vector (example with two obstacles)
-        obstacles.push_back({ {190, -60}, {640, 360} });
-        obstacles.push_back({ {-640, -360}, {10, 0} });
-        obstacles.push_back({ {10, -220}, {640, -220} });
-        obstacles.push_back({ {-640, 150}, {5, 360} });
-
-        for (int i = 0; i < displayWidth; ++i)
+        // Rasterize rectangles instead of testing every cell against every obstacle
+        collisionMap.Resize(displayWidth, displayHeight);
+        for (const auto& obstacle : TERRAIN_OBSTACLES)
         {
-            for (int j = 0; j < displayHeight; ++j)
-            {
-                // Check if the cell is within any obstacle region
-                bool isObstacle = false;
-                for (const auto& obstacle : obstacles) {
-                    if (i >= (displayWidth / 2) + obstacle.first.first && i < (displayWidth / 2) + obstacle.second.first &&
-                        j >= (displayHeight / 2) + obstacle.first.second && j < (displayHeight / 2) + obstacle.second.second)
-                    {
-                        isObstacle = true;
-                        break;
-                    }
-                }
-
-                // Set to 1 for obstacles, 0 for free cells
-                collisionMap[i][j] = isObstacle ? 1 : 0;
-            }
+            collisionMap.FillRect(halfWidth + obstacle.first.first, halfHeight + obstacle.first.second,
+                halfWidth + obstacle.second.first - 1, halfHeight + obstacle.second.second - 1, true);
+        }
+        for (const auto& obstacle : staticObstacles)
+        {
+            collisionMap.FillRect(halfWidth + obstacle.minX, halfHeight + obstacle.minY,
+                halfWidth + obstacle.maxX, halfHeight + obstacle.maxY, true);
         }
+
+        collisionMapBuildMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - buildStart).count();
+        ++navMapVersion;
     }
 
     void PathfindingSystem::initializeCollisionMap()
     {
-        // Use smart pointers to manage the memory for the collision map
-        collisionMap = std::make_unique<std::unique_ptr<int[]>[]>(displayWidth);
-        for (int i = 0; i < displayWidth; i++)
-        {
-            collisionMap[i] = std::make_unique<int[]>(displayHeight);
-        }
-
-        // Create a logical collision map
+        // The grid is sized to the display when the logical collision map is rasterized
         createLogicalCollisionMap();
     }
 
     // Check if a specific cell has collision
     bool PathfindingSystem::hasCollision(int x, int y)
     {
-        // Ensure the coordinates are within the grid bounds
-        if (x >= 0 && x < displayWidth && y >= 0 && y < displayHeight)
-        {
-            // Return true if the cell has collision
-            return collisionMap[x][y] == 1;
-        }
-        // If the coordinates are outside the grid, consider it as having collision
-        return true;
+        // Coordinates outside the grid are treated as having collision
+        return collisionMap.IsBlocked(x, y);
     }
 
     // Function to check if a cell is within the bounds of the grid
@@ -135,6 +187,315 @@ namespace Engine
         return std::sqrt(dxSquared + dySquared);
     }
 
+    bool PathfindingSystem::joinCachedPath(int x, int y, std::vector<std::pair<int, int>>& path, int clearance)
+    {
+        if (path.empty())
+        {
+            return true;
+        }
+
+        int halfWidth = displayWidth / 2;
+        int halfHeight = displayHeight / 2;
+        int targetX = path.front().first;
+        int targetY = path.front().second;
+
+        if (x == targetX && y == targetY)
+        {
+            return true;
+        }
+
+        // Cached paths are kept per clearance, the bridge to them has to fit the unit as well
+        auto clear = [&](int fromX, int fromY, int toX, int toY)
+            {
+                if (clearance > 0)
+                {
+                    return GetDistanceField().HasLineOfSight(fromX + halfWidth, fromY + halfHeight, toX + halfWidth, toY + halfHeight, clearance);
+                }
+                return collisionMap.HasLineOfSight(fromX + halfWidth, fromY + halfHeight, toX + halfWidth, toY + halfHeight);
+            };
+
+        // Walk straight to the first point of the cached path, or around a single corner
+        std::vector<std::pair<int, int>> bridge = { { x, y } };
+        if (!clear(x, y, targetX, targetY))
+        {
+            if (clear(x, y, targetX, y) && clear(targetX, y, targetX, targetY))
+            {
+                bridge.push_back({ targetX, y });
+            }
+            else if (clear(x, y, x, targetY) && clear(x, targetY, targetX, targetY))
+            {
+                bridge.push_back({ x, targetY });
+            }
+            else
+            {
+                return false;
+            }
+        }
+
+        path.insert(path.begin(), bridge.begin(), bridge.end());
+        return true;
+    }
+
+    const HierarchicalPathfinder& PathfindingSystem::GetHierarchicalPathfinder()
+    {
+        return hierarchicalPathfinder;
+    }
+
+    const JumpPointSearch& PathfindingSystem::GetJumpPointSearch()
+    {
+        return jumpPointSearch;
+    }
+
+    PathRequestQueue& PathfindingSystem::GetPathRequestQueue()
+    {
+        return pathRequests;
+    }
+
+    void PathfindingSystem::Shutdown()
+    {
+        pathRequests.Shutdown();
+        livePathRequests.clear();
+    }
+
+    void PathfindingSystem::SetAsyncPathfinding(bool enabled)
+    {
+        asyncPathfinding = enabled;
+    }
+
+    bool PathfindingSystem::IsAsyncPathfinding()
+    {
+        return asyncPathfinding;
+    }
+
+    CrowdAvoidance& PathfindingSystem::GetCrowdAvoidance()
+    {
+        return crowdAvoidance;
+    }
+
+    void PathfindingSystem::SetCrowdAvoidance(bool enabled)
+    {
+        crowdAvoidanceEnabled = enabled;
+    }
+
+    bool PathfindingSystem::IsCrowdAvoidance()
+    {
+        return crowdAvoidanceEnabled;
+    }
+
+    // Checks that a unit can walk a whole step without cutting through a blocked cell, or for wide
+    // units through a gap narrower than their clearance. A wide unit already closer to a wall than
+    // its clearance only has to stay on free cells, so it can still walk away from the wall
+    bool isStepClear(float startX, float startY, float stepX, float stepY, int clearance)
+    {
+        int halfWidth = collisionMap.GetWidth() / 2;
+        int halfHeight = collisionMap.GetHeight() / 2;
+        int fromX = static_cast<int>(std::floor(startX)) + halfWidth;
+        int fromY = static_cast<int>(std::floor(startY)) + halfHeight;
+        int toX = static_cast<int>(std::floor(startX + stepX)) + halfWidth;
+        int toY = static_cast<int>(std::floor(startY + stepY)) + halfHeight;
+        if (clearance > 0)
+        {
+            const DistanceField& field = PathfindingSystem::GetDistanceField();
+            if (field.GetClearance(fromX, fromY) > clearance)
+            {
+                return field.HasLineOfSight(fromX, fromY, toX, toY, clearance);
+            }
+        }
+        return collisionMap.HasLineOfSight(fromX, fromY, toX, toY);
+    }
+
+    // Replaces the movement of every walking unit with the closest velocity that does not
+    // walk into another unit. Units are never pushed into the collision map
+    void resolveCrowd()
+    {
+        // Velocities are the distances walked in one fixed step, so the solve covers a single step
+        crowdAvoidance.Solve(1.0f);
+        for (int agent = 0; agent < static_cast<int>(crowdUnits.size()); ++agent)
+        {
+            CrowdUnit& unit = crowdUnits[agent];
+            float velocityX = crowdAvoidance.GetVelocityX(agent);
+            float velocityY = crowdAvoidance.GetVelocityY(agent);
+
+            // Fall back to the movement the path asked for, and stand still if that is blocked too
+            if (!isStepClear(unit.startX, unit.startY, velocityX, velocityY, unit.clearance))
+            {
+                velocityX = unit.preferredX;
+                velocityY = unit.preferredY;
+                if (!isStepClear(unit.startX, unit.startY, velocityX, velocityY, unit.clearance))
+                {
+                    velocityX = 0.0f;
+                    velocityY = 0.0f;
+                }
+            }
+
+            unit.transform->position.x = unit.startX + velocityX;
+            unit.transform->position.y = unit.startY + velocityY;
+            unit.pathfinding->avoidanceVelocity = VECTORMATH::Vector2D(velocityX, velocityY);
+        }
+    }
+
+    // Brings the distance field up to date with the collision map
+    const DistanceField& updateDistanceField()
+    {
+        if (!distanceField || !distanceField->IsBuilt(navMapVersion))
+        {
+            auto field = std::make_shared<DistanceField>();
+            field->Build(collisionMap, navMapVersion);
+            distanceField = std::move(field);
+        }
+        return *distanceField;
+    }
+
+    // Hands the workers a copy of the collision map if it changed since the last copy
+    void publishNavGrid()
+    {
+        if (collisionMap.GetWidth() > 0 && pathRequests.GetNavVersion() != navMapVersion)
+        {
+            updateDistanceField();
+            pathRequests.SetNavGrid(collisionMap, distanceField, navMapVersion);
+        }
+    }
+
+    // Moves a world position out of an obstacle to the closest free cell
+    void snapToFreeCell(int& x, int& y)
+    {
+        int halfWidth = collisionMap.GetWidth() / 2;
+        int halfHeight = collisionMap.GetHeight() / 2;
+        std::pair<int, int> cell = updateDistanceField().NearestFree(x + halfWidth, y + halfHeight);
+        x = cell.first - halfWidth;
+        y = cell.second - halfHeight;
+    }
+
+    // Vertical offsets from each tower to the point units walk to when attacking it
+    const int TOWER1_APPROACH_OFFSET_Y = 80;
+    const int TOWER2_APPROACH_OFFSET_Y = -105;
+    // Distance in pixels from an approach point within which a unit counts as having reached it
+    const double TOWER_ARRIVAL_RADIUS = 16.0;
+
+    // Checks whether a unit stands at the approach point of a tower. The point is snapped out of
+    // the tower collider the same way the path goal is, and path following and crowd avoidance
+    // rarely stop on the exact pixel, so the unit only has to be near it
+    bool isAtTowerApproach(int x, int y, const std::pair<int, int>& tower, int offsetY)
+    {
+        int targetX = tower.first;
+        int targetY = tower.second + offsetY;
+        snapToFreeCell(targetX, targetY);
+        double dx = static_cast<double>(x - targetX);
+        double dy = static_cast<double>(y - targetY);
+        return dx * dx + dy * dy <= TOWER_ARRIVAL_RADIUS * TOWER_ARRIVAL_RADIUS;
+    }
+
+    // Radius in cells a unit needs around its path. Tanks are too wide for the narrow gaps
+    int getUnitClearance(const TextureComponent* texture, const CollisionComponent* collision)
+    {
+        if (texture == nullptr || collision == nullptr || texture->textureKey.mainIndex != TextureClass::Tank)
+        {
+            return 0;
+        }
+        return static_cast<int>(collision->c_Width / 2.0f);
+    }
+
+    const DistanceField& PathfindingSystem::GetDistanceField()
+    {
+        return updateDistanceField();
+    }
+
+    // Moves a unit a distance along its path of corner waypoints, dropping the waypoints it reaches
+    void followPath(TransformComponent* transform, std::vector<std::pair<int, int>>& path, float distance)
+    {
+        float remaining = distance;
+        while (remaining > 0.0f && !path.empty())
+        {
+            float dx = static_cast<float>(path.front().first) - transform->position.x;
+            float dy = static_cast<float>(path.front().second) - transform->position.y;
+            float length = std::sqrt(dx * dx + dy * dy);
+            if (length <= remaining)
+            {
+                transform->position.x = static_cast<float>(path.front().first);
+                transform->position.y = static_cast<float>(path.front().second);
+                path.erase(path.begin());
+                remaining -= length;
+            }
+            else
+            {
+                transform->position.x += dx / length * remaining;
+                transform->position.y += dy / length * remaining;
+                remaining = 0.0f;
+            }
+        }
+    }
+
+    void PathfindingSystem::SetObstacle(int minX, int minY, int maxX, int maxY, bool blocked)
+    {
+        int mapWidth = collisionMap.GetWidth();
+        int mapHeight = collisionMap.GetHeight();
+        if (mapWidth == 0)
+        {
+            return;
+        }
+
+        // Convert to collision map cells and clamp to the map
+        int cellMinX = std::max(0, std::min(minX, maxX) + mapWidth / 2);
+        int cellMinY = std::max(0, std::min(minY, maxY) + mapHeight / 2);
+        int cellMaxX = std::min(mapWidth - 1, std::max(minX, maxX) + mapWidth / 2);
+        int cellMaxY = std::min(mapHeight - 1, std::max(minY, maxY) + mapHeight / 2);
+        if (cellMinX > cellMaxX || cellMinY > cellMaxY)
+        {
+            return;
+        }
+
+        collisionMap.FillRect(cellMinX, cellMinY, cellMaxX, cellMaxY, blocked);
+
+        // Cells the terrain or another static collider still covers stay blocked
+        if (!blocked)
+        {
+            int halfWidth = mapWidth / 2;
+            int halfHeight = mapHeight / 2;
+            auto restore = [&](int obstacleMinX, int obstacleMinY, int obstacleMaxX, int obstacleMaxY)
+                {
+                    collisionMap.FillRect(std::max(cellMinX, obstacleMinX + halfWidth), std::max(cellMinY, obstacleMinY + halfHeight),
+                        std::min(cellMaxX, obstacleMaxX + halfWidth), std::min(cellMaxY, obstacleMaxY + halfHeight), true);
+                };
+            for (const auto& obstacle : TERRAIN_OBSTACLES)
+            {
+                restore(obstacle.first.first, obstacle.first.second, obstacle.second.first - 1, obstacle.second.second - 1);
+            }
+            for (const auto& obstacle : staticObstacles)
+            {
+                restore(obstacle.minX, obstacle.minY, obstacle.maxX, obstacle.maxY);
+            }
+        }
+
+        // Keep the hierarchical graph current without rebuilding every cluster
+        bool hierarchicalCurrent = hierarchicalPathfinder.IsBuilt() && hierarchicalVersion == navMapVersion;
+        ++navMapVersion;
+        if (hierarchicalCurrent)
+        {
+            hierarchicalPathfinder.OnRegionChanged(cellMinX, cellMinY, cellMaxX, cellMaxY);
+            hierarchicalVersion = navMapVersion;
+        }
+    }
+
+    unsigned int PathfindingSystem::GetNavMapVersion()
+    {
+        return navMapVersion;
+    }
+
+    const OccupancyGrid& PathfindingSystem::GetCollisionMap()
+    {
+        return collisionMap;
+    }
+
+    double PathfindingSystem::GetCollisionMapBuildMs()
+    {
+        return collisionMapBuildMs;
+    }
+
+    PathCache& PathfindingSystem::GetPathCache()
+    {
+        return pathCache;
+    }
+
     std::string PathfindingSystem::returnSystem()
     {
         return "pathfindingSystem";
@@ -150,8 +511,8 @@ namespace Engine
         initialized = false;
         isWalking = false;
 
-        // Call initializeCollisionMap only once in the constructor
-        if (!collisionMap) {
+        // Build the collision map once, and again whenever the display size changes
+        if (collisionMap.GetWidth() != displayWidth || collisionMap.GetHeight() != displayHeight) {
             initializeCollisionMap();
         }
     }
@@ -200,6 +561,14 @@ namespace Engine
         goalY = y;
     }
 
+    void PathfindingSystem::setQueryMode(PathQueryMode mode) {
+        queryMode = mode;
+    }
+
+    void PathfindingSystem::setClearance(int radius) {
+        clearance = std::max(radius, 0);
+    }
+
     //void PathfindingSystem::setGoal(int x, int y) {
     //    if (hasCollision(x, y)) {
     //        // Ending point is inside a collided area, find the closest free cell
@@ -214,30 +583,8 @@ namespace Engine
     //}
 
     std::pair<int, int> PathfindingSystem::findClosestFreeCell(int x, int y) {
-        // Define the search area as a rectangle with a given width and height
-        const int SEARCH_WIDTH = 500;
-        const int SEARCH_HEIGHT = 500;
-
-        // Iterate through the cells in the rectangular search area
-        for (int i = -SEARCH_WIDTH / 2; i <= SEARCH_WIDTH / 2; ++i) {
-            for (int j = -SEARCH_HEIGHT / 2; j <= SEARCH_HEIGHT / 2; ++j) {
-                int newX = x + i;
-                int newY = y + j;
-
-                // Check if the current cell is within the bounds of the collision map
-                if (isValid(newX, newY)) {
-                    // Check if the current cell is not colliding
-                    if (!hasCollision(newX, newY)) {
-                        //std::cout << "newGoal.first: " << newX << "newGoal.second: " << newY << std::endl;
-                        return { newX, newY };  // Found a free cell
-                    }
-                }
-            }
-        }
-
-        //std::cout << "function did nothing " << std::endl;
-        // If no free cell is found in the search area, return the original point
-        return { x, y };
+        // The distance field stores the nearest free cell of every blocked cell
+        return updateDistanceField().NearestFree(x, y);
     }
 
     std::pair<int, int> PathfindingSystem::getClosestPair(int startPosX, int startPosY, const std::vector<std::pair<int, int>>& towersPositions, int unitNum)
@@ -270,7 +617,7 @@ namespace Engine
         // Change path to other tower if at current tower
         if (unitNum != 3) 
         {
-            if (towersPositions.size() > 1 && endPointX == closestTower.first && endPointY == closestTower.second + 80 &&
+            if (towersPositions.size() > 1 && isAtTowerApproach(endPointX, endPointY, closestTower, TOWER1_APPROACH_OFFSET_Y) &&
                 tower2Destroyed == false)
             {
                 if (closestTower.first == towersPositions[0].first && closestTower.second == towersPositions[0].second)
@@ -279,7 +626,7 @@ namespace Engine
                     prevPos2 = towersPositions[0];
                 }
             }
-            if (towersPositions.size() > 1 && endPointX == closestTower.first && endPointY == closestTower.second - 105 &&
+            if (towersPositions.size() > 1 && isAtTowerApproach(endPointX, endPointY, closestTower, TOWER2_APPROACH_OFFSET_Y) &&
                 tower1Destroyed == false)
             {
                 if (closestTower.first == towersPositions[1].first && closestTower.second == towersPositions[1].second)
@@ -323,6 +670,69 @@ namespace Engine
         int adjustedStartY = startY + static_cast<int>(windowHeight / 2);
         int adjustedGoalX = goalX + static_cast<int>(windowWidth / 2);
         int adjustedGoalY = goalY + static_cast<int>(windowHeight / 2);
+
+        if (clearance > 0)
+        {
+            // Wide units only cross cells with enough room around them, whatever the query mode
+            const DistanceField* field = &updateDistanceField();
+            int radius = clearance;
+            wideJumpPointSearch.SetGrid(field->GetWidth(), field->GetHeight(), [=](int x, int y)
+                {
+                    return field->BlocksUnit(x, y, radius, adjustedStartX, adjustedStartY, adjustedGoalX, adjustedGoalY);
+                }, navMapVersion);
+
+            std::vector<std::pair<int, int>> path = wideJumpPointSearch.FindPath(adjustedStartX, adjustedStartY, adjustedGoalX, adjustedGoalY, JumpPointSearch::Mode::JumpPoint);
+            for (auto& point : path)
+            {
+                point.first -= static_cast<int>(windowWidth / 2);
+                point.second -= static_cast<int>(windowHeight / 2);
+            }
+            return path;
+        }
+
+        if (queryMode == PathQueryMode::Hierarchical)
+        {
+            // Rebuild the abstract graph if the map was regenerated since it was last built
+            if (!hierarchicalPathfinder.IsBuilt() || hierarchicalVersion != navMapVersion)
+            {
+                hierarchicalPathfinder.Build(collisionMap.GetWidth(), collisionMap.GetHeight(), [](int x, int y) { return collisionMap.IsBlocked(x, y); });
+                hierarchicalVersion = navMapVersion;
+            }
+
+            std::vector<std::pair<int, int>> path = hierarchicalPathfinder.FindPath(adjustedStartX, adjustedStartY, adjustedGoalX, adjustedGoalY);
+            for (auto& point : path)
+            {
+                point.first -= static_cast<int>(windowWidth / 2);
+                point.second -= static_cast<int>(windowHeight / 2);
+            }
+            return path;
+        }
+
+        if (queryMode == PathQueryMode::AStar || queryMode == PathQueryMode::JumpPoint || queryMode == PathQueryMode::JumpPointPlus)
+        {
+            jumpPointSearch.SetGrid(collisionMap.GetWidth(), collisionMap.GetHeight(), [](int x, int y) { return collisionMap.IsBlocked(x, y); }, navMapVersion);
+
+            JumpPointSearch::Mode mode = JumpPointSearch::Mode::AStar;
+            if (queryMode == PathQueryMode::JumpPoint)
+            {
+                mode = JumpPointSearch::Mode::JumpPoint;
+            }
+            else if (queryMode == PathQueryMode::JumpPointPlus)
+            {
+                // Only does work on the first query after the map changed
+                jumpPointSearch.Precompute(navMapVersion);
+                mode = JumpPointSearch::Mode::JumpPointPlus;
+            }
+
+            std::vector<std::pair<int, int>> path = jumpPointSearch.FindPath(adjustedStartX, adjustedStartY, adjustedGoalX, adjustedGoalY, mode);
+            for (auto& point : path)
+            {
+                point.first -= static_cast<int>(windowWidth / 2);
+                point.second -= static_cast<int>(windowHeight / 2);
+            }
+            return path;
+        }
+
         std::vector<std::vector<double>> distanceGrid(numRows, std::vector<double>(numCols, INFINITY));
         std::vector<std::vector<std::pair<int, int>>> parent(numRows, std::vector<std::pair<int, int>>(numCols, { -1, -1 }));
         std::priority_queue<Node, std::vector<Node>, std::greater<Node>> pq;
@@ -381,6 +791,71 @@ namespace Engine
 
         glfwGetFramebufferSize(glfwGetCurrentContext(), &displayWidth, &displayHeight); // Initialize window width and height
 
+        // Nothing to path on while the window is minimized
+        if (displayWidth <= 0 || displayHeight <= 0)
+        {
+            return;
+        }
+
+        // Towers and the castle never move, so their colliders are baked into the collision map.
+        // Redraw the ones that appear, move or go away
+        gatheredObstacles.clear();
+        for (const auto& it : *entities)
+        {
+            Entity* entity = it.second.get();
+            if (!entity->HasComponent(ComponentType::Collision))
+            {
+                continue;
+            }
+
+            CollisionComponent* collider = dynamic_cast<CollisionComponent*>(entity->GetComponent(ComponentType::Collision));
+            if (collider && !collider->disableCollision && (collider->layer == Layer::Tower || collider->layer == Layer::Castle))
+            {
+                gatheredObstacles.push_back({
+                    static_cast<int>(std::floor(collider->aabb.min.x)), static_cast<int>(std::floor(collider->aabb.min.y)),
+                    static_cast<int>(std::floor(collider->aabb.max.x)), static_cast<int>(std::floor(collider->aabb.max.y)) });
+            }
+        }
+        if (gatheredObstacles != staticObstacles)
+        {
+            staticObstacles.swap(gatheredObstacles);
+            if (collisionMap.GetWidth() == displayWidth && collisionMap.GetHeight() == displayHeight)
+            {
+                // Only the changed rectangles are redrawn, so the hierarchical graph rebuilds the clusters
+                // around them instead of every cluster. Removed colliders are cleared first so the
+                // obstacles still present are restored over them
+                for (const StaticObstacle& obstacle : gatheredObstacles)
+                {
+                    if (std::find(staticObstacles.begin(), staticObstacles.end(), obstacle) == staticObstacles.end())
+                    {
+                        SetObstacle(obstacle.minX, obstacle.minY, obstacle.maxX, obstacle.maxY, false);
+                    }
+                }
+                for (const StaticObstacle& obstacle : staticObstacles)
+                {
+                    if (std::find(gatheredObstacles.begin(), gatheredObstacles.end(), obstacle) == gatheredObstacles.end())
+                    {
+                        SetObstacle(obstacle.minX, obstacle.minY, obstacle.maxX, obstacle.maxY, true);
+                    }
+                }
+            }
+        }
+
+        // Paths from older maps can never be reused, drop them once per map change
+        if (pathCacheVersion != navMapVersion)
+        {
+            pathCache.PurgeStale(navMapVersion);
+            pathCacheVersion = navMapVersion;
+        }
+
+        // Pick up the paths the workers finished since the last update
+        publishNavGrid();
+        pathRequests.CollectResults(PATH_RESULT_BUDGET_MS);
+        double pathApplyMs = 0.0;
+        livePathRequests.clear();
+        crowdAvoidance.Clear();
+        crowdUnits.clear();
+
         // std::cout << "MouseX: " << Input::GetMouseX() << "MouseY: " << Input::GetMouseY() << std::endl;
 
         // Iterate through entities that require pathfinding updates.
@@ -475,6 +950,57 @@ namespace Engine
                             // towerPositions.erase(towerPositions.begin() + 1);
                         }
 
+                        int unitClearance = getUnitClearance(textureComponent, collisionComponent);
+
+                        // Apply the result of an earlier asynchronous request, or drop it if the unit died
+                        if (pathfindingComponent->pathRequest != 0 && statsComponent->playerDead)
+                        {
+                            pathRequests.Cancel(pathfindingComponent->pathRequest);
+                            pathfindingComponent->pathRequest = 0;
+                        }
+                        else if (pathfindingComponent->pathRequest != 0 && pathfindingComponent->initialized && pathApplyMs >= PATH_APPLY_BUDGET_MS)
+                        {
+                            // Out of time to apply paths this update, the result waits for the next one
+                            livePathRequests.insert(pathfindingComponent->pathRequest);
+                        }
+                        else if (pathfindingComponent->pathRequest != 0 && pathfindingComponent->initialized)
+                        {
+                            auto applyStart = std::chrono::high_resolution_clock::now();
+                            PathRequestQueue::Path result;
+                            PathRequestQueue::Status status = pathRequests.TakeResult(pathfindingComponent->pathRequest, result);
+
+                            if (status == PathRequestQueue::Status::Pending)
+                            {
+                                livePathRequests.insert(pathfindingComponent->pathRequest);
+                            }
+                            else
+                            {
+                                pathfindingComponent->pathRequest = 0;
+
+                                for (auto& point : result)
+                                {
+                                    point.first -= displayWidth / 2;
+                                    point.second -= displayHeight / 2;
+                                }
+                                if (!result.empty())
+                                {
+                                    pathCache.Insert(result.front().first, result.front().second, result.back().first, result.back().second, navMapVersion, result, unitClearance);
+                                }
+
+                                // The unit kept walking while it waited, join the new path from where it is now
+                                PathfindingSystem pathfinder(displayWidth, displayHeight);
+                                if (status == PathRequestQueue::Status::Ready && pathfinder.joinCachedPath(startX, startY, result, unitClearance))
+                                {
+                                    pathfindingComponent->path = std::move(result);
+                                }
+                                else
+                                {
+                                    pathfindingComponent->initialized = false;
+                                }
+                            }
+                            pathApplyMs += std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - applyStart).count();
+                        }
+
                         if (!(pathfindingComponent->initialized) && !statsComponent->playerDead)
                         {
 
@@ -493,22 +1019,62 @@ namespace Engine
                                 // If tower 1
                                 if (goalX == -275 && goalY == -35)
                                 {
-                                    goalY = goalY + 80;
+                                    goalY = goalY + TOWER1_APPROACH_OFFSET_Y;
                                     pathfindingComponent->previousPos1 = prevPos1;
                                     // std::cout << "previousPos1: " << pathfindingComponent->previousPos1.first << std::endl;
                                 }
                                 // If tower 2
                                 if (goalX == -70 && goalY == 245)
                                 {
-                                    goalY = goalY - 105;
+                                    goalY = goalY + TOWER2_APPROACH_OFFSET_Y;
                                     pathfindingComponent->previousPos2 = prevPos2;
                                     // std::cout << "previousPos2: " << pathfindingComponent->previousPos2.first << std::endl;
                                 }
                             }
                             
-                            pathfinder.setGoal(goalX, goalY);
+                            // Approach points can fall inside a tower collider, stand at the nearest free cell instead
+                            int targetX = goalX;
+                            int targetY = goalY;
+                            snapToFreeCell(targetX, targetY);
+
+                            pathfinder.setGoal(targetX, targetY);
+                            bool hierarchicalQuery = displayWidth * displayHeight > HIERARCHICAL_MIN_CELLS;
+                            pathfinder.setQueryMode(hierarchicalQuery ? PathQueryMode::Hierarchical : PathQueryMode::JumpPointPlus);
+                            pathfinder.setClearance(unitClearance);
                             // std::cout << "inside goalX: " << goalX << "inside goalY: " << goalY << std::endl;
-                            pathfindingComponent->path = pathfinder.findShortestPath(displayWidth, displayHeight);
+
+                            // Reuse a path computed from the same area to the same goal if the map hasn't changed
+                            // A new query replaces any request still in flight
+                            if (pathfindingComponent->pathRequest != 0)
+                            {
+                                pathRequests.Cancel(pathfindingComponent->pathRequest);
+                                pathfindingComponent->pathRequest = 0;
+                            }
+
+                            std::vector<std::pair<int, int>> cachedPath;
+                            if (pathCache.Find(startX, startY, targetX, targetY, navMapVersion, cachedPath, unitClearance) &&
+                                pathfinder.joinCachedPath(startX, startY, cachedPath, unitClearance))
+                            {
+                                pathfindingComponent->path = std::move(cachedPath);
+                            }
+                            else if (asyncPathfinding)
+                            {
+                                // Keep walking the old path until the workers send the new one. Units
+                                // standing still are searched first
+                                publishNavGrid();
+                                pathfindingComponent->pathRequest = pathRequests.Submit(startX + displayWidth / 2, startY + displayHeight / 2,
+                                    targetX + displayWidth / 2, targetY + displayHeight / 2, pathfindingComponent->path.empty() ? 1 : 0, unitClearance,
+                                    hierarchicalQuery ? PathRequestQueue::SearchMode::Hierarchical : PathRequestQueue::SearchMode::JumpPointPlus);
+                                livePathRequests.insert(pathfindingComponent->pathRequest);
+                            }
+                            else
+                            {
+                                std::vector<std::pair<int, int>> path = pathfinder.findShortestPath(displayWidth, displayHeight);
+                                pathfindingComponent->path = unitClearance > 0 ?
+                                    SmoothPath(updateDistanceField(), unitClearance, path, displayWidth / 2, displayHeight / 2) :
+                                    SmoothPath(collisionMap, path, displayWidth / 2, displayHeight / 2);
+                                pathCache.Insert(startX, startY, targetX, targetY, navMapVersion, pathfindingComponent->path, unitClearance);
+                            }
                             pathfindingComponent->initialized = true;
 
                         }
@@ -570,8 +1136,6 @@ namespace Engine
                             }
 
                             
-                            std::pair<int, int> nextPosition = pathfindingComponent->path[0];
-
                             // Settings for the rest of the units
                             if (behaviourComponent && textureComponent->textureKey.mainIndex != 3)
                             {
@@ -589,39 +1153,23 @@ namespace Engine
                             //    behaviourComponent->SetBehaviourState(c_state::Attack);
                             //}
 
-                            if (textureComponent->textureKey.mainIndex == 1)
-                            {
-                                pathfindingComponent->timeElapsedMovement = Application::ElapsedTime(pathfindingComponent, 0.01);
-                                // std::cout << "Starting elapsed time movement is: " << pathfindingComponent->timeElapsedMovement << " seconds" << std::endl;
-
-                                if (pathfindingComponent->timeElapsedMovement >= 0.01)
-                                {
-                                    // Update the entity's position
-                                    transformComponent->position.x = static_cast<float>(nextPosition.first);
-                                    transformComponent->position.y = static_cast<float>(nextPosition.second);
+                            float movementStartX = transformComponent->position.x;
+                            float movementStartY = transformComponent->position.y;
 
-                                    // Remove the first position from the path
-                                    pathfindingComponent->path.erase(pathfindingComponent->path.begin());
+                            // Update runs once per fixed step, so units walk a fixed distance each call
+                            float stepDistance = (textureComponent->textureKey.mainIndex == 2 ? TANK_WALK_SPEED : UNIT_WALK_SPEED)
+                                * static_cast<float>(fixedDeltaTime);
 
-                                    // pathfindingComponent->timeElapsedMovement = 0.0f;
-                                    // std::cout << "Ending elapsed time movement is: " << pathfindingComponent->timeElapsedMovement << " seconds" << std::endl;
-                                }
+                            if (textureComponent->textureKey.mainIndex == 1)
+                            {
+                                // Move towards the next corner of the path
+                                followPath(transformComponent, pathfindingComponent->path, stepDistance);
                             }
 
                             if (textureComponent->textureKey.mainIndex == 3 && !collisionComponent->isColliding) 
                             {
-                                pathfindingComponent->timeElapsedMovement = Application::ElapsedTime(pathfindingComponent, 0.01);
-
-                                if (pathfindingComponent->timeElapsedMovement >= 0.01)
-                                {
-                                    // Update the entity's position
-                                    transformComponent->position.x = static_cast<float>(nextPosition.first);
-                                    transformComponent->position.y = static_cast<float>(nextPosition.second);
-
-                                    // Remove the first position from the path
-                                    pathfindingComponent->path.erase(pathfindingComponent->path.begin());
-
-                                }
+                                // Move towards the next corner of the path
+                                followPath(transformComponent, pathfindingComponent->path, stepDistance);
                             }
 
                             //if (textureComponent->textureKey.mainIndex == 3 && collisionComponent->isColliding) 
@@ -631,26 +1179,33 @@ namespace Engine
 
                             if (textureComponent->textureKey.mainIndex == 2)
                             {
-                                
-                                pathfindingComponent->timeElapsedMovement = Application::ElapsedTime(pathfindingComponent, 0.02);
-                                //pathfindingComponent->charType = textureComponent->textureKey.mainIndex;
-
-                                if (pathfindingComponent->timeElapsedMovement >= 0.02)
-                                {
-                                    // Update the entity's position
-                                    transformComponent->position.x = static_cast<float>(nextPosition.first);
-                                    transformComponent->position.y = static_cast<float>(nextPosition.second);
+                                // Move towards the next corner of the path
+                                followPath(transformComponent, pathfindingComponent->path, stepDistance);
+                            }
 
-                                    // Remove the first position from the path
-                                    pathfindingComponent->path.erase(pathfindingComponent->path.begin());
-                                }
-                                
+                            // The crowd step decides the final movement once every unit has moved
+                            if (crowdAvoidanceEnabled)
+                            {
+                                float preferredX = transformComponent->position.x - movementStartX;
+                                float preferredY = transformComponent->position.y - movementStartY;
+                                transformComponent->position.x = movementStartX;
+                                transformComponent->position.y = movementStartY;
+                                crowdAvoidance.AddAgent(movementStartX, movementStartY, collisionComponent->c_Width / 2.0f,
+                                    pathfindingComponent->avoidanceVelocity.x, pathfindingComponent->avoidanceVelocity.y, preferredX, preferredY, stepDistance);
+                                crowdUnits.push_back({ transformComponent, pathfindingComponent, movementStartX, movementStartY, preferredX, preferredY, unitClearance });
                             }
                         }
 
-                        // Switch back to attacking mode
-                        else
+                        // Switch back to attacking mode, unless the unit is still waiting for its path
+                        else if (pathfindingComponent->pathRequest == 0)
                         {
+                            // Units at their goal hold their position, walking units go around them
+                            if (crowdAvoidanceEnabled && !statsComponent->playerDead)
+                            {
+                                crowdAvoidance.AddAgent(transformComponent->position.x, transformComponent->position.y, collisionComponent->c_Width / 2.0f,
+                                    0.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+                                crowdUnits.push_back({ transformComponent, pathfindingComponent, transformComponent->position.x, transformComponent->position.y, 0.0f, 0.0f, unitClearance });
+                            }
 
                             // Infantry
                             if (prevTexture != 8 && prevTexture != 9 && textureComponent->textureKey.mainIndex == 1 && textureComponent->textureKey.subIndex == 1)
@@ -712,5 +1267,13 @@ namespace Engine
                 //}
             }
         }
+
+        if (crowdAvoidanceEnabled)
+        {
+            resolveCrowd();
+        }
+
+        // Drop the requests of units that were destroyed while waiting
+        pathRequests.CancelAllExcept(livePathRequests);
     }
 }
\ No newline at end of file
@@ -24,12 +24,24 @@ Technology is prohibited.
 #include <algorithm>
 #include "System.h"
 #include "PathfindingComponent.h"
+#include "PathCache.h"
+#include "HierarchicalPathfinder.h"
+#include "JumpPointSearch.h"
+#include "PathRequestQueue.h"
+#include "OccupancyGrid.h"
+#include "PathSmoothing.h"
+#include "DistanceField.h"
+#include "CrowdAvoidance.h"
 
 extern bool isGameOver;
 extern bool accessedCastle;
 
 namespace Engine
 {
+    // Search algorithm used to answer a pathfinding query. Grid is the original
+    // 4-connected search, the A* and jump point modes move in 8 directions
+    enum class PathQueryMode { Grid, Hierarchical, AStar, JumpPoint, JumpPointPlus };
+
     class PathfindingSystem : public System
     {
     public:
@@ -103,6 +115,29 @@ namespace Engine
         /**************************************************************************/
         void setGoal(int x, int y);
 
+        /**************************************************************************/
+        /*!
+        \brief Set the search algorithm used by the next call to findShortestPath.
+
+        \param[in] mode
+        The query mode to use.
+
+        */
+        /**************************************************************************/
+        void setQueryMode(PathQueryMode mode);
+
+        /**************************************************************************/
+        /*!
+        \brief Set the radius of the unit the next call to findShortestPath searches
+        for. Paths only cross cells with more clearance than the radius.
+
+        \param[in] radius
+        The radius of the unit in cells. 0 for units that fit through any gap.
+
+        */
+        /**************************************************************************/
+        void setClearance(int radius);
+
         /**************************************************************************/
         /*!
         \brief Find the shortest path between the set starting and goal points on the grid.
@@ -188,6 +223,152 @@ namespace Engine
         /**************************************************************************/
         std::pair<int, int> getClosestPair(int startPosX, int startPosY, const std::vector<std::pair<int, int>>& towerPositions, int unitNum);
 
+        /**************************************************************************/
+        /*!
+        \brief Gets the version of the navigation map. The version is bumped every
+        time the logical collision map is rebuilt.
+
+        \return
+        The current navigation map version.
+        */
+        /**************************************************************************/
+        static unsigned int GetNavMapVersion();
+
+        /**************************************************************************/
+        /*!
+        \brief Gets the bit-packed collision map. Cell (0, 0) is the bottom left
+        corner of the window.
+
+        \return
+        A reference to the collision map.
+        */
+        /**************************************************************************/
+        static const OccupancyGrid& GetCollisionMap();
+
+        /*!
+        \brief Gets how long the last collision map rebuild took.
+        \return The build time in milliseconds.
+        */
+        static double GetCollisionMapBuildMs();
+
+        /**************************************************************************/
+        /*!
+        \brief Gets the cache of computed paths shared by every pathfinding query.
+
+        \return
+        A reference to the path cache.
+        */
+        /**************************************************************************/
+        static PathCache& GetPathCache();
+
+        /**************************************************************************/
+        /*!
+        \brief Gets the hierarchical pathfinder used by PathQueryMode::Hierarchical queries.
+
+        \return
+        A reference to the hierarchical pathfinder.
+        */
+        /**************************************************************************/
+        static const HierarchicalPathfinder& GetHierarchicalPathfinder();
+
+        /**************************************************************************/
+        /*!
+        \brief Gets the grid search used by the A* and jump point query modes.
+
+        \return
+        A reference to the jump point search.
+        */
+        /**************************************************************************/
+        static const JumpPointSearch& GetJumpPointSearch();
+
+        /**************************************************************************/
+        /*!
+        \brief Gets the distance field of the collision map, rebuilding it first if
+        the map changed since it was last built.
+
+        \return
+        A reference to the distance field.
+        */
+        /**************************************************************************/
+        static const DistanceField& GetDistanceField();
+
+        /**************************************************************************/
+        /*!
+        \brief Marks a rectangle of the navigation map as blocked or free at runtime.
+        The navigation map version is bumped and the hierarchical graph is updated
+        locally around the changed rectangle. Clearing a rectangle keeps the terrain
+        and the static colliders that overlap it blocked. Used when a tower or the
+        castle collider appears, moves or goes away.
+
+        \param[in] minX, minY
+        The lower corner of the rectangle in world coordinates.
+
+        \param[in] maxX, maxY
+        The upper corner of the rectangle in world coordinates.
+
+        \param[in] blocked
+        True to add an obstacle, false to clear it.
+        */
+        /**************************************************************************/
+        static void SetObstacle(int minX, int minY, int maxX, int maxY, bool blocked);
+
+        /**************************************************************************/
+        /*!
+        \brief Gets the queue that computes paths on worker threads.
+
+        \return
+        A reference to the path request queue.
+        */
+        /**************************************************************************/
+        static PathRequestQueue& GetPathRequestQueue();
+
+        /**************************************************************************/
+        /*!
+        \brief Turns asynchronous path requests on or off. When off, paths are
+        computed inside Update as before.
+
+        \param[in] enabled
+        True to compute paths on the worker threads.
+        */
+        /**************************************************************************/
+        static void SetAsyncPathfinding(bool enabled);
+
+        /*!
+        \brief Checks if paths are computed on the worker threads.
+        \return True if asynchronous path requests are on.
+        */
+        static bool IsAsyncPathfinding();
+
+        /**************************************************************************/
+        /*!
+        \brief Gets the local avoidance step run after the units follow their paths.
+
+        \return
+        A reference to the crowd avoidance.
+        */
+        /**************************************************************************/
+        static CrowdAvoidance& GetCrowdAvoidance();
+
+        /*!
+        \brief Turns crowd local avoidance on or off.
+        \param[in] enabled True to keep walking units apart.
+        */
+        static void SetCrowdAvoidance(bool enabled);
+
+        /*!
+        \brief Checks if crowd local avoidance is on.
+        \return True if walking units are kept apart.
+        */
+        static bool IsCrowdAvoidance();
+
+        /**************************************************************************/
+        /*!
+        \brief Stops the path request workers. Called once when the application
+        shuts down, before static objects are destroyed.
+        */
+        /**************************************************************************/
+        static void Shutdown();
+
         // ~PathfindingSystem();
 
     private:
@@ -240,6 +421,30 @@ namespace Engine
         /**************************************************************************/
         double distance(int x1, int y1, int x2, int y2);
 
+        /**************************************************************************/
+        /*!
+        \brief Connects a cached path to a start position inside the same cache cell.
+
+        \param[in] x
+        The x-coordinate of the requesting unit.
+
+        \param[in] y
+        The y-coordinate of the requesting unit.
+
+        \param[in,out] path
+        The cached path. On success (x, y) and at most one corner on the way to its first
+        point are prepended.
+
+        \return
+        \param[in] clearance
+        The radius of the unit in cells. Wider units only join through gaps they fit in.
+
+        \return
+        True if the start could be joined to the path without crossing an obstacle.
+        */
+        /**************************************************************************/
+        bool joinCachedPath(int x, int y, std::vector<std::pair<int, int>>& path, int clearance);
+
         int numRows = 0;
         int numCols = 0;
         int startX = 0;
@@ -249,6 +454,8 @@ namespace Engine
 
         bool initialized; // A flag to check if the pathfinder has been initialized
         bool isWalking;
+        PathQueryMode queryMode = PathQueryMode::Grid;
+        int clearance = 0;
     };
 }
 #endif ENGINE_PATHFINDING_H
\ No newline at end of file
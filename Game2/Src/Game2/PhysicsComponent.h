@@ -24,6 +24,7 @@ namespace Engine
 		VECTORMATH::Vector2D acceleration = VECTORMATH::Vector2D(0.f, 0.f);
 		float mass = 0.0;
 		float friction = 0.0;
+		int bodyHandle = -1; // Body in the physics world, assigned by the PhysicsSystem
 
 		/*!*****************************************************************
 
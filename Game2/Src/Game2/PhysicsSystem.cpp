@@ -20,6 +20,9 @@
 
 namespace Engine
 {      
+    // Bodies of every simulated entity, kept between steps
+    PhysicsWorld physicsWorld;
+
     // Constructor for the PhysicsSystem class.
     PhysicsSystem::PhysicsSystem()
         : x(0.0f), y(0.0f), velocityX(0.0f), velocityY(0.0f), accelerationX(0.0f), accelerationY(0.0f) {}
@@ -45,80 +48,30 @@ namespace Engine
     // Updates the object's position based on physics calculations.
     void PhysicsSystem::Update(std::unordered_map<EntityID, std::unique_ptr<Entity>>* entities) 
     {
-        // std::cout << "Physics Checking" << std::endl;
-        //for (int step = 0; step < currentNumberOfSteps; ++step)
-        //{
-            for (const auto& entityPair : *entities)
+        // Bodies persist between steps, the entities only tell the world which ones still exist
+        physicsWorld.BeginSync();
+        for (const auto& entityPair : *entities)
+        {
+            Entity* entity = entityPair.second.get();
+            if (entity->HasComponent(ComponentType::Transform) && (entity->HasComponent(ComponentType::Physics)) && (entity->HasComponent(ComponentType::Collision))
+                && !(entity->HasComponent(ComponentType::Pathfinding)))
             {
-                Entity* entity = entityPair.second.get();
+                CollisionComponent* collisionComponent = dynamic_cast<CollisionComponent*>(entity->GetComponent(ComponentType::Collision));
 
-                if (entity->HasComponent(ComponentType::Transform) && (entity->HasComponent(ComponentType::Physics)) && (entity->HasComponent(ComponentType::Collision))
-                    && !(entity->HasComponent(ComponentType::Pathfinding)))
+                if (collisionComponent->layer == Layer::World || collisionComponent->layer == Layer::Arrow) 
                 {
-                    CollisionComponent* collisionComponent = dynamic_cast<CollisionComponent*>(entity->GetComponent(ComponentType::Collision));
-                    // std::cout << "inside of if statement" << std::endl;
-
-                    if (collisionComponent->layer == Layer::World || collisionComponent->layer == Layer::Arrow) 
-                    {
-                        TransformComponent* transformComponent = dynamic_cast<TransformComponent*>(entity->GetComponent(ComponentType::Transform));
-                        PhysicsComponent* physicsComponent = dynamic_cast<PhysicsComponent*>(entity->GetComponent(ComponentType::Physics));
-
-                        Rigidbody rigidbody = createRigidbodyFromPhysicsComponent(physicsComponent, transformComponent);
-
-                        //std::cout << transformComponent->position.x << " " << transformComponent->position.y << std::endl;
-                        //std::cout << rigidbody.position.x << " " << rigidbody.position.y << std::endl;
-
-                        ////Store Local variables for processing
-                        //float previousX = transformComponent->position.x;
-                        //float previousY = transformComponent->position.y;
-
-                        // Update the Rigidbody
-                        rigidbody.update(fixedDeltaTime);
-
-                        // Update the entity's position based on the Rigidbody's position
-                        transformComponent->position.x = rigidbody.position.x;
-                        transformComponent->position.y = rigidbody.position.y;
-
-                        //float currentX = transformComponent->position.x;
-                        //float currentY = transformComponent->position.y;
-
-                        //float l_velocityX = physicsComponent->velocity.x;
-                        //float l_velocityY = physicsComponent->velocity.y;
-
-                        // Update the object's position using the equations of motion
-                        //l_velocityX += static_cast<float>(accelerationX * dt);
-                        //l_velocityY += static_cast<float>(accelerationY * dt);
-
-                        //currentX += static_cast<int>(l_velocityX * fixedDeltaTime);
-                        //currentY += static_cast<int>(l_velocityY * fixedDeltaTime);
-
-                        //if (entity->HasComponent(ComponentType::Collision))
-                        //{
-                        //    CollisionComponent* collisionComponent = dynamic_cast<CollisionComponent*>(entity->GetComponent(ComponentType::Collision));
-
-                        //    if (collisionComponent->isColliding)
-                        //    {
-                        //        //Update position to previous position (Stopping)
-                        //        transformComponent->position.x = previousX;
-                        //        transformComponent->position.y = previousY;
-
-                        //        physicsComponent->velocity.x = 0.0f;
-                        //        physicsComponent->velocity.y = 0.0f;
-
-                        //    }
-                        //    else
-                        //    {
-                        //        //Update position after acceleration model
-                        //        transformComponent->position.x = currentX;
-                        //        transformComponent->position.y = currentY;
-                        //        physicsComponent->velocity.x = l_velocityX;
-                        //        physicsComponent->velocity.y = l_velocityY;
-                        //    }
-                        //}
-                    }
+                    TransformComponent* transformComponent = dynamic_cast<TransformComponent*>(entity->GetComponent(ComponentType::Transform));
+                    PhysicsComponent* physicsComponent = dynamic_cast<PhysicsComponent*>(entity->GetComponent(ComponentType::Physics));
+                    physicsWorld.Bind(physicsComponent, transformComponent, collisionComponent);
                 }
             }
-        //}
+        }
+        physicsWorld.RemoveUnbound();
+
+        // Integrate the awake bodies in one pass, move only the transforms that changed, then let resting bodies sleep
+        physicsWorld.Step(static_cast<float>(fixedDeltaTime));
+        physicsWorld.WriteBack();
+        physicsWorld.UpdateSleep(static_cast<float>(fixedDeltaTime));
     }
 
     // Gets the x-coordinate of the object's position.
@@ -151,13 +104,8 @@ namespace Engine
         return accelerationY;
     }
 
-    Rigidbody PhysicsSystem::createRigidbodyFromPhysicsComponent(PhysicsComponent* physicsComponent, TransformComponent* transformComponent) {
-        return Rigidbody(
-            physicsComponent->mass,
-            VECTORMATH::Vec2(transformComponent->position.x, transformComponent->position.y),
-            VECTORMATH::Vec2(physicsComponent->velocity.x, physicsComponent->velocity.y),
-            VECTORMATH::Vec2(physicsComponent->acceleration.x, physicsComponent->acceleration.y),
-            physicsComponent->friction
-        );
+    PhysicsWorld& PhysicsSystem::GetPhysicsWorld()
+    {
+        return physicsWorld;
     }
 }
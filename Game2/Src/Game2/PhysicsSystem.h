@@ -15,6 +15,7 @@
 #include "Entity.h"
 #include "PhysicsComponent.h"
 #include "Body.h"
+#include "PhysicsWorld.h"
 
 namespace Engine
 {
@@ -140,13 +141,20 @@ namespace Engine
         /**************************************************************************/
         float getAccelerationY() const;
 
+        /**************************************************************************/
+        /*!
+        \brief Gets the physics world holding the body of every simulated entity.
+
+        \return
+        A reference to the physics world.
+        */
+        /**************************************************************************/
+        static PhysicsWorld& GetPhysicsWorld();
+
     private:
         float x, y;            // Position
         float velocityX, velocityY; // Velocity
         float accelerationX, accelerationY; // Acceleration
-
-        // Add a member variable for the Rigidbody object
-        Rigidbody createRigidbodyFromPhysicsComponent(PhysicsComponent* physicsComponent, TransformComponent* transformComponent);
     };
 }
 #endif ENGINE_PHYSICSSYSTEM_H
\ No newline at end of file
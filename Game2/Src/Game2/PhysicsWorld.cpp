@@ -0,0 +1,381 @@
+/******************************************************************************/
+/*!
+\file		PhysicsWorld.cpp
+\author		Ang Jun Sheng Aloysius, a.junshengaloysius, 2201807
+
+\par		a.junshengaloysius@digipen.edu
+
+\date		13/04/2024
+
+\brief		Contains the definitions of the physics world.
+Copyright (C) 2024 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+ */
+ /******************************************************************************/
+
+#include "pch.h"
+#include "PhysicsWorld.h"
+#include "Body.h"
+
+#if defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#include <emmintrin.h>
+#define PHYSICS_WORLD_SSE
+#endif
+
+namespace Engine
+{
+    void PhysicsWorld::BeginSync()
+    {
+        syncStart = std::chrono::high_resolution_clock::now();
+        ++currentSync;
+    }
+
+    int PhysicsWorld::IndexOf(BodyHandle handle) const
+    {
+        if (handle < 0 || handle >= static_cast<int>(handleToIndex.size()))
+        {
+            return -1;
+        }
+        return handleToIndex[handle];
+    }
+
+    int PhysicsWorld::AddBody(float x, float y, float _velocityX, float _velocityY, float mass)
+    {
+        BodyHandle handle;
+        if (!freeHandles.empty())
+        {
+            handle = freeHandles.back();
+            freeHandles.pop_back();
+        }
+        else
+        {
+            handle = static_cast<BodyHandle>(handleToIndex.size());
+            handleToIndex.push_back(-1);
+        }
+
+        int index = GetBodyCount();
+        handleToIndex[handle] = index;
+        indexToHandle.push_back(handle);
+
+        positionX.push_back(x);
+        positionY.push_back(y);
+        velocityX.push_back(_velocityX);
+        velocityY.push_back(_velocityY);
+        forceX.push_back(0.0f);
+        forceY.push_back(0.0f);
+        // Massless bodies ignore forces
+        inverseMass.push_back(mass > 0.0f ? 1.0f / mass : 0.0f);
+        moved.push_back(0);
+        restTime.push_back(0.0f);
+
+        physicsComponents.push_back(nullptr);
+        transforms.push_back(nullptr);
+        collisions.push_back(nullptr);
+        syncedX.push_back(x);
+        syncedY.push_back(y);
+        syncedVelocityX.push_back(_velocityX);
+        syncedVelocityY.push_back(_velocityY);
+        boundSync.push_back(currentSync);
+
+        // New bodies start awake
+        SwapBodies(index, awakeCount);
+        return awakeCount++;
+    }
+
+    void PhysicsWorld::SwapBodies(int first, int second)
+    {
+        if (first == second)
+        {
+            return;
+        }
+        ForEachArray([first, second](auto& values) { std::swap(values[first], values[second]); });
+        handleToIndex[indexToHandle[first]] = first;
+        handleToIndex[indexToHandle[second]] = second;
+    }
+
+    void PhysicsWorld::RemoveAt(int index)
+    {
+        // Keep the awake bodies packed in front, then move the body to the end
+        if (index < awakeCount)
+        {
+            --awakeCount;
+            SwapBodies(index, awakeCount);
+            index = awakeCount;
+        }
+        int last = GetBodyCount() - 1;
+        SwapBodies(index, last);
+
+        freeHandles.push_back(indexToHandle[last]);
+        handleToIndex[indexToHandle[last]] = -1;
+        ForEachArray([](auto& values) { values.pop_back(); });
+    }
+
+    int PhysicsWorld::WakeAt(int index)
+    {
+        collisions[index]->Wake();
+        restTime[index] = 0.0f;
+        if (index < awakeCount)
+        {
+            return index;
+        }
+        SwapBodies(index, awakeCount);
+        return awakeCount++;
+    }
+
+    int PhysicsWorld::SleepAt(int index)
+    {
+        // Come to a full stop so nothing drifts while asleep
+        velocityX[index] = velocityY[index] = 0.0f;
+        physicsComponents[index]->velocity.x = syncedVelocityX[index] = 0.0f;
+        physicsComponents[index]->velocity.y = syncedVelocityY[index] = 0.0f;
+        collisions[index]->sleeping = true;
+        moved[index] = 0;
+
+        --awakeCount;
+        SwapBodies(index, awakeCount);
+        return awakeCount;
+    }
+
+    void PhysicsWorld::Bind(PhysicsComponent* physics, TransformComponent* transform, CollisionComponent* collision)
+    {
+        int index = IndexOf(physics->bodyHandle);
+        if (index < 0 || physicsComponents[index] != physics)
+        {
+            index = AddBody(transform->position.x, transform->position.y, physics->velocity.x, physics->velocity.y, physics->mass);
+            physics->bodyHandle = indexToHandle[index];
+        }
+
+        physicsComponents[index] = physics;
+        transforms[index] = transform;
+        collisions[index] = collision;
+        boundSync[index] = currentSync;
+
+        // Scripts and the editor move transforms and set velocities directly
+        bool edited = false;
+        if (transform->position.x != syncedX[index] || transform->position.y != syncedY[index])
+        {
+            positionX[index] = syncedX[index] = transform->position.x;
+            positionY[index] = syncedY[index] = transform->position.y;
+            edited = true;
+        }
+        if (physics->velocity.x != syncedVelocityX[index] || physics->velocity.y != syncedVelocityY[index])
+        {
+            velocityX[index] = syncedVelocityX[index] = physics->velocity.x;
+            velocityY[index] = syncedVelocityY[index] = physics->velocity.y;
+            edited = true;
+        }
+
+        // The collision system clears the flag when something touches a sleeping body
+        if (edited || (index >= awakeCount && !collision->sleeping))
+        {
+            index = WakeAt(index);
+        }
+        collision->sleeping = index >= awakeCount;
+        inverseMass[index] = physics->mass > 0.0f ? 1.0f / physics->mass : 0.0f;
+    }
+
+    void PhysicsWorld::RemoveUnbound()
+    {
+        for (int index = GetBodyCount() - 1; index >= 0; --index)
+        {
+            if (boundSync[index] != currentSync)
+            {
+                RemoveAt(index);
+            }
+        }
+    }
+
+    void PhysicsWorld::Step(float timeStep)
+    {
+        auto stepStart = std::chrono::high_resolution_clock::now();
+        // Sleeping bodies are behind the awake ones and skipped entirely
+        int count = awakeCount;
+        float* px = positionX.data();
+        float* py = positionY.data();
+        float* vx = velocityX.data();
+        float* vy = velocityY.data();
+        float* fx = forceX.data();
+        float* fy = forceY.data();
+        const float* invMass = inverseMass.data();
+        uint8_t* movedFlags = moved.data();
+
+        // v += F / m dt, p += v dt. The old Rigidbody ignored the component acceleration and only
+        // damped a velocity it threw away, so friction never slowed a body down and is left out
+        int i = 0;
+#ifdef PHYSICS_WORLD_SSE
+        const __m128 dt = _mm_set1_ps(timeStep);
+        const __m128 zero = _mm_setzero_ps();
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128 m = _mm_loadu_ps(invMass + i);
+            __m128 newVX = _mm_add_ps(_mm_loadu_ps(vx + i), _mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(fx + i), m), dt));
+            __m128 newVY = _mm_add_ps(_mm_loadu_ps(vy + i), _mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(fy + i), m), dt));
+
+            __m128 oldX = _mm_loadu_ps(px + i);
+            __m128 oldY = _mm_loadu_ps(py + i);
+            __m128 newX = _mm_add_ps(oldX, _mm_mul_ps(newVX, dt));
+            __m128 newY = _mm_add_ps(oldY, _mm_mul_ps(newVY, dt));
+            _mm_storeu_ps(px + i, newX);
+            _mm_storeu_ps(py + i, newY);
+
+            _mm_storeu_ps(vx + i, newVX);
+            _mm_storeu_ps(vy + i, newVY);
+            _mm_storeu_ps(fx + i, zero);
+            _mm_storeu_ps(fy + i, zero);
+
+            int movedMask = _mm_movemask_ps(_mm_or_ps(_mm_cmpneq_ps(newX, oldX), _mm_cmpneq_ps(newY, oldY)));
+            movedFlags[i] = static_cast<uint8_t>(movedMask & 1);
+            movedFlags[i + 1] = static_cast<uint8_t>((movedMask >> 1) & 1);
+            movedFlags[i + 2] = static_cast<uint8_t>((movedMask >> 2) & 1);
+            movedFlags[i + 3] = static_cast<uint8_t>((movedMask >> 3) & 1);
+        }
+#endif
+        for (; i < count; ++i)
+        {
+            float newVX = vx[i] + fx[i] * invMass[i] * timeStep;
+            float newVY = vy[i] + fy[i] * invMass[i] * timeStep;
+            float newX = px[i] + newVX * timeStep;
+            float newY = py[i] + newVY * timeStep;
+            movedFlags[i] = static_cast<uint8_t>(newX != px[i] || newY != py[i]);
+            px[i] = newX;
+            py[i] = newY;
+            vx[i] = newVX;
+            vy[i] = newVY;
+            fx[i] = 0.0f;
+            fy[i] = 0.0f;
+        }
+
+        stats.bodies = GetBodyCount();
+        stats.lastStepMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - stepStart).count();
+    }
+
+    void PhysicsWorld::WriteBack()
+    {
+        int movedCount = 0;
+        for (int index = 0; index < awakeCount; ++index)
+        {
+            if (!moved[index])
+            {
+                continue;
+            }
+
+            transforms[index]->position.x = syncedX[index] = positionX[index];
+            transforms[index]->position.y = syncedY[index] = positionY[index];
+            physicsComponents[index]->velocity.x = syncedVelocityX[index] = velocityX[index];
+            physicsComponents[index]->velocity.y = syncedVelocityY[index] = velocityY[index];
+            ++movedCount;
+        }
+        stats.moved = movedCount;
+        stats.lastSyncMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - syncStart).count() - stats.lastStepMs;
+    }
+
+    void PhysicsWorld::UpdateSleep(float timeStep)
+    {
+        const float sleepSpeedSquared = settings.sleepSpeed * settings.sleepSpeed;
+
+        // Walk backwards so a body put to sleep is swapped with one already checked
+        for (int index = awakeCount - 1; index >= 0; --index)
+        {
+            bool resting = velocityX[index] * velocityX[index] + velocityY[index] * velocityY[index] <= sleepSpeedSquared
+                && !collisions[index]->isColliding;
+            restTime[index] = resting ? restTime[index] + timeStep : 0.0f;
+            if (restTime[index] >= settings.sleepTime)
+            {
+                SleepAt(index);
+            }
+        }
+
+        stats.awake = awakeCount;
+        stats.sleeping = GetBodyCount() - awakeCount;
+    }
+
+    void PhysicsWorld::ApplyForce(BodyHandle handle, float _forceX, float _forceY)
+    {
+        int index = IndexOf(handle);
+        if (index >= 0)
+        {
+            index = WakeAt(index);
+            forceX[index] += _forceX;
+            forceY[index] += _forceY;
+        }
+    }
+
+    void PhysicsWorld::ApplyImpulse(BodyHandle handle, float impulseX, float impulseY)
+    {
+        int index = IndexOf(handle);
+        if (index >= 0)
+        {
+            index = WakeAt(index);
+            velocityX[index] += impulseX * inverseMass[index];
+            velocityY[index] += impulseY * inverseMass[index];
+        }
+    }
+
+    void PhysicsWorld::Clear()
+    {
+        while (GetBodyCount() > 0)
+        {
+            RemoveAt(GetBodyCount() - 1);
+        }
+    }
+
+    PhysicsWorld::BenchmarkResult PhysicsWorld::RunBenchmark(int bodyCount, int steps)
+    {
+        const float TIME_STEP = 1.0f / 60.0f;
+        BenchmarkResult result;
+        result.bodies = bodyCount;
+        if (steps <= 0)
+        {
+            return result;
+        }
+
+        // Arrow-like bodies flying in every direction
+        std::vector<PhysicsComponent> physics(bodyCount);
+        std::vector<TransformComponent> transforms(bodyCount);
+        std::vector<CollisionComponent> collisions(bodyCount);
+        for (int i = 0; i < bodyCount; ++i)
+        {
+            physics[i].velocity = VECTORMATH::Vector2D(static_cast<float>(i % 200) - 100.0f, static_cast<float>(i % 150) - 75.0f);
+            physics[i].mass = 0.001f;
+            physics[i].friction = (i % 4) * 0.1f;
+            transforms[i].position = VECTORMATH::Vector2D(static_cast<float>(i % 1280) - 640.0f, static_cast<float>(i % 720) - 360.0f);
+        }
+
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int step = 0; step < steps; ++step)
+        {
+            for (int i = 0; i < bodyCount; ++i)
+            {
+                Rigidbody rigidbody(physics[i].mass,
+                    VECTORMATH::Vec2(transforms[i].position.x, transforms[i].position.y),
+                    VECTORMATH::Vec2(physics[i].velocity.x, physics[i].velocity.y),
+                    VECTORMATH::Vec2(physics[i].acceleration.x, physics[i].acceleration.y),
+                    physics[i].friction);
+                rigidbody.update(TIME_STEP);
+                transforms[i].position.x = rigidbody.position.x;
+                transforms[i].position.y = rigidbody.position.y;
+            }
+        }
+        result.rigidbodyMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count() / steps;
+
+        // The same work PhysicsSystem does every step, so the component sync is counted too
+        PhysicsWorld world;
+        start = std::chrono::high_resolution_clock::now();
+        for (int step = 0; step < steps; ++step)
+        {
+            world.BeginSync();
+            for (int i = 0; i < bodyCount; ++i)
+            {
+                world.Bind(&physics[i], &transforms[i], &collisions[i]);
+            }
+            world.RemoveUnbound();
+            world.Step(TIME_STEP);
+            world.WriteBack();
+            world.UpdateSleep(TIME_STEP);
+        }
+        result.worldMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count() / steps;
+        return result;
+    }
+}
@@ -0,0 +1,252 @@
+/******************************************************************************/
+/*!
+\file		PhysicsWorld.h
+\author		Ang Jun Sheng Aloysius, a.junshengaloysius, 2201807
+
+\par		a.junshengaloysius@digipen.edu
+
+\date		13/04/2024
+
+\brief		Contains the declaration of the physics world. Bodies live in
+			separate arrays of positions, velocities, forces and inverse
+			masses so one vectorized pass integrates all of them.
+			Velocity and force state persists between steps, and positions are
+			written back to the transform only for bodies that moved.
+			Bodies that come to rest fall asleep and are kept behind the
+			awake ones, so the step only walks the awake prefix.
+Copyright (C) 2024 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+ */
+ /******************************************************************************/
+#ifndef ENGINE_PHYSICSWORLD_H
+#define ENGINE_PHYSICSWORLD_H
+
+#include <vector>
+#include <cstdint>
+#include <chrono>
+#include "TransformComponent.h"
+#include "PhysicsComponent.h"
+#include "CollisionComponent.h"
+
+namespace Engine
+{
+    class PhysicsWorld
+    {
+    public:
+        // Stable handle of a body, stored in its PhysicsComponent. -1 is never valid
+        using BodyHandle = int;
+
+        /*!
+        \brief When a body is considered at rest. A body slower than sleepSpeed
+        and touching nothing for sleepTime seconds sleeps.
+        */
+        struct Settings
+        {
+            float sleepSpeed = 1.0f;
+            float sleepTime = 0.5f;
+        };
+
+        /*!
+        \brief Counters describing the last step.
+        */
+        struct Stats
+        {
+            int bodies = 0;
+            int awake = 0;
+            int sleeping = 0;
+            int moved = 0;              // Bodies written back to their transform
+            double lastStepMs = 0.0;    // Integration only
+            double lastSyncMs = 0.0;    // Binding the components and writing back
+        };
+
+        /*!
+        \brief Timing of RunBenchmark.
+        */
+        struct BenchmarkResult
+        {
+            int bodies = 0;
+            double rigidbodyMs = 0.0;   // A temporary Rigidbody per body per step
+            double worldMs = 0.0;       // Binding the components, one Step of the world and writing back
+        };
+
+        /**************************************************************************/
+        /*!
+        \brief Starts a new sync. Every body not bound again before RemoveUnbound
+        is removed.
+        */
+        /**************************************************************************/
+        void BeginSync();
+
+        /**************************************************************************/
+        /*!
+        \brief Binds a physics component to its body, creating the body on the first
+        call. Positions and velocities changed outside the physics since the last
+        write back are picked up and wake the body, as does the collision system
+        clearing the sleeping flag on contact.
+
+        \param[in] physics
+        The physics component. Its body handle is updated.
+
+        \param[in] transform
+        The transform the body position is written to.
+
+        \param[in] collision
+        The collider of the body, which holds its sleeping flag.
+        */
+        /**************************************************************************/
+        void Bind(PhysicsComponent* physics, TransformComponent* transform, CollisionComponent* collision);
+
+        /**************************************************************************/
+        /*!
+        \brief Removes the bodies not bound since BeginSync, such as those of
+        destroyed entities.
+        */
+        /**************************************************************************/
+        void RemoveUnbound();
+
+        /**************************************************************************/
+        /*!
+        \brief Integrates every awake body with semi-implicit Euler and clears the
+        forces. Like the old Rigidbody update, only forces change the velocity, the
+        component acceleration and friction are not applied.
+
+        \param[in] timeStep
+        The step in seconds.
+        */
+        /**************************************************************************/
+        void Step(float timeStep);
+
+        /**************************************************************************/
+        /*!
+        \brief Writes the positions and velocities of the bodies that moved in the
+        last step back to their components.
+        */
+        /**************************************************************************/
+        void WriteBack();
+
+        /**************************************************************************/
+        /*!
+        \brief Puts the bodies that stayed at rest long enough to sleep.
+
+        \param[in] timeStep
+        The step in seconds.
+        */
+        /**************************************************************************/
+        void UpdateSleep(float timeStep);
+
+        /*!
+        \brief Adds a force applied on the next step, waking the body.
+        \param[in] handle The body.
+        \param[in] forceX, forceY The force.
+        */
+        void ApplyForce(BodyHandle handle, float forceX, float forceY);
+
+        /*!
+        \brief Changes the velocity of a body immediately, waking it.
+        \param[in] handle The body.
+        \param[in] impulseX, impulseY The impulse.
+        */
+        void ApplyImpulse(BodyHandle handle, float impulseX, float impulseY);
+
+        /*!
+        \brief Removes every body.
+        */
+        void Clear();
+
+        int GetBodyCount() const { return static_cast<int>(positionX.size()); }
+        int GetAwakeCount() const { return awakeCount; }
+
+        void SetSettings(const Settings& _settings) { settings = _settings; }
+        const Settings& GetSettings() const { return settings; }
+
+        /*!
+        \brief Gets the counters of the last step.
+        \return A reference to the statistics.
+        */
+        const Stats& GetStats() const { return stats; }
+
+        /**************************************************************************/
+        /*!
+        \brief Times integrating free-moving bodies through temporary Rigidbody
+        objects, as PhysicsSystem used to, against a full step of the world
+        including binding the components and writing the results back.
+
+        \param[in] bodyCount
+        The number of bodies.
+
+        \param[in] steps
+        The number of steps timed.
+
+        \return
+        The average time per step of each approach.
+        */
+        /**************************************************************************/
+        static BenchmarkResult RunBenchmark(int bodyCount, int steps);
+
+    private:
+        // Index into the arrays below, or -1 if the handle is not in use
+        int IndexOf(BodyHandle handle) const;
+        int AddBody(float x, float y, float velocityX, float velocityY, float mass);
+        void RemoveAt(int index);
+        void SwapBodies(int first, int second);
+        // Both return the new index of the body
+        int WakeAt(int index);
+        int SleepAt(int index);
+
+        // Calls function on every per-body array, so moving a body moves all of its fields
+        template <typename Function>
+        void ForEachArray(Function function)
+        {
+            function(indexToHandle);
+            function(positionX);
+            function(positionY);
+            function(velocityX);
+            function(velocityY);
+            function(forceX);
+            function(forceY);
+            function(inverseMass);
+            function(moved);
+            function(restTime);
+            function(physicsComponents);
+            function(transforms);
+            function(collisions);
+            function(syncedX);
+            function(syncedY);
+            function(syncedVelocityX);
+            function(syncedVelocityY);
+            function(boundSync);
+        }
+
+        Settings settings;
+        Stats stats;
+
+        // Bodies [0, awakeCount) are awake, the rest sleep
+        int awakeCount = 0;
+
+        // Body data, one array per field
+        std::vector<float> positionX, positionY;
+        std::vector<float> velocityX, velocityY;
+        std::vector<float> forceX, forceY;
+        std::vector<float> inverseMass;
+        std::vector<uint8_t> moved;
+        std::vector<float> restTime;    // Seconds spent at rest while awake
+
+        // Components of each body and the values last written to them, to notice outside changes
+        std::vector<PhysicsComponent*> physicsComponents;
+        std::vector<TransformComponent*> transforms;
+        std::vector<CollisionComponent*> collisions;
+        std::vector<float> syncedX, syncedY;
+        std::vector<float> syncedVelocityX, syncedVelocityY;
+        std::vector<unsigned int> boundSync;
+        unsigned int currentSync = 0;
+        std::chrono::high_resolution_clock::time_point syncStart;
+
+        // Handles stay the same when bodies are swapped to fill a removed one
+        std::vector<int> handleToIndex;
+        std::vector<BodyHandle> indexToHandle;
+        std::vector<BodyHandle> freeHandles;
+    };
+}
+#endif ENGINE_PHYSICSWORLD_H
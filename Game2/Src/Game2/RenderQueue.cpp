@@ -0,0 +1,172 @@
+/******************************************************************************/
+/*!
+\file		RenderQueue.cpp
+\author 	Wayne Kwok Jun Lin
+\par    	email: k.junlinwayne@digipen.edu
+\date   	April 15, 2024
+\brief		This file contains the implementation of the RenderQueue class.
+Copyright (C) 2024 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the prior
+written consent of DigiPen Institute of Technology is prohibited.
+ */
+ /******************************************************************************/
+#include "pch.h"
+#include "RenderQueue.h"
+#include "SpriteBatch.h"
+#include <chrono>
+#include <random>
+#include <cstring>
+
+namespace
+{
+    // 11-bit digits sort the widest keys in 6 passes instead of 8
+    const int RADIX_BITS = 11;
+    const int RADIX_BUCKETS = 1 << RADIX_BITS;
+    const int RADIX_MAX_PASSES = (64 + RADIX_BITS - 1) / RADIX_BITS;
+
+    uint64_t Field(uint32_t value, int bits, int shift)
+    {
+        uint32_t maxValue = (1u << bits) - 1u;
+        return static_cast<uint64_t>(std::min(value, maxValue)) << shift;
+    }
+}
+
+uint64_t RenderQueue::MakeKey(RenderLayer layer, uint32_t depth, uint32_t shader, uint32_t texture, uint32_t material)
+{
+    return Field(static_cast<uint32_t>(layer), 8, 56)
+        | Field(depth, 24, 32)
+        | Field(shader, 8, 24)
+        | Field(texture, 16, 8)
+        | Field(material, 8, 0);
+}
+
+void RenderQueue::Submit(uint64_t key, const RenderCommand& command)
+{
+    Buffer& buffer = buffers[submitIndex];
+    buffer.keys.push_back(key);
+    buffer.commands.push_back(command);
+}
+
+void RenderQueue::Swap()
+{
+    submitIndex = 1 - submitIndex;
+    buffers[submitIndex].keys.clear();
+    buffers[submitIndex].commands.clear();
+}
+
+void RenderQueue::Execute(SpriteBatch& batch)
+{
+    auto start = std::chrono::high_resolution_clock::now();
+    const Buffer& buffer = buffers[1 - submitIndex];
+
+    RadixSort(buffer.keys, sorted, scratch);
+    auto sortEnd = std::chrono::high_resolution_clock::now();
+
+    stats = Stats();
+    unsigned int previousTexture = 0;
+    for (const SortEntry& entry : sorted)
+    {
+        const RenderCommand& command = buffer.commands[entry.index];
+        if (command.textureID != previousTexture)
+        {
+            ++stats.textureChanges;
+            previousTexture = command.textureID;
+        }
+        batch.Submit(command.transform, command.textureID, command.uvRect, command.color, command.sheet, command.frame);
+    }
+
+    auto end = std::chrono::high_resolution_clock::now();
+    stats.commands = static_cast<int>(sorted.size());
+    stats.sortMs = std::chrono::duration<double, std::milli>(sortEnd - start).count();
+    stats.executeMs = std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+void RenderQueue::RadixSort(const std::vector<uint64_t>& keys, std::vector<SortEntry>& sorted, std::vector<SortEntry>& scratch)
+{
+    const size_t count = keys.size();
+    sorted.resize(count);
+    scratch.resize(count);
+
+    // Only the bits that differ between keys can change the order
+    uint64_t anyBits = 0;
+    uint64_t allBits = ~0ull;
+    for (size_t i = 0; i < count; ++i)
+    {
+        uint64_t key = keys[i];
+        sorted[i] = { key, static_cast<uint32_t>(i) };
+        anyBits |= key;
+        allBits &= key;
+    }
+    const uint64_t varying = anyBits ^ allBits;
+    if (count < 2 || varying == 0)
+    {
+        return;
+    }
+
+    // Each digit starts at the next varying bit, so runs of bits every key shares are skipped
+    int shifts[RADIX_MAX_PASSES];
+    int passes = 0;
+    for (int shift = 0; shift < 64; shift += RADIX_BITS)
+    {
+        while (shift < 64 && ((varying >> shift) & 1) == 0)
+        {
+            ++shift;
+        }
+        if (shift < 64)
+        {
+            shifts[passes++] = shift;
+        }
+    }
+
+    // Count every digit in one pass over the keys
+    uint32_t histograms[RADIX_MAX_PASSES][RADIX_BUCKETS];
+    std::memset(histograms, 0, sizeof(histograms[0]) * passes);
+    for (const SortEntry& entry : sorted)
+    {
+        for (int pass = 0; pass < passes; ++pass)
+        {
+            ++histograms[pass][(entry.key >> shifts[pass]) & (RADIX_BUCKETS - 1)];
+        }
+    }
+
+    for (int pass = 0; pass < passes; ++pass)
+    {
+        uint32_t* histogram = histograms[pass];
+        const int shift = shifts[pass];
+
+        uint32_t offset = 0;
+        for (int bucket = 0; bucket < RADIX_BUCKETS; ++bucket)
+        {
+            uint32_t bucketCount = histogram[bucket];
+            histogram[bucket] = offset;
+            offset += bucketCount;
+        }
+
+        for (const SortEntry& entry : sorted)
+        {
+            scratch[histogram[(entry.key >> shift) & (RADIX_BUCKETS - 1)]++] = entry;
+        }
+        sorted.swap(scratch);
+    }
+}
+
+double RenderQueue::RunBenchmark(int count, int runs)
+{
+    std::mt19937 random(1234);
+    std::vector<uint64_t> keys(std::max(0, count));
+    std::vector<SortEntry> sorted, scratch;
+    double totalMs = 0.0;
+    for (int run = 0; run < runs; ++run)
+    {
+        // Keys as the game makes them: a few layers, entity IDs as depths, a few dozen textures
+        for (uint64_t& key : keys)
+        {
+            key = MakeKey(static_cast<RenderLayer>(random() % 4), random() % 4096, 0, random() % 64, 0);
+        }
+        auto start = std::chrono::high_resolution_clock::now();
+        RadixSort(keys, sorted, scratch);
+        auto end = std::chrono::high_resolution_clock::now();
+        totalMs += std::chrono::duration<double, std::milli>(end - start).count();
+    }
+    return runs > 0 ? totalMs / runs : 0.0;
+}
@@ -0,0 +1,136 @@
+/******************************************************************************/
+/*!
+\file		RenderQueue.h
+\author 	Wayne Kwok Jun Lin
+\par    	email: k.junlinwayne@digipen.edu
+\date   	April 15, 2024
+\brief		This file contains the declaration of the RenderQueue class, which
+            splits drawing into submission and execution. Systems push draw
+            commands tagged with a 64-bit sort key, and execution radix-sorts
+            the keys and replays the commands into the sprite batch in order.
+            The queue keeps two command buffers so submission of the next
+            frame can fill one while the other is executed.
+
+Copyright (C) 2024 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the prior
+written consent of DigiPen Institute of Technology is prohibited.
+ */
+ /******************************************************************************/
+#ifndef ENGINE_RENDERQUEUE_H
+#define ENGINE_RENDERQUEUE_H
+
+#include <vector>
+#include <cstdint>
+#include "glm/glm.hpp"
+#include "Transform2D.h"
+
+class SpriteBatch;
+
+// Layers drawn back to front, the highest bits of the sort key
+enum class RenderLayer : uint8_t { Background, World, Effects, Interface };
+
+// One sprite to draw
+struct RenderCommand
+{
+    Transform2D transform;
+    glm::vec4 uvRect = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f);
+    glm::vec4 color = glm::vec4(1.0f);
+    unsigned int textureID = 0;
+    int sheet = -1;         // Sprite sheet drawn instead of uvRect, see SpriteSheetTable
+    int frame = 0;
+};
+
+// Collects draw commands and replays them sorted by key.
+class RenderQueue
+{
+public:
+    // Counters of the last execution
+    struct Stats
+    {
+        int commands = 0;
+        int textureChanges = 0;     // Consecutive commands using different textures after sorting
+        double sortMs = 0.0;
+        double executeMs = 0.0;     // Sorting and replaying
+    };
+
+    /*!
+     * \brief Packs the sort key of a command. Commands are drawn in increasing key order.
+     *
+     * Bits 56-63 hold the layer, 32-55 the depth within the layer, 24-31 the shader,
+     * 8-23 the texture and 0-7 the material, so commands at the same depth are grouped
+     * by shader, then texture, then material. Values wider than their field are clamped.
+     *
+     * \param layer The layer of the command.
+     * \param depth The position within the layer, smaller first.
+     * \param shader The shader the command is drawn with.
+     * \param texture The texture the command samples.
+     * \param material Any remaining state, such as the blend mode.
+     * \return The sort key.
+     */
+    static uint64_t MakeKey(RenderLayer layer, uint32_t depth, uint32_t shader, uint32_t texture, uint32_t material);
+
+    /*!
+     * \brief Adds a command to the submission buffer.
+     * \param key The sort key made with MakeKey.
+     * \param command The sprite to draw.
+     */
+    void Submit(uint64_t key, const RenderCommand& command);
+
+    /*!
+     * \brief Makes the submitted commands the ones Execute draws and empties the submission buffer.
+     */
+    void Swap();
+
+    /*!
+     * \brief Sorts the commands of the execution buffer and submits them to a sprite batch.
+     * \param batch The sprite batch, between its Begin and End.
+     */
+    void Execute(SpriteBatch& batch);
+
+    /*!
+     * \brief Gets the counters of the last execution.
+     * \return A reference to the statistics.
+     */
+    const Stats& GetStats() const { return stats; }
+
+    // A key and the index of its command, moved together so each pass reads memory in order
+    struct SortEntry
+    {
+        uint64_t key;
+        uint32_t index;
+    };
+
+    /*!
+     * \brief Sorts keys with an 11-bit least significant digit radix sort.
+     *
+     * Digits start at the lowest bit that differs between keys, and digits where
+     * every key has the same bits are skipped.
+     *
+     * \param keys The keys to sort.
+     * \param sorted Filled with the keys and their indices in sorted order. Equal keys keep their order.
+     * \param scratch Working memory, kept by the caller so it is not reallocated every sort.
+     */
+    static void RadixSort(const std::vector<uint64_t>& keys, std::vector<SortEntry>& sorted, std::vector<SortEntry>& scratch);
+
+    /*!
+     * \brief Times RadixSort on random keys spread over the layers, entity IDs and textures.
+     * \param count The number of keys.
+     * \param runs The number of sorts timed.
+     * \return The average time per sort in milliseconds.
+     */
+    static double RunBenchmark(int count, int runs);
+
+private:
+    struct Buffer
+    {
+        std::vector<uint64_t> keys;
+        std::vector<RenderCommand> commands;
+    };
+
+    Buffer buffers[2];
+    int submitIndex = 0;    // The other buffer is executed
+    std::vector<SortEntry> sorted;
+    std::vector<SortEntry> scratch;
+    Stats stats;
+};
+#endif ENGINE_RENDERQUEUE_H
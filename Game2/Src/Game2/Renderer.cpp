@@ -15,9 +15,58 @@
 
 #include "pch.h"
 #include "Renderer.h"
+#include "GLState.h"
 #include <iostream>
 #include <GLFW/glfw3.h>
 
+namespace
+{
+    GLErrorStats errorStats;
+
+#if ENGINE_GL_ERROR_CHECKS
+    const char* DebugSeverityName(GLenum severity)
+    {
+        switch (severity)
+        {
+        case GL_DEBUG_SEVERITY_HIGH: return "high";
+        case GL_DEBUG_SEVERITY_MEDIUM: return "medium";
+        case GL_DEBUG_SEVERITY_LOW: return "low";
+        default: return "notification";
+        }
+    }
+
+    void GLAPIENTRY DebugMessageCallback(GLenum source, GLenum type, GLuint id, GLenum severity,
+        GLsizei length, const GLchar* message, const void* userParam)
+    {
+        (void)source; (void)length; (void)userParam;
+        if (severity == GL_DEBUG_SEVERITY_NOTIFICATION)
+            return;
+
+        ++errorStats.debugMessages;
+        if (type == GL_DEBUG_TYPE_ERROR)
+            ++errorStats.errors;
+
+        // Messages may arrive after later calls were made, so the call site is only a hint
+        const GLErrorCheck::CallSite& call = GLErrorCheck::lastCall;
+        std::cout << "[OpenGL Debug] (" << id << ", " << DebugSeverityName(severity) << "): " << message;
+        if (call.function)
+            std::cout << " near " << call.function << " " << call.file << ":" << call.line;
+        std::cout << std::endl;
+    }
+#endif
+}
+
+#if ENGINE_GL_ERROR_CHECKS
+namespace GLErrorCheck
+{
+    GLErrorPolicy policy = GLErrorPolicy::EveryCall;
+    unsigned int sampleInterval = 64;
+    unsigned int callCount = 0;
+    bool sampling = false;
+    CallSite lastCall = { nullptr, nullptr, 0 };
+}
+#endif
+
 void GLClearError()
 {
     while (glGetError()); // Clear OpenGL errors
@@ -25,8 +74,10 @@ void GLClearError()
 
 bool GLLogCall(const char* function, const char* file, int line)
 {
+    ++errorStats.checks;
     while (GLenum error = glGetError())
     {
+        ++errorStats.errors;
         std::cout << "[OpenGL Error] (" << error << "):" << function << " " <<
             file << ":" << line << std::endl;
         return false; // GL call was not successful
@@ -34,6 +85,88 @@ bool GLLogCall(const char* function, const char* file, int line)
     return true;
 }
 
+GLErrorPolicy SetGLErrorPolicy(GLErrorPolicy policy, unsigned int sampleInterval)
+{
+#if ENGINE_GL_ERROR_CHECKS
+    bool debugOutput = policy == GLErrorPolicy::DebugCallback;
+    if (debugOutput && !(GLEW_KHR_debug || GLEW_VERSION_4_3))
+    {
+        std::cout << "GL_KHR_debug is not available, checking GL errors once per frame instead." << std::endl;
+        policy = GLErrorPolicy::PerFrame;
+        debugOutput = false;
+    }
+
+    if (GLEW_KHR_debug || GLEW_VERSION_4_3)
+    {
+        if (debugOutput)
+        {
+            glDebugMessageCallback(DebugMessageCallback, nullptr);
+            glEnable(GL_DEBUG_OUTPUT);
+        }
+        else
+        {
+            glDisable(GL_DEBUG_OUTPUT);
+        }
+    }
+
+    // Errors left over from before, such as the one glewInit raises on core profiles
+    GLClearError();
+
+    GLErrorCheck::policy = policy;
+    GLErrorCheck::sampleInterval = sampleInterval > 0 ? sampleInterval : 1;
+    GLErrorCheck::callCount = 0;
+    GLErrorCheck::sampling = false;
+    GLErrorCheck::lastCall = { nullptr, nullptr, 0 };
+    errorStats = GLErrorStats();
+    return policy;
+#else
+    (void)policy; (void)sampleInterval;
+    return GLErrorPolicy::Off;
+#endif
+}
+
+GLErrorPolicy GetGLErrorPolicy()
+{
+#if ENGINE_GL_ERROR_CHECKS
+    return GLErrorCheck::policy;
+#else
+    return GLErrorPolicy::Off;
+#endif
+}
+
+unsigned int GetGLErrorSampleInterval()
+{
+#if ENGINE_GL_ERROR_CHECKS
+    return GLErrorCheck::sampleInterval;
+#else
+    return 0;
+#endif
+}
+
+const GLErrorStats& GetGLErrorStats()
+{
+    return errorStats;
+}
+
+void GLCheckFrameErrors()
+{
+#if ENGINE_GL_ERROR_CHECKS
+    if (GLErrorCheck::policy == GLErrorPolicy::PerFrame)
+    {
+        ++errorStats.checks;
+        // OpenGL keeps one flag per error kind, so a few reads empty the queue
+        for (int i = 0; i < 8; ++i)
+        {
+            GLenum error = glGetError();
+            if (error == GL_NO_ERROR)
+                break;
+            ++errorStats.errors;
+            std::cout << "[OpenGL Error] (" << error << "): raised during the frame" << std::endl;
+        }
+    }
+#endif
+}
+
 void Renderer::Clear() const
 {
     // Render here
@@ -43,7 +176,7 @@ void Renderer::Clear() const
 void Renderer::Draw(const VertexArray& va, const IndexBuffer& ib, const Shader& shader) const
 {
     // Check if the window is minimized
-    if (!glfwGetWindowAttrib(glfwGetCurrentContext(), GLFW_ICONIFIED))
+    if (!GLState::GetInstance().IsMinimized())
     {
         // Window is not minimized, proceed with rendering 
         shader.Bind();
@@ -22,9 +22,54 @@ written consent of DigiPen Institute of Technology is prohibited.
 #include "Shader.h"
 
 #define ASSERT(x) if(!(x)) __debugbreak(); //custom assertion macro
-#define GLCall(x) GLClearError();\
-            x;\
-            ASSERT(GLLogCall(#x, __FILE__, __LINE__)) //custom openGL error handling macro
+
+// GL error checks are compiled in unless ENGINE_GL_ERROR_CHECKS is defined as 0, and
+// default to off in release builds so that they cost nothing there
+#ifndef ENGINE_GL_ERROR_CHECKS
+#ifdef NDEBUG
+#define ENGINE_GL_ERROR_CHECKS 0
+#else
+#define ENGINE_GL_ERROR_CHECKS 1
+#endif
+#endif
+
+// How GL errors are found when the checks are compiled in
+enum class GLErrorPolicy
+{
+    Off,            // Nothing is checked
+    EveryCall,      // glGetError around every GLCall, which stalls the pipeline each time
+    PerFrame,       // glGetError once per frame, without knowing which call failed
+    Sampled,        // glGetError around every Nth GLCall
+    DebugCallback   // GL_KHR_debug messages, reported by the driver without stalling
+};
+
+// Counters since the policy was last set
+struct GLErrorStats
+{
+    int checks = 0;         // glGetError round trips
+    int errors = 0;
+    int debugMessages = 0;
+};
+
+/*!
+ * \brief Selects how GL errors are checked.
+ * \param policy The policy. DebugCallback falls back to PerFrame without GL_KHR_debug.
+ * \param sampleInterval The number of calls between checks for the Sampled policy.
+ * \return The policy in effect, always Off if the checks are compiled out.
+ *
+ * The OpenGL context must be current.
+ */
+GLErrorPolicy SetGLErrorPolicy(GLErrorPolicy policy, unsigned int sampleInterval = 64);
+GLErrorPolicy GetGLErrorPolicy();
+unsigned int GetGLErrorSampleInterval();
+const GLErrorStats& GetGLErrorStats();
+
+/*!
+ * \brief Checks the errors raised during the frame under the PerFrame policy.
+ *
+ * This function should be called once at the end of every frame.
+ */
+void GLCheckFrameErrors();
 
 //-----------functions to deal with errors in OpenGL--------------------
 /*!
@@ -47,6 +92,63 @@ void GLClearError(); //clear openGL errors
  */
 bool GLLogCall(const char* function, const char* file, int line); //log openGL errors
 
+#if ENGINE_GL_ERROR_CHECKS
+namespace GLErrorCheck
+{
+    // A GLCall site, remembered so debug messages can say roughly where they came from
+    struct CallSite
+    {
+        const char* function;
+        const char* file;
+        int line;
+    };
+
+    extern GLErrorPolicy policy;
+    extern unsigned int sampleInterval;
+    extern unsigned int callCount;
+    extern bool sampling;
+    extern CallSite lastCall;
+
+    inline void BeginCall(const char* function, const char* file, int line)
+    {
+        switch (policy)
+        {
+        case GLErrorPolicy::EveryCall:
+            GLClearError();
+            break;
+        case GLErrorPolicy::Sampled:
+            if (++callCount >= sampleInterval)
+            {
+                callCount = 0;
+                sampling = true;
+                GLClearError();
+            }
+            break;
+        case GLErrorPolicy::DebugCallback:
+            lastCall = { function, file, line };
+            break;
+        default:
+            break;
+        }
+    }
+
+    inline void EndCall(const char* function, const char* file, int line)
+    {
+        if (policy == GLErrorPolicy::EveryCall || sampling)
+        {
+            sampling = false;
+            ASSERT(GLLogCall(function, file, line));
+        }
+    }
+}
+
+#define GLCall(x) GLErrorCheck::BeginCall(#x, __FILE__, __LINE__);\
+            x;\
+            GLErrorCheck::EndCall(#x, __FILE__, __LINE__) //custom openGL error handling macro
+#else
+#define GLCall(x) x
+#endif
+
 //-----------------------------------------------------------------------
 
 class Renderer
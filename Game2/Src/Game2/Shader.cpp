@@ -16,6 +16,7 @@
 #include "pch.h"
 #include "Shader.h"
 #include "Renderer.h"
+#include "GLState.h"
 #include <GLFW/glfw3.h>
 
 Shader::Shader(const std::string& filepath1, const std::string& filepath2, 
@@ -24,7 +25,13 @@ Shader::Shader(const std::string& filepath1, const std::string& filepath2,
     : m_FilePath1(filepath1), m_FilePath2(filepath2), 
       m_FilePath3(filepath3), m_FilePath4(filepath4),
       m_FilePath5(filepath5), m_FilePath6(filepath6),
-      m_IsInitialized(false), m_CurrentShaderSet(1)
+      m_IsInitialized(false), m_CurrentShaderSet(1), m_CurrentRendererID(0)
+{
+}
+
+Shader::Shader(const std::string& vertexPath, const std::string& fragmentPath)
+    : m_FilePath1(vertexPath), m_FilePath2(fragmentPath),
+      m_IsInitialized(false), m_CurrentShaderSet(1), m_CurrentRendererID(0)
 {
 }
 
@@ -60,6 +67,18 @@ void Shader::Initialize()
     if (m_IsInitialized)
         return;  // Shader is already initialized
 
+    // Single program shaders only have set 1
+    if (m_FilePath3.empty())
+    {
+        unsigned int program = CreateShader(LoadShaderSource(m_FilePath1), LoadShaderSource(m_FilePath2));
+        CheckShaderCompilation(program, "ShaderSet1");
+        m_RendererIDs[1] = program;
+        ReflectUniforms(1, program);
+        m_IsInitialized = true;
+        SetActiveShaderSet(m_CurrentShaderSet);
+        return;
+    }
+
     // Load vertex shader source code from file
     std::string vertexShaderSource1 = LoadShaderSource(m_FilePath1);
     std::string vertexShaderSource2 = LoadShaderSource(m_FilePath3);
@@ -89,8 +108,12 @@ void Shader::Initialize()
     m_RendererIDs[1] = program1;
     m_RendererIDs[2] = program2;
     m_RendererIDs[3] = program3;
+    ReflectUniforms(1, program1);
+    ReflectUniforms(2, program2);
+    ReflectUniforms(3, program3);
 
     m_IsInitialized = true;
+    SetActiveShaderSet(m_CurrentShaderSet);
 }
 
 void Shader::CheckShaderCompilation(unsigned int programID, const std::string& shaderSetName) {
@@ -200,91 +223,201 @@ unsigned int Shader::CompileShader(unsigned int type, const std::string& source)
 
 void Shader::Bind() const
 {
-        auto it = m_RendererIDs.find(m_CurrentShaderSet);
-        if (it != m_RendererIDs.end())
-        {
-            unsigned int rendererID = it->second;
-            if (rendererID != 0)
-            {
-                GLCall(glUseProgram(rendererID));
-
-                GLenum error = glGetError();
-                if (error != GL_NO_ERROR)
-                {
-                    std::cerr << "[OpenGL Error] (" << error << "): glUseProgram(rendererID)" << std::endl;
-                    __debugbreak();
-                }
-            }
-            else
-            {
-                std::cerr << "Attempting to use an invalid shader program!" << std::endl;
-            }
-        }
-        else
-        {
-            std::cerr << "Shader set " << m_CurrentShaderSet << " is not initialized!" << std::endl;
-        }   
+    if (m_CurrentRendererID != 0)
+    {
+        GLState::GetInstance().UseProgram(m_CurrentRendererID);
+    }
+    else if (m_RendererIDs.find(m_CurrentShaderSet) != m_RendererIDs.end())
+    {
+        std::cerr << "Attempting to use an invalid shader program!" << std::endl;
+    }
+    else
+    {
+        std::cerr << "Shader set " << m_CurrentShaderSet << " is not initialized!" << std::endl;
+    }
 }
 
 void Shader::Unbind() const
 {
-        GLCall(glUseProgram(0));
+    GLState::GetInstance().UseProgram(0);
 }
 
 void Shader::SetUniform1i(const std::string& name, int value)
 {
-        GLCall(glUniform1i(GetUniformLocation(name), value));
+    GLState::GetInstance().Uniform1i(GetUniformLocation(name), value);
 }
 
 void Shader::SetUniform1f(const std::string& name, float value)
 {
-        GLCall(glUniform1f(GetUniformLocation(name), value));
+    GLState::GetInstance().Uniform1f(GetUniformLocation(name), value);
 }
 
 void Shader::SetUniformMat4f(const std::string& name, const glm::mat4& matrix)
 {
-        GLCall(glUniformMatrix4fv(GetUniformLocation(name), 1, GL_FALSE, &matrix[0][0]));
-   
+    GLState::GetInstance().UniformMatrix4f(GetUniformLocation(name), matrix);
 }
 
 void Shader::SetUniform4f(const std::string& name, float v0, float v1, float v2, float v3)
 {
-        GLCall(glUniform4f(GetUniformLocation(name), v0, v1, v2, v3));
+    GLState::GetInstance().Uniform4f(GetUniformLocation(name), v0, v1, v2, v3);
 }
 
 int Shader::GetUniformLocation(const std::string& name)
 {
-    auto& uniformLocationCache = m_UniformLocationCaches[m_CurrentShaderSet];
-
-    if (uniformLocationCache.find(name) != uniformLocationCache.end())
-        return uniformLocationCache[name];
+    auto& uniforms = m_Uniforms[m_CurrentShaderSet];
+    auto it = uniforms.find(name);
+    if (it != uniforms.end())
+        return it->second.location;
+
+    // Remember the miss so the warning is only printed once
+    std::cout << "Warning: Uniform '" << name << "' doesn't exist" << std::endl;
+    uniforms[name] = { -1, 0 };
+    return -1;
+}
 
-    unsigned int rendererID = m_RendererIDs[m_CurrentShaderSet];
-    GLCall(int location = glGetUniformLocation(rendererID, name.c_str()));
+void Shader::ReflectUniforms(int shaderSet, unsigned int programID)
+{
+    auto& uniforms = m_Uniforms[shaderSet];
+    uniforms.clear();
+    if (programID == 0)
+        return;
+
+    int count = 0;
+    GLCall(glGetProgramiv(programID, GL_ACTIVE_UNIFORMS, &count));
+    for (int i = 0; i < count; ++i)
+    {
+        char name[256];
+        GLsizei length = 0;
+        GLint size = 0;
+        GLenum type = 0;
+        GLCall(glGetActiveUniform(programID, static_cast<GLuint>(i), sizeof(name), &length, &size, &type, name));
+
+        // Uniforms in blocks have no location of their own
+        GLCall(int location = glGetUniformLocation(programID, name));
+        if (location == -1)
+            continue;
+
+        // Arrays are reported as their first element
+        std::string uniformName(name, length);
+        if (uniformName.size() > 3 && uniformName.compare(uniformName.size() - 3, 3, "[0]") == 0)
+            uniformName.resize(uniformName.size() - 3);
+        uniforms[uniformName] = { location, type };
+    }
+}
 
-    if (location == -1)
+int Shader::ResolveUniform(const std::string& name, UniformKind kind) const
+{
+    auto set = m_Uniforms.find(m_CurrentShaderSet);
+    if (set == m_Uniforms.end())
+    {
+        std::cerr << "Shader set " << m_CurrentShaderSet << " is not initialized!" << std::endl;
+        return -1;
+    }
+    auto it = set->second.find(name);
+    if (it == set->second.end())
+    {
         std::cout << "Warning: Uniform '" << name << "' doesn't exist" << std::endl;
+        return -1;
+    }
+
+    bool matches = false;
+    switch (it->second.type)
+    {
+    case GL_INT:
+    case GL_BOOL:
+    case GL_SAMPLER_2D:
+        matches = kind == UniformKind::Int;
+        break;
+    case GL_FLOAT:
+        matches = kind == UniformKind::Float;
+        break;
+    case GL_FLOAT_VEC2:
+        matches = kind == UniformKind::Vec2;
+        break;
+    case GL_FLOAT_VEC3:
+        matches = kind == UniformKind::Vec3;
+        break;
+    case GL_FLOAT_VEC4:
+        matches = kind == UniformKind::Vec4;
+        break;
+    case GL_FLOAT_MAT4:
+        matches = kind == UniformKind::Mat4;
+        break;
+    }
+    if (!matches)
+    {
+        std::cerr << "Uniform '" << name << "' is declared with another type in shader set " << m_CurrentShaderSet << std::endl;
+        return -1;
+    }
+    return it->second.location;
+}
+
+void Shader::SetUniform(UniformHandle<int> uniform, int value)
+{
+    GLState::GetInstance().Uniform1i(uniform.location, value);
+}
 
-    uniformLocationCache[name] = location;
-    return location;
+void Shader::SetUniform(UniformHandle<float> uniform, float value)
+{
+    GLState::GetInstance().Uniform1f(uniform.location, value);
+}
+
+void Shader::SetUniform(UniformHandle<glm::vec2> uniform, const glm::vec2& value)
+{
+    GLState::GetInstance().Uniform2f(uniform.location, value.x, value.y);
+}
+
+void Shader::SetUniform(UniformHandle<glm::vec3> uniform, const glm::vec3& value)
+{
+    GLState::GetInstance().Uniform3f(uniform.location, value.x, value.y, value.z);
+}
+
+void Shader::SetUniform(UniformHandle<glm::vec4> uniform, const glm::vec4& value)
+{
+    GLState::GetInstance().Uniform4f(uniform.location, value.x, value.y, value.z, value.w);
+}
+
+void Shader::SetUniform(UniformHandle<glm::mat4> uniform, const glm::mat4& value)
+{
+    GLState::GetInstance().UniformMatrix4f(uniform.location, value);
+}
+
+void Shader::SetUniform(UniformHandle<int> uniform, const int* values, int count)
+{
+    GLState::GetInstance().Uniform1iv(uniform.location, count, values);
 }
 
 void Shader::SetUniform2f(const std::string& name, const glm::vec2& vector)
 {
-    GLCall(glUniform2f(GetUniformLocation(name), vector.x, vector.y));
+    GLState::GetInstance().Uniform2f(GetUniformLocation(name), vector.x, vector.y);
 }
 
 void Shader::SetActiveShaderSet(int shaderSet)
 {
     m_CurrentShaderSet = shaderSet;
+    // Looked up once here rather than on every bind
+    auto it = m_RendererIDs.find(shaderSet);
+    m_CurrentRendererID = it != m_RendererIDs.end() ? it->second : 0;
 }
 
 void Shader::SetShaderProgram(int shaderSet, unsigned int programID) {
+    if (m_RendererIDs.find(shaderSet) != m_RendererIDs.end())
+    {
+        GLState::GetInstance().ForgetProgram(m_RendererIDs[shaderSet]);
+    }
     m_RendererIDs[shaderSet] = programID;
+    ReflectUniforms(shaderSet, programID);
+    if (shaderSet == m_CurrentShaderSet)
+    {
+        m_CurrentRendererID = programID;
+    }
 }
 
 unsigned int Shader::GetID() const
 {
+    if (m_CurrentRendererID != 0) {
+        return m_CurrentRendererID;
+    }
     auto it = m_RendererIDs.find(m_CurrentShaderSet);
     if (it != m_RendererIDs.end()) {
         return it->second;
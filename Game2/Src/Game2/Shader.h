@@ -25,6 +25,33 @@ struct ShaderProgramSource
     std::string FragmentSource;
 };
 
+// The kinds of uniform a handle can refer to
+enum class UniformKind
+{
+    Int,        // int, bool and sampler uniforms, or arrays of them
+    Float,
+    Vec2,
+    Vec3,
+    Vec4,
+    Mat4
+};
+
+template <typename T> struct UniformKindOf;
+template <> struct UniformKindOf<int> { static constexpr UniformKind value = UniformKind::Int; };
+template <> struct UniformKindOf<float> { static constexpr UniformKind value = UniformKind::Float; };
+template <> struct UniformKindOf<glm::vec2> { static constexpr UniformKind value = UniformKind::Vec2; };
+template <> struct UniformKindOf<glm::vec3> { static constexpr UniformKind value = UniformKind::Vec3; };
+template <> struct UniformKindOf<glm::vec4> { static constexpr UniformKind value = UniformKind::Vec4; };
+template <> struct UniformKindOf<glm::mat4> { static constexpr UniformKind value = UniformKind::Mat4; };
+
+// A uniform of one program, resolved once after linking so setting it needs no lookup
+template <typename T>
+struct UniformHandle
+{
+    int location = -1;
+    bool IsValid() const { return location != -1; }
+};
+
 class Shader
 {
 private:
@@ -37,9 +64,16 @@ private:
     //unsigned int m_RendererID1;          // Shader program ID
     //unsigned int m_RendererID2;
     bool m_IsInitialized;               // Flag to track initialization
-    std::unordered_map<int, std::unordered_map<std::string, int>> m_UniformLocationCaches; // Caching for uniforms of different shader sets
+    // An active uniform found when the program was linked
+    struct UniformInfo
+    {
+        int location;
+        unsigned int type;              // OpenGL type, such as GL_FLOAT_VEC4
+    };
+    std::unordered_map<int, std::unordered_map<std::string, UniformInfo>> m_Uniforms; // Active uniforms of each shader set
     std::unordered_map<int, unsigned int> m_RendererIDs;                                    // Shader program IDs for different shader sets
     int m_CurrentShaderSet;             // Current active shader set (1 or 2)
+    unsigned int m_CurrentRendererID;   // Program of the current shader set, 0 if it has none
 
 public:
     /*!
@@ -49,6 +83,15 @@ public:
      * This constructor initializes a Shader object with the provided file path.
      */
     Shader(const std::string& filepath1, const std::string& filepath2, const std::string& filepath3, const std::string& filepath4, const std::string& filepath5, const std::string& filepath6);
+
+    /*!
+     * \brief Shader constructor for a single program.
+     * \param vertexPath The file path to the vertex shader source code.
+     * \param fragmentPath The file path to the fragment shader source code.
+     *
+     * This constructor initializes a Shader object with only shader set 1.
+     */
+    Shader(const std::string& vertexPath, const std::string& fragmentPath);
     
     /*!
      * \brief Shader destructor.
@@ -153,6 +196,35 @@ public:
      */
     void SetUniform2f(const std::string& name, const glm::vec2& vector);
 
+    /*!
+     * \brief Resolve a uniform of the current shader set into a handle.
+     * \param name The name of the uniform variable, without [0] for arrays.
+     * \return The handle, invalid if the program has no such uniform of type T.
+     *
+     * This function should be called once after the shader is initialized, and the handle
+     * kept, so that setting the uniform does not look up its name again.
+     */
+    template <typename T>
+    UniformHandle<T> GetUniform(const std::string& name) const
+    {
+        return { ResolveUniform(name, UniformKindOf<T>::value) };
+    }
+
+    /*!
+     * \brief Set a uniform of the bound program through a handle.
+     * \param uniform The handle from GetUniform.
+     * \param value The value to set.
+     *
+     * Invalid handles are ignored, and values equal to the last one written are not uploaded again.
+     */
+    void SetUniform(UniformHandle<int> uniform, int value);
+    void SetUniform(UniformHandle<float> uniform, float value);
+    void SetUniform(UniformHandle<glm::vec2> uniform, const glm::vec2& value);
+    void SetUniform(UniformHandle<glm::vec3> uniform, const glm::vec3& value);
+    void SetUniform(UniformHandle<glm::vec4> uniform, const glm::vec4& value);
+    void SetUniform(UniformHandle<glm::mat4> uniform, const glm::mat4& value);
+    void SetUniform(UniformHandle<int> uniform, const int* values, int count);
+
     /*!
      * \brief Set the shader program for a specific shader set.
      * \param shaderSet The shader set (1 or 2).
@@ -215,10 +287,24 @@ private:
      * \param name The name of the uniform variable.
      * \return The location of the uniform variable.
      *
-     * This function retrieves the location of a uniform variable in the shader program
-     * and caches it for future use to improve performance.
+     * This function looks the uniform up in the table built when the program was linked.
      */
     int GetUniformLocation(const std::string& name);
 
+    /*!
+     * \brief Record the active uniforms of a linked program.
+     * \param shaderSet The shader set the program belongs to.
+     * \param programID The ID of the shader program.
+     */
+    void ReflectUniforms(int shaderSet, unsigned int programID);
+
+    /*!
+     * \brief Find a uniform of the current shader set and check its type.
+     * \param name The name of the uniform variable.
+     * \param kind The kind of value the caller will set.
+     * \return The location, or -1 if it is missing or of another type.
+     */
+    int ResolveUniform(const std::string& name, UniformKind kind) const;
+
 };
 #endif ENGINE_SHADER_H
\ No newline at end of file
@@ -0,0 +1,261 @@
+/******************************************************************************/
+/*!
+\file		SpriteBatch.cpp
+\author 	Wayne Kwok Jun Lin
+\par    	email: k.junlinwayne@digipen.edu
+\date   	April 14, 2024
+\brief		This file contains the implementation of the SpriteBatch class.
+Copyright (C) 2024 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the prior
+written consent of DigiPen Institute of Technology is prohibited.
+ */
+ /******************************************************************************/
+#include "pch.h"
+#include "SpriteBatch.h"
+#include "VertexBufferLayout.h"
+#include "Renderer.h"
+#include "GLState.h"
+
+namespace
+{
+    // Corners of the sprite quad, the same quad GraphicsSystem drew per entity
+    const float QUAD_HALF_SIZE = 50.0f;
+    const float QUAD_CORNERS[4][2] =
+    {
+        { -QUAD_HALF_SIZE, -QUAD_HALF_SIZE },   // bottom-left
+        {  QUAD_HALF_SIZE, -QUAD_HALF_SIZE },   // bottom-right
+        {  QUAD_HALF_SIZE,  QUAD_HALF_SIZE },   // top-right
+        { -QUAD_HALF_SIZE,  QUAD_HALF_SIZE }    // top-left
+    };
+    // Texture coordinates of each corner across the UV rect
+    const float QUAD_TEX_COORDS[4][2] = { { 0.0f, 0.0f }, { 1.0f, 0.0f }, { 1.0f, 1.0f }, { 0.0f, 1.0f } };
+
+    // The attributes of the instanced shader that follow the shared quad
+    const unsigned int FIRST_INSTANCE_ATTRIBUTE = 2;
+
+    void SetSamplers(Shader& batchShader, int count)
+    {
+        // Each sampler in the array reads its own texture unit
+        int samplers[SpriteBatch::MAX_TEXTURE_SLOTS];
+        for (int i = 0; i < SpriteBatch::MAX_TEXTURE_SLOTS; ++i)
+        {
+            samplers[i] = i;
+        }
+        batchShader.Bind();
+        batchShader.SetUniform(batchShader.GetUniform<int>("u_Textures"), samplers, count);
+    }
+}
+
+SpriteBatch::SpriteBatch()
+    : shader("Resource/Shaders/Batch.vert", "Resource/Shaders/Batch.frag"),
+      instancedShader("Resource/Shaders/BatchInstanced.vert", "Resource/Shaders/Batch.frag")
+{
+}
+
+void SpriteBatch::Initialize()
+{
+    shader.Initialize();
+    instancedShader.Initialize();
+    SetSamplers(shader, MAX_TEXTURE_SLOTS);
+    SetSamplers(instancedShader, MAX_TEXTURE_SLOTS);
+
+    int hardwareSlots = 0;
+    GLCall(glGetIntegerv(GL_MAX_TEXTURE_IMAGE_UNITS, &hardwareSlots));
+    maxTextureSlots = std::max(1, std::min(hardwareSlots, static_cast<int>(MAX_TEXTURE_SLOTS)));
+
+    instances.reserve(MAX_SPRITES);
+    vertices.reserve(MAX_SPRITES * 4);
+    vertexBuffer = std::make_unique<VertexBuffer>(static_cast<unsigned int>(MAX_SPRITES * 4 * sizeof(Vertex)));
+
+    VertexBufferLayout layout;
+    layout.Push<float>(2);  // position
+    layout.Push<float>(2);  // texture coordinates
+    layout.Push<float>(4);  // color
+    layout.Push<float>(1);  // texture slot
+    vertexArray.AddBuffer(*vertexBuffer, layout);
+
+    // Every quad uses the same two triangles, so the indices never change
+    std::vector<unsigned int> indices(MAX_SPRITES * 6);
+    for (unsigned int sprite = 0; sprite < static_cast<unsigned int>(MAX_SPRITES); ++sprite)
+    {
+        unsigned int first = sprite * 4;
+        unsigned int* quad = &indices[sprite * 6];
+        quad[0] = first;
+        quad[1] = first + 1;
+        quad[2] = first + 2;
+        quad[3] = first + 2;
+        quad[4] = first + 3;
+        quad[5] = first;
+    }
+    indexBuffer.SetData(indices.data(), static_cast<unsigned int>(indices.size()));
+    indexBuffer.Bind();
+    vertexArray.Unbind();
+
+    // Instanced path: one quad shared by every sprite, and one record per sprite
+    float quad[16];
+    for (int corner = 0; corner < 4; ++corner)
+    {
+        quad[corner * 4 + 0] = QUAD_CORNERS[corner][0];
+        quad[corner * 4 + 1] = QUAD_CORNERS[corner][1];
+        quad[corner * 4 + 2] = QUAD_TEX_COORDS[corner][0];
+        quad[corner * 4 + 3] = QUAD_TEX_COORDS[corner][1];
+    }
+    quadBuffer = std::make_unique<VertexBuffer>(quad, static_cast<unsigned int>(sizeof(quad)));
+    VertexBufferLayout quadLayout;
+    quadLayout.Push<float>(2);  // position
+    quadLayout.Push<float>(2);  // texture coordinates
+    instancedArray.AddBuffer(*quadBuffer, quadLayout);
+
+    instanceBuffer = std::make_unique<VertexBuffer>(static_cast<unsigned int>(MAX_SPRITES * sizeof(Instance)));
+    VertexBufferLayout instanceLayout;
+    instanceLayout.Push<float>(4);  // basis
+    instanceLayout.Push<float>(2);  // translation
+    instanceLayout.Push<float>(4);  // UV rect
+    instanceLayout.Push<float>(4);  // color
+    instanceLayout.Push<float>(1);  // texture slot
+    instanceLayout.Push<float>(1);  // sheet
+    instanceLayout.Push<float>(1);  // frame
+    instancedArray.AddInstanceBuffer(*instanceBuffer, instanceLayout, FIRST_INSTANCE_ATTRIBUTE);
+    indexBuffer.Bind();
+    instancedArray.Unbind();
+
+    instanceBuffer->Unbind();
+    instancedShader.Unbind();
+}
+
+void SpriteBatch::Begin()
+{
+    sheets.Upload();
+    instances.clear();
+    textureSlotCount = 0;
+    stats = Stats();
+}
+
+void SpriteBatch::Submit(const Transform2D& transform, unsigned int textureID, const glm::vec4& uvRect, const glm::vec4& color, int sheet, int frame)
+{
+    if (instances.size() >= static_cast<size_t>(MAX_SPRITES))
+    {
+        ++stats.flushes;
+        Flush();
+    }
+
+    // Reuse the unit the texture is already on, or take the next free one
+    int slot = -1;
+    for (int i = 0; i < textureSlotCount; ++i)
+    {
+        if (textureSlots[i] == textureID)
+        {
+            slot = i;
+            break;
+        }
+    }
+    if (slot < 0)
+    {
+        if (textureSlotCount == maxTextureSlots)
+        {
+            ++stats.flushes;
+            Flush();
+        }
+        slot = textureSlotCount++;
+        textureSlots[slot] = textureID;
+    }
+
+    Instance instance;
+    instance.transform = transform;
+    instance.uvRect[0] = uvRect.x;
+    instance.uvRect[1] = uvRect.y;
+    instance.uvRect[2] = uvRect.z;
+    instance.uvRect[3] = uvRect.w;
+    instance.color[0] = color.r;
+    instance.color[1] = color.g;
+    instance.color[2] = color.b;
+    instance.color[3] = color.a;
+    instance.textureSlot = static_cast<float>(slot);
+    instance.sheet = static_cast<float>(sheet);
+    instance.frame = static_cast<float>(frame);
+    instances.push_back(instance);
+    ++stats.sprites;
+}
+
+void SpriteBatch::End()
+{
+    Flush();
+}
+
+void SpriteBatch::BindShader(Shader& batchShader)
+{
+    // The camera comes from the frame uniform buffer, so only the textures change between batches
+    batchShader.Bind();
+    GLState& state = GLState::GetInstance();
+    for (int i = 0; i < textureSlotCount; ++i)
+    {
+        state.BindTexture(i, textureSlots[i]);
+    }
+}
+
+void SpriteBatch::Flush()
+{
+    // Nothing can be drawn while minimized, drop the batch
+    if (instances.empty() || GLState::GetInstance().IsMinimized())
+    {
+        instances.clear();
+        textureSlotCount = 0;
+        return;
+    }
+
+    const int count = static_cast<int>(instances.size());
+    if (count >= instancingThreshold)
+    {
+        // One record per sprite instead of four vertices
+        BindShader(instancedShader);
+        instanceBuffer->StreamData(instances.data(), static_cast<unsigned int>(count * sizeof(Instance)));
+        instancedArray.Bind();
+        GLCall(glDrawElementsInstanced(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr, count));
+        instancedArray.Unbind();
+        ++stats.instancedDrawCalls;
+        stats.instances += count;
+    }
+    else
+    {
+        // Small batches are cheaper to expand on the CPU than to set up an instanced draw
+        vertices.clear();
+        for (const Instance& instance : instances)
+        {
+            // The same lookup the instanced shader does
+            const float* uvRect = instance.uvRect;
+            if (instance.sheet >= 0.0f)
+            {
+                uvRect = &sheets.GetFrameRect(static_cast<int>(instance.sheet), static_cast<int>(instance.frame)).x;
+            }
+            for (int corner = 0; corner < 4; ++corner)
+            {
+                float x = QUAD_CORNERS[corner][0];
+                float y = QUAD_CORNERS[corner][1];
+                Vertex vertex;
+                const Transform2D& transform = instance.transform;
+                vertex.x = transform.basis[0] * x + transform.basis[2] * y + transform.translation[0];
+                vertex.y = transform.basis[1] * x + transform.basis[3] * y + transform.translation[1];
+                vertex.u = uvRect[0] + (uvRect[2] - uvRect[0]) * QUAD_TEX_COORDS[corner][0];
+                vertex.v = uvRect[1] + (uvRect[3] - uvRect[1]) * QUAD_TEX_COORDS[corner][1];
+                vertex.r = instance.color[0];
+                vertex.g = instance.color[1];
+                vertex.b = instance.color[2];
+                vertex.a = instance.color[3];
+                vertex.textureSlot = instance.textureSlot;
+                vertices.push_back(vertex);
+            }
+        }
+
+        BindShader(shader);
+        vertexBuffer->StreamData(vertices.data(), static_cast<unsigned int>(vertices.size() * sizeof(Vertex)));
+        vertexArray.Bind();
+        GLCall(glDrawElements(GL_TRIANGLES, count * 6, GL_UNSIGNED_INT, nullptr));
+        vertexArray.Unbind();
+        stats.vertices += static_cast<int>(vertices.size());
+    }
+    GLState::GetInstance().ActiveTexture(0);
+
+    ++stats.drawCalls;
+    instances.clear();
+    textureSlotCount = 0;
+}
@@ -0,0 +1,153 @@
+/******************************************************************************/
+/*!
+\file		SpriteBatch.h
+\author 	Wayne Kwok Jun Lin
+\par    	email: k.junlinwayne@digipen.edu
+\date   	April 14, 2024
+\brief		This file contains the declaration of the SpriteBatch class, which
+			collects transformed sprite quads into one streamed vertex buffer
+			and draws them with as few draw calls as possible. Each batch
+			binds up to 16 textures to separate texture units, and a batch is
+			only drawn early when it runs out of texture units or vertices.
+			Large batches are drawn instanced instead, uploading one record
+			per sprite over a shared quad rather than four vertices.
+Copyright (C) 2024 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the prior
+written consent of DigiPen Institute of Technology is prohibited.
+ */
+ /******************************************************************************/
+#ifndef ENGINE_SPRITEBATCH_H
+#define ENGINE_SPRITEBATCH_H
+
+#include <memory>
+#include <vector>
+#include "glm/glm.hpp"
+#include "VertexArray.h"
+#include "VertexBuffer.h"
+#include "IndexBuffer.h"
+#include "Shader.h"
+#include "Transform2D.h"
+#include "SpriteSheetTable.h"
+
+// Collects sprites into batches sharing one vertex buffer and draws each batch in one call.
+class SpriteBatch
+{
+public:
+    // Counters of the current frame, reset by Begin
+    struct Stats
+    {
+        int sprites = 0;
+        int vertices = 0;           // Vertices uploaded by batches drawn without instancing
+        int instances = 0;          // Sprites drawn by instanced batches
+        int drawCalls = 0;
+        int instancedDrawCalls = 0; // Included in drawCalls
+        int flushes = 0;            // Batches drawn early because the texture units or the buffer ran out
+    };
+
+    SpriteBatch();
+
+    /*!
+     * \brief Creates the buffers and compiles the batch shaders.
+     *
+     * This function must be called once the OpenGL context exists.
+     */
+    void Initialize();
+
+    /*!
+     * \brief Starts collecting the sprites of a frame.
+     *
+     * The sprites are drawn with the camera in the frame uniform buffer, which must be
+     * written before End.
+     */
+    void Begin();
+
+    /*!
+     * \brief Adds a sprite to the current batch.
+     * \param transform The transform of the sprite, applied to a 100 by 100 quad centered on the origin.
+     * \param textureID The OpenGL texture the sprite samples.
+     * \param uvRect The texture coordinates of the bottom-left (x, y) and top-right (z, w) corners.
+     * Unused for sprite sheets.
+     * \param color The color the texture is multiplied with.
+     * \param sheet The ID of the sprite sheet in the sheet table, or -1 to draw uvRect.
+     * \param frame The frame of the sprite sheet to draw.
+     */
+    void Submit(const Transform2D& transform, unsigned int textureID, const glm::vec4& uvRect, const glm::vec4& color, int sheet = -1, int frame = 0);
+
+    /*!
+     * \brief Draws the sprites collected since the last draw.
+     *
+     * This function must be called before anything else is drawn over the sprites, such as text.
+     */
+    void End();
+
+    /*!
+     * \brief Sets the number of sprites from which a batch is drawn instanced.
+     * \param threshold The sprite count, or 0 to always draw instanced.
+     */
+    void SetInstancingThreshold(int threshold) { instancingThreshold = threshold; }
+    int GetInstancingThreshold() const { return instancingThreshold; }
+
+    /*!
+     * \brief Gets the frame layout of the sprite sheets, uploaded by Begin whenever it changes.
+     * \return A reference to the table.
+     */
+    SpriteSheetTable& GetSheets() { return sheets; }
+
+    /*!
+     * \brief Gets the counters of the current frame.
+     * \return A reference to the statistics.
+     */
+    const Stats& GetStats() const { return stats; }
+
+    static constexpr int MAX_SPRITES = 2000;        // Sprites per batch
+    static constexpr int MAX_TEXTURE_SLOTS = 16;    // Matches u_Textures in Batch.frag
+
+private:
+    // One sprite, as uploaded to the instance buffer
+    struct Instance
+    {
+        Transform2D transform;
+        float uvRect[4];
+        float color[4];
+        float textureSlot;
+        float sheet;            // -1 when uvRect is drawn
+        float frame;
+    };
+
+    struct Vertex
+    {
+        float x, y;
+        float u, v;
+        float r, g, b, a;
+        float textureSlot;
+    };
+
+    /*!
+     * \brief Draws the current batch and empties it.
+     */
+    void Flush();
+
+    // Binds a batch shader with the textures of the batch
+    void BindShader(Shader& batchShader);
+
+    Shader shader;
+    VertexArray vertexArray;
+    std::unique_ptr<VertexBuffer> vertexBuffer;
+    IndexBuffer indexBuffer;
+
+    Shader instancedShader;
+    VertexArray instancedArray;
+    std::unique_ptr<VertexBuffer> quadBuffer;
+    std::unique_ptr<VertexBuffer> instanceBuffer;
+
+    std::vector<Instance> instances;
+    std::vector<Vertex> vertices;
+    unsigned int textureSlots[MAX_TEXTURE_SLOTS]{};
+    int textureSlotCount = 0;
+    int maxTextureSlots = MAX_TEXTURE_SLOTS;
+    int instancingThreshold = 256;
+    SpriteSheetTable sheets;
+
+    Stats stats;
+};
+#endif ENGINE_SPRITEBATCH_H
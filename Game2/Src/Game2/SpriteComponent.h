@@ -30,6 +30,7 @@ namespace Engine
         int textureyindex = 0;
         bool playing = false;
         anim_mode playmode = anim_mode::loop;
+        int clip = -1;      // Sheet sub-index the state belongs to, set by the AnimationSystem
         /*!*****************************************************************
 
 		\brief
@@ -53,12 +54,16 @@ namespace Engine
         Component* Clone() const override
         {
             SpriteComponent* clonecomponent = new SpriteComponent;
+            clonecomponent->framerate = framerate;
+            clonecomponent->horizontalframes = horizontalframes;
+            clonecomponent->verticalframes = verticalframes;
             clonecomponent->animtimer = animtimer;
             clonecomponent->currentframe = currentframe;
             clonecomponent->texturexindex = texturexindex;
             clonecomponent->textureyindex = textureyindex;
             clonecomponent->playing = playing;
             clonecomponent->playmode = playmode;
+            clonecomponent->clip = clip;
             return clonecomponent;
         }      
 
@@ -0,0 +1,106 @@
+/******************************************************************************/
+/*!
+\file		SpriteSheetTable.cpp
+\author 	Wayne Kwok Jun Lin
+\par    	email: k.junlinwayne@digipen.edu
+\date   	April 20, 2024
+\brief		This file contains the implementation of the SpriteSheetTable class.
+Copyright (C) 2024 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the prior
+written consent of DigiPen Institute of Technology is prohibited.
+ */
+ /******************************************************************************/
+#include "pch.h"
+#include "SpriteSheetTable.h"
+#include <algorithm>
+#include <vector>
+
+int SpriteSheetTable::Set(const TextureKey& key, const glm::vec4* frameRects, int frameCount)
+{
+    if (frameCount < 1)
+    {
+        return -1;
+    }
+
+    int sheet;
+    auto it = sheetOf.find(key);
+    if (it != sheetOf.end() && data.sheets[it->second][1] == frameCount)
+    {
+        sheet = it->second;
+    }
+    else
+    {
+        // A sheet whose frame count changed takes new rows, the old ones stay unused until Clear
+        sheet = it != sheetOf.end() ? it->second : sheetCount;
+        if (sheet == MAX_SHEETS || frameRectCount + frameCount > MAX_FRAME_RECTS)
+        {
+            return -1;
+        }
+        if (sheet == sheetCount)
+        {
+            ++sheetCount;
+        }
+        data.sheets[sheet][0] = frameRectCount;
+        data.sheets[sheet][1] = frameCount;
+        frameRectCount += frameCount;
+        sheetOf[key] = sheet;
+    }
+
+    std::copy(frameRects, frameRects + frameCount, data.frameRects + data.sheets[sheet][0]);
+    dirty = true;
+    return sheet;
+}
+
+int SpriteSheetTable::SetGrid(const TextureKey& key, int columns, int rows)
+{
+    columns = std::max(1, columns);
+    rows = std::max(1, rows);
+    const float frameWidth = 1.0f / static_cast<float>(columns);
+    const float frameHeight = 1.0f / static_cast<float>(rows);
+
+    std::vector<glm::vec4> frameRects;
+    frameRects.reserve(static_cast<size_t>(columns) * rows);
+    for (int row = 0; row < rows; ++row)
+    {
+        for (int column = 0; column < columns; ++column)
+        {
+            frameRects.emplace_back(column * frameWidth, row * frameHeight, (column + 1) * frameWidth, (row + 1) * frameHeight);
+        }
+    }
+    return Set(key, frameRects.data(), static_cast<int>(frameRects.size()));
+}
+
+int SpriteSheetTable::Find(const TextureKey& key) const
+{
+    auto it = sheetOf.find(key);
+    return it != sheetOf.end() ? it->second : -1;
+}
+
+const glm::vec4& SpriteSheetTable::GetFrameRect(int sheet, int frame) const
+{
+    const int* entry = data.sheets[sheet];
+    frame = std::max(0, std::min(frame, entry[1] - 1));
+    return data.frameRects[entry[0] + frame];
+}
+
+void SpriteSheetTable::Upload()
+{
+    if (!dirty)
+    {
+        return;
+    }
+    if (!buffer)
+    {
+        buffer = std::make_unique<UniformBuffer>(static_cast<unsigned int>(sizeof(GPUData)), BINDING);
+    }
+    buffer->SetData(&data, static_cast<unsigned int>(sizeof(GPUData)));
+    dirty = false;
+}
+
+void SpriteSheetTable::Clear()
+{
+    sheetOf.clear();
+    sheetCount = 0;
+    frameRectCount = 0;
+    dirty = true;
+}
@@ -0,0 +1,97 @@
+/******************************************************************************/
+/*!
+\file		SpriteSheetTable.h
+\author 	Wayne Kwok Jun Lin
+\par    	email: k.junlinwayne@digipen.edu
+\date   	April 20, 2024
+\brief		This file contains the declaration of the SpriteSheetTable class,
+            which keeps the texture coordinates of every frame of every sprite
+            sheet in a uniform buffer. Sprites then only carry a sheet ID and a
+            frame index, and the vertex shader looks the frame up.
+Copyright (C) 2024 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the prior
+written consent of DigiPen Institute of Technology is prohibited.
+ */
+ /******************************************************************************/
+#ifndef ENGINE_SPRITESHEETTABLE_H
+#define ENGINE_SPRITESHEETTABLE_H
+
+#include <memory>
+#include <unordered_map>
+#include "glm/glm.hpp"
+#include "EngineTypes.h"
+#include "UniformBuffer.h"
+
+// Frame layout of the sprite sheets, shared with the batch shaders through the SpriteSheets block.
+class SpriteSheetTable
+{
+public:
+    static constexpr int MAX_SHEETS = 128;          // Matches u_Sheets in BatchInstanced.vert
+    static constexpr int MAX_FRAME_RECTS = 768;     // Matches u_FrameRects in BatchInstanced.vert
+    static constexpr unsigned int BINDING = 1;      // Binding of the SpriteSheets block
+
+    /*!
+     * \brief Sets the frames of a sheet, reusing its ID if it was added before with as many frames.
+     * \param key The texture of the sheet.
+     * \param frameRects The texture coordinates of each frame, bottom-left (x, y) and top-right (z, w).
+     * \param frameCount The number of frames.
+     * \return The sheet ID, or -1 if the table is full.
+     */
+    int Set(const TextureKey& key, const glm::vec4* frameRects, int frameCount);
+
+    /*!
+     * \brief Sets the frames of a sheet laid out in a grid over the whole texture, left to right then
+     * bottom to top.
+     * \param key The texture of the sheet.
+     * \param columns The number of frames across.
+     * \param rows The number of frames down.
+     * \return The sheet ID, or -1 if the table is full.
+     */
+    int SetGrid(const TextureKey& key, int columns, int rows);
+
+    /*!
+     * \brief Finds the ID of a sheet.
+     * \param key The texture of the sheet.
+     * \return The sheet ID, or -1 if the texture is not a sheet.
+     */
+    int Find(const TextureKey& key) const;
+
+    /*!
+     * \brief Gets the texture coordinates of a frame, as the shader computes them.
+     * \param sheet The sheet ID.
+     * \param frame The frame, clamped to the frames of the sheet.
+     * \return The bottom-left (x, y) and top-right (z, w) texture coordinates.
+     */
+    const glm::vec4& GetFrameRect(int sheet, int frame) const;
+
+    /*!
+     * \brief Uploads the table if it changed since the last upload, creating the buffer on first use.
+     *
+     * This function must be called once the OpenGL context exists.
+     */
+    void Upload();
+
+    /*!
+     * \brief Removes every sheet.
+     */
+    void Clear();
+
+    int GetSheetCount() const { return sheetCount; }
+    int GetFrameRectCount() const { return frameRectCount; }
+
+private:
+    // Contents of the SpriteSheets block, laid out as std140
+    struct GPUData
+    {
+        int sheets[MAX_SHEETS][4];              // First frame rect and frame count of each sheet
+        glm::vec4 frameRects[MAX_FRAME_RECTS];
+    };
+
+    GPUData data{};
+    std::unordered_map<TextureKey, int> sheetOf;
+    int sheetCount = 0;
+    int frameRectCount = 0;
+    bool dirty = true;      // Uploaded once even while empty, so the block is always backed
+    std::unique_ptr<UniformBuffer> buffer;
+};
+#endif ENGINE_SPRITESHEETTABLE_H
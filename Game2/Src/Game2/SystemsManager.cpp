@@ -21,12 +21,14 @@ namespace Engine
 	template PhysicsSystem* SystemsManager::GetSystem<PhysicsSystem>();
 	template PathfindingSystem* SystemsManager::GetSystem<PathfindingSystem>();
 	template ScriptSystem* SystemsManager::GetSystem<ScriptSystem>();
+	template AnimationSystem* SystemsManager::GetSystem<AnimationSystem>();
 
 	template void SystemsManager::ToggleSystemState<CollisionSystem>();
 	template void SystemsManager::ToggleSystemState<GraphicsSystem>();
 	template void SystemsManager::ToggleSystemState<PhysicsSystem>();
 	template void SystemsManager::ToggleSystemState<PathfindingSystem>();
 	template void SystemsManager::ToggleSystemState<ScriptSystem>();
+	template void SystemsManager::ToggleSystemState<AnimationSystem>();
 
 	SystemsManager::SystemsManager(std::shared_ptr<Engine::AssetManager> assetManager, std::shared_ptr<Engine::EntityManager> entityManager)
 		: assetManager(assetManager), entityManager(entityManager) {
@@ -40,6 +42,8 @@ namespace Engine
 		all_systems.push_back(new GraphicsSystem(assetManager, entityManager));
 		all_systems.push_back(new PathfindingSystem());
 		all_systems.push_back(new ScriptSystem(entityManager));
+		// Last, so it sees the textures the other systems switched this step, and stays still while paused
+		all_systems.push_back(new AnimationSystem());
 
 		//initialize each system
 		for (auto system : all_systems)
@@ -48,47 +52,89 @@ namespace Engine
 		}
 	}
 
+	// Steps run in one frame at most, so a long frame slows the game down instead of stalling it
+	const int MAX_STEPS_PER_FRAME = 8;
+
+	// Number of the fixed step being run, used to tell stepped transforms from new ones
+	unsigned int simulationStep = 0;
+
 	void SystemsManager::UpdateSystems(std::unordered_map<EntityID, std::unique_ptr<Entity>>* entities)
 	{
+		GraphicsSystem* graphicsSystem = nullptr;
 		for (auto system : all_systems)
 		{
-			if (system->GetSystemState() == SystemState::On)
+			if (system->returnSystem() == "graphics")
+			{
+				graphicsSystem = dynamic_cast<GraphicsSystem*>(system);
+			}
+		}
+
+		// Paused in the editor, the systems ahead of the graphics keep running every frame for picking
+		if (isPaused && currentNumberOfSteps == 0)
+		{
+			for (auto system : all_systems)
+			{
+				if (system->GetSystemState() != SystemState::On)
+				{
+					continue;
+				}
+				if (system == graphicsSystem)
+				{
+					graphicsSystem->SetInterpolationAlpha(1.0f);
+					graphicsSystem->StartTimer();
+					graphicsSystem->Update(entities);
+					graphicsSystem->StopTimer();
+					break; // Break out of the loop after updating the GraphicsSystem.
+				}
+				system->StartTimer();
+				system->Update(entities);
+				system->StopTimer();
+			}
+			return;
+		}
+
+		// The simulation runs once per fixed step taken this frame
+		int steps = std::min(currentNumberOfSteps, MAX_STEPS_PER_FRAME);
+		for (int step = 0; step < steps; ++step)
+		{
+			++simulationStep;
+			for (const auto& entityPair : *entities)
 			{
-				// If the application is paused, update only the GraphicsSystem.
-				if (isPaused && system->returnSystem() == "graphics" || system->returnSystem() == "scriptSystem")
+				TransformComponent* transform = dynamic_cast<TransformComponent*>(entityPair.second->GetComponent(ComponentType::Transform));
+				if (transform)
 				{
-					if (system->returnSystem() == "graphics")
-					{
-						GraphicsSystem* graphicsSystem = dynamic_cast<GraphicsSystem*>(system);
-						if (graphicsSystem)
-						{
-							graphicsSystem->StartTimer();
-							graphicsSystem->Update(entities);
-							graphicsSystem->StopTimer();
-							break; // Break out of the loop after updating the GraphicsSystem.
-						}
-					}
-					else if (system->returnSystem() == "scriptSystem")
-					{
-						ScriptSystem* scriptSystem = dynamic_cast<ScriptSystem*>(system);
-						if (scriptSystem)
-						{
-							scriptSystem->StartTimer();
-							scriptSystem->Update(entities);
-							scriptSystem->StopTimer();
-							break; // Break out of the loop after updating the scriptsystem.
-						}
-					}
+					transform->BeginStep(simulationStep);
 				}
-				else // If the application is not paused, update all systems as usual.
+			}
+
+			for (auto system : all_systems)
+			{
+				if (system != graphicsSystem && system->GetSystemState() == SystemState::On)
 				{
 					system->StartTimer();
 					system->Update(entities);
 					system->StopTimer();
 				}
 			}
+
+			for (const auto& entityPair : *entities)
+			{
+				TransformComponent* transform = dynamic_cast<TransformComponent*>(entityPair.second->GetComponent(ComponentType::Transform));
+				if (transform)
+				{
+					transform->EndStep(simulationStep);
+				}
+			}
 		}
 
+		// Rendering happens once per frame, between the last two steps
+		if (graphicsSystem && graphicsSystem->GetSystemState() == SystemState::On)
+		{
+			graphicsSystem->SetInterpolationAlpha(static_cast<float>(std::clamp(accumulatedTime / fixedDeltaTime, 0.0, 1.0)));
+			graphicsSystem->StartTimer();
+			graphicsSystem->Update(entities);
+			graphicsSystem->StopTimer();
+		}
 	}
 
 	template <typename T>
@@ -18,6 +18,7 @@
 #include "CollisionSystem.h"
 #include "PathfindingSystem.h"
 #include "ScriptSystem.h"
+#include "AnimationSystem.h"
 #include "AssetManager.h"
 #include "EntityManager.h"
 
@@ -0,0 +1,259 @@
+/******************************************************************************/
+/*!
+\file		TextureAtlas.cpp
+\author 	Wayne Kwok Jun Lin
+\par    	email: k.junlinwayne@digipen.edu
+\date   	April 15, 2024
+\brief		This file contains the implementation of the TextureAtlas class.
+Copyright (C) 2024 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the prior
+written consent of DigiPen Institute of Technology is prohibited.
+ */
+ /******************************************************************************/
+#include "pch.h"
+#include "TextureAtlas.h"
+#include "Renderer.h"
+#include "GLState.h"
+#include <cstring>
+
+// ImGui compiles its own static copy of the packer, so this file keeps another
+#define STBRP_STATIC
+#define STB_RECT_PACK_IMPLEMENTATION
+#include "imstb_rectpack.h"
+
+namespace
+{
+    const int BYTES_PER_PIXEL = 4;
+
+    int NextPowerOfTwo(int value)
+    {
+        int power = 1;
+        while (power < value)
+        {
+            power <<= 1;
+        }
+        return power;
+    }
+
+    // Horizontal pixel range of a frame of a sheet, spreading any leftover pixels over the frames
+    void FrameColumns(int width, int frameCount, int frame, int& begin, int& end)
+    {
+        begin = frame * width / frameCount;
+        end = (frame + 1) * width / frameCount;
+    }
+}
+
+TextureAtlas::~TextureAtlas()
+{
+    Clear();
+}
+
+void TextureAtlas::Add(const TextureKey& key, const unsigned char* pixels, int width, int height, int frameCount)
+{
+    pending.push_back({ key, pixels, width, height, std::max(1, frameCount) });
+}
+
+void TextureAtlas::Build()
+{
+    int maxTextureSize = 0;
+    GLCall(glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTextureSize));
+    const int pageWidth = std::max(1, std::min(settings.pageSize, maxTextureSize));
+    const int padding = std::max(0, settings.padding);
+
+    // One rectangle per frame, padding included. The id indexes frameOwners
+    struct FrameOwner
+    {
+        int image;
+        int frame;
+        int region;
+    };
+    std::vector<FrameOwner> frameOwners;
+    std::vector<stbrp_rect> rects;
+
+    for (int i = 0; i < static_cast<int>(pending.size()); ++i)
+    {
+        const PendingImage& image = pending[i];
+        // Widest frame, as frames of a sheet whose width does not divide evenly differ by a pixel
+        int frameWidth = (image.width + image.frameCount - 1) / image.frameCount;
+        bool fits = image.pixels != nullptr && image.width >= image.frameCount && image.height > 0
+            && frameWidth <= settings.maxImageSize && image.height <= settings.maxImageSize
+            && frameWidth + 2 * padding <= pageWidth && image.height + 2 * padding <= pageWidth;
+        if (!fits)
+        {
+            ++stats.standalone;
+            continue;
+        }
+
+        firstRegion[image.key] = static_cast<int>(regions.size());
+        frameCounts[image.key] = image.frameCount;
+        for (int frame = 0; frame < image.frameCount; ++frame)
+        {
+            int begin, end;
+            FrameColumns(image.width, image.frameCount, frame, begin, end);
+
+            stbrp_rect rect{};
+            rect.id = static_cast<int>(frameOwners.size());
+            rect.w = end - begin + 2 * padding;
+            rect.h = image.height + 2 * padding;
+            rects.push_back(rect);
+            frameOwners.push_back({ i, frame, static_cast<int>(regions.size()) });
+            regions.push_back(AtlasRegion());
+        }
+        ++stats.images;
+        stats.regions += image.frameCount;
+    }
+
+    std::vector<stbrp_node> nodes(pageWidth);
+    double usedArea = 0.0;
+    double pageArea = 0.0;
+    while (!rects.empty())
+    {
+        stbrp_context context;
+        stbrp_init_target(&context, pageWidth, pageWidth, nodes.data(), static_cast<int>(nodes.size()));
+        stbrp_pack_rects(&context, rects.data(), static_cast<int>(rects.size()));
+
+        // A sheet is drawn from a single page, so its frames wait for the next page unless all of them fit
+        std::vector<bool> split(pending.size(), false);
+        for (const stbrp_rect& rect : rects)
+        {
+            if (!rect.was_packed)
+            {
+                split[frameOwners[rect.id].image] = true;
+            }
+        }
+        for (stbrp_rect& rect : rects)
+        {
+            if (split[frameOwners[rect.id].image])
+            {
+                rect.was_packed = 0;
+            }
+        }
+
+        // Only allocate the rows the packed rectangles reach
+        int usedHeight = 0;
+        for (const stbrp_rect& rect : rects)
+        {
+            if (rect.was_packed)
+            {
+                usedHeight = std::max(usedHeight, rect.y + rect.h);
+            }
+        }
+        if (usedHeight == 0)
+        {
+            break;
+        }
+        const int pageHeight = std::min(NextPowerOfTwo(usedHeight), pageWidth);
+
+        std::vector<unsigned char> pixels(static_cast<size_t>(pageWidth) * pageHeight * BYTES_PER_PIXEL, 0);
+        const int page = static_cast<int>(pageTextures.size());
+        std::vector<stbrp_rect> remaining;
+        for (const stbrp_rect& rect : rects)
+        {
+            if (!rect.was_packed)
+            {
+                remaining.push_back(rect);
+                continue;
+            }
+
+            const FrameOwner& owner = frameOwners[rect.id];
+            const PendingImage& image = pending[owner.image];
+            CopyFrame(pixels, pageWidth, image, owner.frame, rect.x, rect.y);
+
+            int begin, end;
+            FrameColumns(image.width, image.frameCount, owner.frame, begin, end);
+            float left = static_cast<float>(rect.x + padding);
+            float bottom = static_cast<float>(rect.y + padding);
+            AtlasRegion& region = regions[owner.region];
+            region.page = page;
+            region.uvRect = glm::vec4(left / pageWidth, bottom / pageHeight,
+                (left + (end - begin)) / pageWidth, (bottom + image.height) / pageHeight);
+            usedArea += static_cast<double>(end - begin) * image.height;
+        }
+
+        unsigned int textureID = 0;
+        GLCall(glGenTextures(1, &textureID));
+        GLState::GetInstance().BindTexture(textureID);
+        GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR));
+        GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
+        GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
+        GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
+        GLCall(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, pageWidth, pageHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data()));
+        GLState::GetInstance().BindTexture(0);
+        pageTextures.push_back(textureID);
+        pageArea += static_cast<double>(pageWidth) * pageHeight;
+
+        rects.swap(remaining);
+    }
+
+    for (AtlasRegion& region : regions)
+    {
+        if (region.page >= 0)
+        {
+            region.textureID = pageTextures[region.page];
+        }
+    }
+
+    stats.pages = static_cast<int>(pageTextures.size());
+    stats.occupancy = pageArea > 0.0 ? static_cast<float>(usedArea / pageArea) : 0.0f;
+    pending.clear();
+}
+
+void TextureAtlas::CopyFrame(std::vector<unsigned char>& page, int pageWidth, const PendingImage& image, int frame, int x, int y) const
+{
+    const int padding = std::max(0, settings.padding);
+    int begin, end;
+    FrameColumns(image.width, image.frameCount, frame, begin, end);
+    const int frameWidth = end - begin;
+    const int border = settings.bleed ? padding : 0;
+
+    for (int row = -border; row < image.height + border; ++row)
+    {
+        int sourceRow = std::max(0, std::min(row, image.height - 1));
+        const unsigned char* source = image.pixels + (static_cast<size_t>(sourceRow) * image.width + begin) * BYTES_PER_PIXEL;
+        unsigned char* destination = page.data() + (static_cast<size_t>(y + padding + row) * pageWidth + x + padding) * BYTES_PER_PIXEL;
+
+        std::memcpy(destination, source, static_cast<size_t>(frameWidth) * BYTES_PER_PIXEL);
+        for (int column = 1; column <= border; ++column)
+        {
+            std::memcpy(destination - column * BYTES_PER_PIXEL, source, BYTES_PER_PIXEL);
+            std::memcpy(destination + (frameWidth - 1 + column) * BYTES_PER_PIXEL, source + (frameWidth - 1) * BYTES_PER_PIXEL, BYTES_PER_PIXEL);
+        }
+    }
+}
+
+const AtlasRegion* TextureAtlas::Find(const TextureKey& key, int frame) const
+{
+    auto it = firstRegion.find(key);
+    if (it == firstRegion.end())
+    {
+        return nullptr;
+    }
+    int frameCount = frameCounts.at(key);
+    frame = std::max(0, std::min(frame, frameCount - 1));
+    const AtlasRegion& region = regions[it->second + frame];
+    return region.textureID != 0 ? &region : nullptr;
+}
+
+void TextureAtlas::Remove(const TextureKey& key)
+{
+    firstRegion.erase(key);
+    frameCounts.erase(key);
+}
+
+void TextureAtlas::Clear()
+{
+    if (!pageTextures.empty())
+    {
+        for (unsigned int pageTexture : pageTextures)
+        {
+            GLState::GetInstance().ForgetTexture(pageTexture);
+        }
+        glDeleteTextures(static_cast<GLsizei>(pageTextures.size()), pageTextures.data());
+    }
+    pageTextures.clear();
+    pending.clear();
+    regions.clear();
+    firstRegion.clear();
+    frameCounts.clear();
+    stats = Stats();
+}
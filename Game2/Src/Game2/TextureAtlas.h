@@ -0,0 +1,127 @@
+/******************************************************************************/
+/*!
+\file		TextureAtlas.h
+\author 	Wayne Kwok Jun Lin
+\par    	email: k.junlinwayne@digipen.edu
+\date   	April 15, 2024
+\brief		This file contains the declaration of the TextureAtlas class, which
+            packs the loaded textures into a few large atlas pages at load
+            time so sprites using different textures can share a batch.
+            Sprite sheets are packed frame by frame, and every image is
+            surrounded by padding filled with its own edge pixels so
+            filtering never samples a neighbour.
+
+Copyright (C) 2024 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the prior
+written consent of DigiPen Institute of Technology is prohibited.
+ */
+ /******************************************************************************/
+#ifndef ENGINE_TEXTUREATLAS_H
+#define ENGINE_TEXTUREATLAS_H
+
+#include <vector>
+#include <unordered_map>
+#include "glm/glm.hpp"
+#include "EngineTypes.h"
+
+// Where an image ended up in the atlas
+struct AtlasRegion
+{
+    int page = -1;                              // -1 until packed
+    unsigned int textureID = 0;                 // OpenGL texture of the page
+    glm::vec4 uvRect = glm::vec4(0.0f);         // Bottom-left (x, y) and top-right (z, w) texture coordinates
+};
+
+// Packs images into atlas pages and looks their regions up by TextureKey.
+class TextureAtlas
+{
+public:
+    struct Settings
+    {
+        int pageSize = 4096;        // Width and largest height of a page, capped by GL_MAX_TEXTURE_SIZE
+        int maxImageSize = 1024;    // Larger images, such as full-screen backgrounds, keep their own texture
+        int padding = 2;            // Pixels between neighbouring images
+        bool bleed = true;          // Fill the padding with the edge pixels instead of leaving it transparent
+    };
+
+    struct Stats
+    {
+        int pages = 0;
+        int images = 0;             // Textures packed into a page
+        int regions = 0;            // Frames packed, counting each frame of a sheet
+        int standalone = 0;         // Textures left out of the atlas
+        float occupancy = 0.0f;     // Share of the page area covered by images
+    };
+
+    ~TextureAtlas();
+
+    /*!
+     * \brief Queues an image for the next Build.
+     * \param key The key the image is looked up by.
+     * \param pixels The RGBA pixels, bottom row first. They must stay valid until Build returns.
+     * \param width The width of the image in pixels.
+     * \param height The height of the image in pixels.
+     * \param frameCount The number of frames of a horizontal sprite sheet, packed separately.
+     */
+    void Add(const TextureKey& key, const unsigned char* pixels, int width, int height, int frameCount = 1);
+
+    /*!
+     * \brief Packs the queued images into pages and uploads them.
+     *
+     * Images too large for the atlas are left out and Find returns nullptr for them.
+     * The frames of a sprite sheet always share a page.
+     * This function must be called once the OpenGL context exists.
+     */
+    void Build();
+
+    /*!
+     * \brief Finds where a frame of an image was packed.
+     * \param key The key the image was added with.
+     * \param frame The frame of a sprite sheet, 0 for whole images.
+     * \return The region, or nullptr if the image is not in the atlas.
+     */
+    const AtlasRegion* Find(const TextureKey& key, int frame = 0) const;
+
+    /*!
+     * \brief Stops looking an image up in the atlas, such as after it is replaced in the editor.
+     * \param key The key the image was added with.
+     */
+    void Remove(const TextureKey& key);
+
+    /*!
+     * \brief Deletes the pages and forgets every image.
+     */
+    void Clear();
+
+    void SetSettings(const Settings& _settings) { settings = _settings; }
+    const Settings& GetSettings() const { return settings; }
+
+    /*!
+     * \brief Gets the counters of the last build.
+     * \return A reference to the statistics.
+     */
+    const Stats& GetStats() const { return stats; }
+
+private:
+    struct PendingImage
+    {
+        TextureKey key;
+        const unsigned char* pixels;
+        int width, height;
+        int frameCount;
+    };
+
+    // Copies a frame into a page, filling the padding around it when bleeding
+    void CopyFrame(std::vector<unsigned char>& page, int pageWidth, const PendingImage& image, int frame, int x, int y) const;
+
+    Settings settings;
+    Stats stats;
+
+    std::vector<PendingImage> pending;
+    std::vector<AtlasRegion> regions;
+    // First region of each image, its frames follow in order
+    std::unordered_map<TextureKey, int> firstRegion;
+    std::unordered_map<TextureKey, int> frameCounts;
+    std::vector<unsigned int> pageTextures;
+};
+#endif ENGINE_TEXTUREATLAS_H
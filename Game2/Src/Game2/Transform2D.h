@@ -0,0 +1,40 @@
+/******************************************************************************/
+/*!
+\file		Transform2D.h
+\author 	Wayne Kwok Jun Lin
+\par    	email: k.junlinwayne@digipen.edu
+\date   	April 18, 2024
+\brief		This file contains the Transform2D struct, the 2D affine transform
+            sprites are drawn with. It holds only the six values of the model
+            matrix that a flat sprite uses.
+Copyright (C) 2024 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the prior
+written consent of DigiPen Institute of Technology is prohibited.
+ */
+ /******************************************************************************/
+#ifndef ENGINE_TRANSFORM2D_H
+#define ENGINE_TRANSFORM2D_H
+
+// Maps a point p of the entity quad to basis.xy * p.x + basis.zw * p.y + translation.
+struct Transform2D
+{
+    float basis[4] = { 1.0f, 0.0f, 0.0f, 1.0f };    // Transformed x axis, then y axis
+    float translation[2] = { 0.0f, 0.0f };
+
+    /*!
+     * \brief Builds the transform translating, then scaling, then rotating, the same
+     * order GraphicsSystem::SetupModelMatrix uses.
+     */
+    static Transform2D FromSinCos(float x, float y, float sine, float cosine, float scaleX, float scaleY)
+    {
+        Transform2D transform;
+        transform.basis[0] = scaleX * cosine;
+        transform.basis[1] = scaleY * sine;
+        transform.basis[2] = -scaleX * sine;
+        transform.basis[3] = scaleY * cosine;
+        transform.translation[0] = x;
+        transform.translation[1] = y;
+        return transform;
+    }
+};
+#endif ENGINE_TRANSFORM2D_H
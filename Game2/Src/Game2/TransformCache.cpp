@@ -0,0 +1,157 @@
+/******************************************************************************/
+/*!
+\file		TransformCache.cpp
+\author 	Wayne Kwok Jun Lin
+\par    	email: k.junlinwayne@digipen.edu
+\date   	April 18, 2024
+\brief		This file contains the implementation of the TransformCache class.
+Copyright (C) 2024 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the prior
+written consent of DigiPen Institute of Technology is prohibited.
+ */
+ /******************************************************************************/
+#include "pch.h"
+#include "TransformCache.h"
+#include <chrono>
+#include <cmath>
+
+namespace Engine
+{
+    void TransformCache::BeginFrame()
+    {
+        for (int slot : dirtySlots)
+        {
+            dirty[slot] = 0;
+        }
+        dirtySlots.clear();
+
+        // Entities not drawn last frame were destroyed or lost their texture
+        for (int slot = static_cast<int>(ids.size()) - 1; slot >= 0; --slot)
+        {
+            if (lastFrame[slot] != currentFrame)
+            {
+                RemoveAt(slot);
+            }
+        }
+        ++currentFrame;
+    }
+
+    int TransformCache::Submit(EntityID id, float x, float y, float _rotation, float _scaleX, float _scaleY)
+    {
+        auto it = slotOf.find(id);
+        int slot;
+        if (it == slotOf.end())
+        {
+            slot = static_cast<int>(ids.size());
+            ids.push_back(id);
+            positionX.push_back(x);
+            positionY.push_back(y);
+            rotation.push_back(_rotation);
+            scaleX.push_back(_scaleX);
+            scaleY.push_back(_scaleY);
+            lastFrame.push_back(currentFrame);
+            dirty.push_back(1);
+            transforms.emplace_back();
+            slotOf[id] = slot;
+            dirtySlots.push_back(slot);
+            return slot;
+        }
+
+        slot = it->second;
+        lastFrame[slot] = currentFrame;
+        if (positionX[slot] == x && positionY[slot] == y && rotation[slot] == _rotation
+            && scaleX[slot] == _scaleX && scaleY[slot] == _scaleY)
+        {
+            return slot;
+        }
+        positionX[slot] = x;
+        positionY[slot] = y;
+        rotation[slot] = _rotation;
+        scaleX[slot] = _scaleX;
+        scaleY[slot] = _scaleY;
+        if (!dirty[slot])
+        {
+            dirty[slot] = 1;
+            dirtySlots.push_back(slot);
+        }
+        return slot;
+    }
+
+    void TransformCache::Compute()
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+
+        // The trigonometry is the expensive part, so it runs alone over packed rotations
+        const size_t count = dirtySlots.size();
+        dirtySine.resize(count);
+        dirtyCosine.resize(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            dirtySine[i] = rotation[dirtySlots[i]];
+        }
+        float* sine = dirtySine.data();
+        float* cosine = dirtyCosine.data();
+        for (size_t i = 0; i < count; ++i)
+        {
+            float angle = sine[i];
+            cosine[i] = std::cos(angle);
+            sine[i] = std::sin(angle);
+        }
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            int slot = dirtySlots[i];
+            transforms[slot] = Transform2D::FromSinCos(positionX[slot], positionY[slot], sine[i], cosine[i], scaleX[slot], scaleY[slot]);
+        }
+
+        stats.transforms = static_cast<int>(ids.size());
+        stats.recomputed = static_cast<int>(count);
+        stats.computeMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+    }
+
+    void TransformCache::Clear()
+    {
+        ids.clear();
+        positionX.clear();
+        positionY.clear();
+        rotation.clear();
+        scaleX.clear();
+        scaleY.clear();
+        lastFrame.clear();
+        dirty.clear();
+        transforms.clear();
+        slotOf.clear();
+        dirtySlots.clear();
+        stats = Stats();
+    }
+
+    void TransformCache::RemoveAt(int slot)
+    {
+        slotOf.erase(ids[slot]);
+
+        // Move the last entry into the gap
+        int last = static_cast<int>(ids.size()) - 1;
+        if (slot != last)
+        {
+            ids[slot] = ids[last];
+            positionX[slot] = positionX[last];
+            positionY[slot] = positionY[last];
+            rotation[slot] = rotation[last];
+            scaleX[slot] = scaleX[last];
+            scaleY[slot] = scaleY[last];
+            lastFrame[slot] = lastFrame[last];
+            dirty[slot] = dirty[last];
+            transforms[slot] = transforms[last];
+            slotOf[ids[slot]] = slot;
+        }
+        ids.pop_back();
+        positionX.pop_back();
+        positionY.pop_back();
+        rotation.pop_back();
+        scaleX.pop_back();
+        scaleY.pop_back();
+        lastFrame.pop_back();
+        dirty.pop_back();
+        transforms.pop_back();
+    }
+}
@@ -0,0 +1,117 @@
+/******************************************************************************/
+/*!
+\file		TransformCache.h
+\author 	Wayne Kwok Jun Lin
+\par    	email: k.junlinwayne@digipen.edu
+\date   	April 18, 2024
+\brief		This file contains the declaration of the TransformCache class, which
+            keeps the draw transform of every renderable in packed arrays and
+            only rebuilds the ones whose position, rotation or scale changed,
+            in one pass over the changed entries.
+Copyright (C) 2024 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the prior
+written consent of DigiPen Institute of Technology is prohibited.
+ */
+ /******************************************************************************/
+#ifndef ENGINE_TRANSFORMCACHE_H
+#define ENGINE_TRANSFORMCACHE_H
+
+#include <vector>
+#include <unordered_map>
+#include "EngineTypes.h"
+#include "Transform2D.h"
+
+namespace Engine
+{
+    class TransformCache
+    {
+    public:
+        /*!
+        \brief Counters describing the last Compute.
+        */
+        struct Stats
+        {
+            int transforms = 0;
+            int recomputed = 0;         // Transforms marked dirty this frame
+            double computeMs = 0.0;
+        };
+
+        /**************************************************************************/
+        /*!
+        \brief Starts a new frame. Entries not submitted during the last frame are
+        removed, so slots returned by Submit are only valid until the next call.
+        */
+        /**************************************************************************/
+        void BeginFrame();
+
+        /**************************************************************************/
+        /*!
+        \brief Submits the transform an entity is drawn with this frame. The entry
+        is marked dirty if it is new or any value differs from the last frame.
+
+        \param[in] id
+        The entity drawn.
+
+        \param[in] x, y
+        The position the entity is drawn at.
+
+        \param[in] rotation
+        The rotation in radians.
+
+        \param[in] scaleX, scaleY
+        The scale of the entity quad.
+
+        \return
+        The slot of the entity, passed to Get and IsDirty.
+        */
+        /**************************************************************************/
+        int Submit(EntityID id, float x, float y, float rotation, float scaleX, float scaleY);
+
+        /**************************************************************************/
+        /*!
+        \brief Rebuilds the transforms of the dirty entries. Must be called after
+        the last Submit of the frame and before Get.
+        */
+        /**************************************************************************/
+        void Compute();
+
+        const Transform2D& Get(int slot) const { return transforms[slot]; }
+
+        /*!
+        \brief Checks whether a transform was rebuilt by the last Compute.
+        \param[in] slot The slot returned by Submit.
+        \return True if the entry is new or changed this frame.
+        */
+        bool IsDirty(int slot) const { return dirty[slot] != 0; }
+
+        /*!
+        \brief Removes every entry.
+        */
+        void Clear();
+
+        /*!
+        \brief Gets the counters of the last Compute.
+        \return A reference to the statistics.
+        */
+        const Stats& GetStats() const { return stats; }
+
+    private:
+        void RemoveAt(int slot);
+
+        // Inputs the transforms were built from, one array per value
+        std::vector<EntityID> ids;
+        std::vector<float> positionX, positionY, rotation, scaleX, scaleY;
+        std::vector<unsigned int> lastFrame;    // Frame each entry was last submitted
+        std::vector<unsigned char> dirty;
+        std::vector<Transform2D> transforms;
+        std::unordered_map<EntityID, int> slotOf;
+
+        // Dirty slots of the frame and their rotations, gathered so the trigonometry runs over contiguous memory
+        std::vector<int> dirtySlots;
+        std::vector<float> dirtySine, dirtyCosine;
+
+        unsigned int currentFrame = 0;
+        Stats stats;
+    };
+}
+#endif ENGINE_TRANSFORMCACHE_H
@@ -11,6 +11,7 @@
 #ifndef ENGINE_TRANSFORMCOMPONENT_H
 #define ENGINE_TRANSFORMCOMPONENT_H
 
+#include <cmath>
 #include "Component.h"
 #include "EngineTypes.h"
 #include "Vector2d.h"
@@ -25,6 +26,79 @@ namespace Engine
 		float scaleX = 1.0f, scaleY = 1.0f;
 		float rot = 0.0f;
 
+		// Runtime interpolation state, captured around each fixed step and never saved
+		VECTORMATH::Vector2D previousPosition = VECTORMATH::Vector2D(0, 0);
+		VECTORMATH::Vector2D simulatedPosition = VECTORMATH::Vector2D(0, 0);
+		float previousRot = 0.0f, simulatedRot = 0.0f;
+		unsigned int stepStarted = 0;
+		bool interpolate = false;
+
+		/*!*****************************************************************
+
+		\brief
+		Remembers the transform before a fixed step
+
+		\param[in] step
+		The number of the step about to run
+
+		********************************************************************/
+		void BeginStep(unsigned int step)
+		{
+			previousPosition = position;
+			previousRot = rot;
+			stepStarted = step;
+		}
+
+		/*!*****************************************************************
+
+		\brief
+		Remembers the transform after a fixed step. Transforms created during
+		the step and those that jumped further than a step could move them are
+		drawn where they are instead of interpolated
+
+		\param[in] step
+		The number of the step that just ran
+
+		********************************************************************/
+		void EndStep(unsigned int step)
+		{
+			const float TELEPORT_DISTANCE = 256.0f;
+			simulatedPosition = position;
+			simulatedRot = rot;
+			float moveX = position.x - previousPosition.x;
+			float moveY = position.y - previousPosition.y;
+			interpolate = stepStarted == step && moveX * moveX + moveY * moveY < TELEPORT_DISTANCE * TELEPORT_DISTANCE;
+		}
+
+		/*!*****************************************************************
+
+		\brief
+		Gets the transform to draw between the last two fixed steps
+
+		\param[in] alpha
+		How far the frame is into the next step, from 0 to 1
+
+		\param[out] renderPosition, renderRot
+		The interpolated position and rotation. The current ones if the
+		transform was moved outside the steps, such as in the editor
+
+		********************************************************************/
+		void GetRenderTransform(float alpha, VECTORMATH::Vector2D& renderPosition, float& renderRot) const
+		{
+			if (!interpolate || position.x != simulatedPosition.x || position.y != simulatedPosition.y || rot != simulatedRot)
+			{
+				renderPosition = position;
+				renderRot = rot;
+				return;
+			}
+			renderPosition.x = previousPosition.x + (position.x - previousPosition.x) * alpha;
+			renderPosition.y = previousPosition.y + (position.y - previousPosition.y) * alpha;
+			// Turn the short way round, atan2 wraps from pi to -pi
+			const float TWO_PI = 6.28318530718f;
+			float turn = std::remainder(rot - previousRot, TWO_PI);
+			renderRot = previousRot + turn * alpha;
+		}
+
 		/*!*****************************************************************
 
 		\brief
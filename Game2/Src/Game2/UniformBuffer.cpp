@@ -0,0 +1,42 @@
+/******************************************************************************/
+/*!
+\file		UniformBuffer.cpp
+\author 	Wayne Kwok Jun Lin
+\par    	email: k.junlinwayne@digipen.edu
+\date   	April 17, 2024
+\brief		This file contains the implementation of the UniformBuffer class
+            functions, which manage OpenGL uniform buffers.
+
+Copyright (C) 2024 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the prior
+written consent of DigiPen Institute of Technology is prohibited.
+ */
+ /******************************************************************************/
+#include "pch.h"
+#include "UniformBuffer.h"
+#include "Renderer.h"
+
+UniformBuffer::UniformBuffer(unsigned int size, unsigned int binding)
+    : m_RendererID(0), m_Size(size), m_Binding(binding)
+{
+    GLCall(glGenBuffers(1, &m_RendererID));
+    GLCall(glBindBuffer(GL_UNIFORM_BUFFER, m_RendererID));
+    //allocate storage only, the data is written once per frame
+    GLCall(glBufferData(GL_UNIFORM_BUFFER, size, nullptr, GL_DYNAMIC_DRAW));
+    GLCall(glBindBuffer(GL_UNIFORM_BUFFER, 0));
+    //the buffer stays attached, so programs never need to bind it
+    GLCall(glBindBufferBase(GL_UNIFORM_BUFFER, binding, m_RendererID));
+}
+
+UniformBuffer::~UniformBuffer()
+{
+    //free up resources
+    GLCall(glDeleteBuffers(1, &m_RendererID));
+}
+
+void UniformBuffer::SetData(const void* data, unsigned int size)
+{
+    GLCall(glBindBuffer(GL_UNIFORM_BUFFER, m_RendererID));
+    GLCall(glBufferSubData(GL_UNIFORM_BUFFER, 0, size < m_Size ? size : m_Size, data));
+    GLCall(glBindBuffer(GL_UNIFORM_BUFFER, 0));
+}
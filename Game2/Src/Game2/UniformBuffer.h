@@ -0,0 +1,57 @@
+/******************************************************************************/
+/*!
+\file		UniformBuffer.h
+\author 	Wayne Kwok Jun Lin
+\par    	email: k.junlinwayne@digipen.edu
+\date   	April 17, 2024
+\brief		This file contains the declaration of the UniformBuffer class,
+			which represents a uniform buffer in OpenGL. The data in it is
+			shared by every program that declares the matching uniform block.
+
+Copyright (C) 2024 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the prior
+written consent of DigiPen Institute of Technology is prohibited.
+ */
+ /******************************************************************************/
+#ifndef ENGINE_UNIFORMBUFFER_H
+#define ENGINE_UNIFORMBUFFER_H
+
+// Represents a uniform buffer in OpenGL, attached to one uniform block binding point.
+class UniformBuffer
+{
+private:
+	//internal openGL Renderer ID (buffer)
+	unsigned int m_RendererID;
+	unsigned int m_Size;		//size of the storage in bytes
+	unsigned int m_Binding;		//binding point the uniform blocks read from
+public:
+
+	/*!
+	 * \brief UniformBuffer constructor.
+	 * \param size Size of the storage in bytes, laid out as std140.
+	 * \param binding The binding point, matching layout(binding = ...) in the shaders.
+	 *
+	 * This constructor generates an empty uniform buffer and attaches it to the binding point.
+	 */
+	UniformBuffer(unsigned int size, unsigned int binding);
+
+	/*!
+	 * \brief UniformBuffer destructor.
+	 *
+	 * This destructor frees up the OpenGL resources associated with the uniform buffer.
+	 */
+	~UniformBuffer();
+
+	UniformBuffer(const UniformBuffer&) = delete;
+	UniformBuffer& operator=(const UniformBuffer&) = delete;
+
+	/*!
+	 * \brief Replace the start of the buffer.
+	 * \param data A pointer to the data to be copied into the buffer.
+	 * \param size The size of the data in bytes, at most the size the buffer was created with.
+	 */
+	void SetData(const void* data, unsigned int size);
+
+	unsigned int GetBinding() const { return m_Binding; }
+};
+#endif ENGINE_UNIFORMBUFFER_H
@@ -18,6 +18,7 @@
 #include "VertexArray.h"
 #include "VertexBufferLayout.h"
 #include "Renderer.h"
+#include "GLState.h"
 #include <GLFW/glfw3.h>
 
 VertexArray::VertexArray()
@@ -27,6 +28,7 @@ VertexArray::VertexArray()
 
 VertexArray::~VertexArray()
 {
+	GLState::GetInstance().ForgetVertexArray(m_RendererID);
 	GLCall(glDeleteVertexArrays(1, &m_RendererID)); //delete VAO when object is destroyed
 }
 
@@ -40,7 +42,7 @@ void VertexArray::GenerateRendererID() const
 	GLuint rendererID;
 	GLCall(glGenVertexArrays(1, &rendererID)); //new VAO ID
 	const_cast<VertexArray*>(this)->SetRendererID(rendererID);
-	GLCall(glBindVertexArray(m_RendererID)); //bind newly generated VAO
+	GLState::GetInstance().BindVertexArray(m_RendererID); //bind newly generated VAO
 }
 
 void VertexArray::AddBuffer(const VertexBuffer& vb, const VertexBufferLayout& layout)
@@ -64,11 +66,30 @@ void VertexArray::AddBuffer(const VertexBuffer& vb, const VertexBufferLayout& la
 	
 }
 
+void VertexArray::AddInstanceBuffer(const VertexBuffer& vb, const VertexBufferLayout& layout, unsigned int firstAttribute)
+{
+	Bind();
+	vb.Bind();
+	const auto& elements = layout.GetElements();
+	unsigned int offset = 0;
+	for (unsigned int i = 0; i < elements.size(); i++)
+	{
+		const auto& element = elements[i];
+		unsigned int attribute = firstAttribute + i;
+		GLCall(glEnableVertexAttribArray(attribute));
+		GLCall(glVertexAttribPointer(attribute, element.count, element.type,
+			element.normalized, layout.GetStride(), reinterpret_cast<const void*>(static_cast<uintptr_t>(offset))));
+		//advance the attribute once per instance
+		GLCall(glVertexAttribDivisor(attribute, 1));
+		offset += element.count * VertexBufferElement::GetSizeOfType(element.type);
+	}
+}
+
 void VertexArray::UpdateBuffer(unsigned int index, const void* data, size_t size)
 {
 	if (index < m_RendererBuffers.size()) {
 		Bind(); // Bind the VAO to make it active
-		glBindBuffer(GL_ARRAY_BUFFER, m_RendererBuffers[index]); // Bind the specific buffer
+		GLState::GetInstance().BindBuffer(GL_ARRAY_BUFFER, m_RendererBuffers[index]); // Bind the specific buffer
 		glBufferSubData(GL_ARRAY_BUFFER, 0, size, data); // Update the buffer data
 	}
 	else {
@@ -79,14 +100,14 @@ void VertexArray::UpdateBuffer(unsigned int index, const void* data, size_t size
 void VertexArray::Bind() const
 {
 	// Check if the window is minimized
-	if (!glfwGetWindowAttrib(glfwGetCurrentContext(), GLFW_ICONIFIED))
+	if (!GLState::GetInstance().IsMinimized())
 	{
 		if (m_RendererID == 0)
 		{
 			GenerateRendererID(); //generate new VAO if it doesn't exist
 		}
 		//bind to make the new VAO active
-		GLCall(glBindVertexArray(m_RendererID));
+		GLState::GetInstance().BindVertexArray(m_RendererID);
 	}
 	else
 	{
@@ -97,9 +118,9 @@ void VertexArray::Bind() const
 void VertexArray::Unbind() const
 {
 	// Check if the window is minimized
-	if (!glfwGetWindowAttrib(glfwGetCurrentContext(), GLFW_ICONIFIED))
+	if (!GLState::GetInstance().IsMinimized())
 	{
-		GLCall(glBindVertexArray(0));
+		GLState::GetInstance().BindVertexArray(0);
 	}
 	else
 	{
@@ -58,6 +58,17 @@ public:
 	 */
 	void AddBuffer(const VertexBuffer& vb, const VertexBufferLayout& layout); //add buffer with a specific layout
 
+	/*!
+	 * \brief Add a per-instance vertex buffer to the VertexArray.
+	 * \param vb The vertex buffer to add.
+	 * \param layout The layout specifying the arrangement of vertex attributes.
+	 * \param firstAttribute The attribute location of the first element of the layout.
+	 *
+	 * This function configures the attributes like AddBuffer, but they advance once
+	 * per instance instead of once per vertex, for use with instanced draws.
+	 */
+	void AddInstanceBuffer(const VertexBuffer& vb, const VertexBufferLayout& layout, unsigned int firstAttribute);
+
 	/*!
 	 * \brief Update the buffer data in the vertex array.
 	 *
@@ -15,37 +15,57 @@ written consent of DigiPen Institute of Technology is prohibited.
 #include "pch.h"
 #include "VertexBuffer.h"
 #include "Renderer.h"
+#include "GLState.h"
 
 VertexBuffer::VertexBuffer(const void* data, unsigned int size)
 {
     //generate a new buffer and store its ID in m_RendererID
     GLCall(glGenBuffers(1, &m_RendererID));
     //bind the newly created buffer as an array buffer
-    GLCall(glBindBuffer(GL_ARRAY_BUFFER, m_RendererID));
+    GLState::GetInstance().BindBuffer(GL_ARRAY_BUFFER, m_RendererID);
     //stores the vertex data the buffer data
     GLCall(glBufferData(GL_ARRAY_BUFFER, size, data, GL_STATIC_DRAW));
+    m_Size = size;
+}
+
+VertexBuffer::VertexBuffer(unsigned int size)
+    : m_Size(size)
+{
+    GLCall(glGenBuffers(1, &m_RendererID));
+    GLState::GetInstance().BindBuffer(GL_ARRAY_BUFFER, m_RendererID);
+    //allocate storage only, the data is streamed in later
+    GLCall(glBufferData(GL_ARRAY_BUFFER, size, nullptr, GL_STREAM_DRAW));
 }
 
 VertexBuffer::~VertexBuffer()
 {
     //free up resources
+    GLState::GetInstance().ForgetBuffer(m_RendererID);
     GLCall(glDeleteBuffers(1, &m_RendererID));
 }
 
 void VertexBuffer::SetData(const void* data, unsigned int size)
 {
-    GLCall(glBindBuffer(GL_ARRAY_BUFFER, m_RendererID));
+    GLState::GetInstance().BindBuffer(GL_ARRAY_BUFFER, m_RendererID);
     GLCall(glBufferData(GL_ARRAY_BUFFER, size, data, GL_STATIC_DRAW));
 }
 
+void VertexBuffer::StreamData(const void* data, unsigned int size)
+{
+    GLState::GetInstance().BindBuffer(GL_ARRAY_BUFFER, m_RendererID);
+    //orphan the storage still used by earlier draws
+    GLCall(glBufferData(GL_ARRAY_BUFFER, m_Size, nullptr, GL_STREAM_DRAW));
+    GLCall(glBufferSubData(GL_ARRAY_BUFFER, 0, size, data));
+}
+
 void VertexBuffer::Bind() const
 {
     //bind vertex buffer for rendering
-    GLCall(glBindBuffer(GL_ARRAY_BUFFER, m_RendererID));
+    GLState::GetInstance().BindBuffer(GL_ARRAY_BUFFER, m_RendererID);
 }
 
 void VertexBuffer::Unbind() const
 {
     //unbind vertex buffer to prevent accidental modification
-    GLCall(glBindBuffer(GL_ARRAY_BUFFER, 0));
+    GLState::GetInstance().BindBuffer(GL_ARRAY_BUFFER, 0);
 }
\ No newline at end of file
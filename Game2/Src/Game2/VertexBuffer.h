@@ -21,6 +21,7 @@ class VertexBuffer
 private:
 	//internal openGL Renderer ID (buffer)
 	unsigned int m_RendererID; 
+	unsigned int m_Size = 0;	//size of the storage in bytes
 public:
 
 	/*!
@@ -31,6 +32,13 @@ public:
 	 * This constructor generates a new OpenGL vertex buffer and stores the provided vertex data in it.
 	 */
 	VertexBuffer(const void* data, unsigned int size); 
+	/*!
+	 * \brief VertexBuffer constructor for streamed data.
+	 * \param size Size of the storage in bytes.
+	 *
+	 * This constructor generates an empty vertex buffer for data that is replaced every frame.
+	 */
+	explicit VertexBuffer(unsigned int size);
 
 	/*!
 	 * \brief VertexBuffer destructor.
@@ -48,6 +56,16 @@ public:
 	 * \param size The size of the data in bytes.
 	 */
 	void SetData(const void* data, unsigned int size);
+	/*!
+	 * \brief Replace the start of a streamed buffer.
+	 *
+	 * This function orphans the old storage so the driver does not wait for draws still
+	 * reading it, then copies the data into the new storage.
+	 *
+	 * \param data A pointer to the data to be copied into the buffer.
+	 * \param size The size of the data in bytes, at most the size the buffer was created with.
+	 */
+	void StreamData(const void* data, unsigned int size);
 
 	/*!
 	 * \brief Binds the vertex buffer for rendering.
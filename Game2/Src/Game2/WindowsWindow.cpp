@@ -18,6 +18,7 @@ written consent of DigiPen Institute of Technology is prohibited.
 #include "AppEvent.h"
 #include "InputEvent.h"
 #include "AudioEngine.h"
+#include "Renderer.h"
 
 namespace Engine {
 	// Static flag to check if GLFW is initialized
@@ -77,6 +78,10 @@ namespace Engine {
 		glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
 		glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
 		glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+#if ENGINE_GL_ERROR_CHECKS
+		// Some drivers only send GL_KHR_debug messages to debug contexts
+		glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GLFW_TRUE);
+#endif
 
 		//const GLFWvidmode* mode = glfwGetVideoMode(glfwGetPrimaryMonitor());
 		//m_Window = glfwCreateWindow(mode->width, mode->height, m_Data.Title.c_str(), glfwGetPrimaryMonitor(), nullptr);
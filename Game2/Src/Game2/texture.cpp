@@ -18,6 +18,7 @@
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
 #include <GLFW/glfw3.h>
+#include "GLState.h"
 
 Texture::Texture()
     : m_Filepath(""), m_RendererID(0), m_LocalBuffer(nullptr),
@@ -48,7 +49,7 @@ void Texture::InitGL()
 {
     // Generate a new OpenGL texture
     glGenTextures(1, &m_RendererID);
-    glBindTexture(GL_TEXTURE_2D, m_RendererID);
+    GLState::GetInstance().BindTexture(m_RendererID);
 
     // Set texture parameters (filtering and wrapping)
     GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR));
@@ -58,17 +59,16 @@ void Texture::InitGL()
 
     // Upload image data to OpenGL texture
     GLCall(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, m_Width, m_Height, 0, GL_RGBA, GL_UNSIGNED_BYTE, m_LocalBuffer));
-    glBindTexture(GL_TEXTURE_2D, 0);
+    GLState::GetInstance().BindTexture(0);
 }
 
 void Texture::Bind(unsigned int slot) const
 {
     // Check if the window is minimized
-    if (!glfwGetWindowAttrib(glfwGetCurrentContext(), GLFW_ICONIFIED))
+    if (!GLState::GetInstance().IsMinimized())
     {
         // Window is not minimized, proceed with binding the texture
-        GLCall(glActiveTexture(GL_TEXTURE0 + slot));
-        GLCall(glBindTexture(GL_TEXTURE_2D, m_RendererID));
+        GLState::GetInstance().BindTexture(slot, m_RendererID);
     }
     else
     {
@@ -79,9 +79,9 @@ void Texture::Bind(unsigned int slot) const
 
 void Texture::Unbind() const
 {
-    if (!glfwGetWindowAttrib(glfwGetCurrentContext(), GLFW_ICONIFIED)) 
+    if (!GLState::GetInstance().IsMinimized())
     {
-        GLCall(glBindTexture(GL_TEXTURE_2D, 0));
+        GLState::GetInstance().BindTexture(0);
     }
     else
     {
@@ -108,11 +108,12 @@ void Texture::LoadNewTexture(const std::string& newPath) {
     // Check if loading was successful
     if (newLocalBuffer) {
         // Delete the old OpenGL texture
+        GLState::GetInstance().ForgetTexture(m_RendererID);
         glDeleteTextures(1, &m_RendererID);
 
         // Generate a new OpenGL texture
         glGenTextures(1, &m_RendererID);
-        glBindTexture(GL_TEXTURE_2D, m_RendererID);
+        GLState::GetInstance().BindTexture(m_RendererID);
 
         // Set texture parameters
         GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR));
@@ -122,7 +123,7 @@ void Texture::LoadNewTexture(const std::string& newPath) {
 
         // Upload the new image data to OpenGL texture
         GLCall(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, m_Width, m_Height, 0, GL_RGBA, GL_UNSIGNED_BYTE, newLocalBuffer));
-        glBindTexture(GL_TEXTURE_2D, 0);
+        GLState::GetInstance().BindTexture(0);
 
         // Free the old local buffer
         stbi_image_free(m_LocalBuffer);
@@ -151,11 +152,12 @@ void Texture::UpdateTexture(const std::string& newPath)
     // Check if loading was successful
     if (newLocalBuffer) {
         // Delete the old OpenGL texture
+        GLState::GetInstance().ForgetTexture(m_RendererID);
         glDeleteTextures(1, &m_RendererID);
 
         // Generate a new OpenGL texture
         glGenTextures(1, &m_RendererID);
-        glBindTexture(GL_TEXTURE_2D, m_RendererID);
+        GLState::GetInstance().BindTexture(m_RendererID);
 
         // Set texture parameters
         GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR));
@@ -165,7 +167,7 @@ void Texture::UpdateTexture(const std::string& newPath)
 
         // Upload the new image data to OpenGL texture
         GLCall(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, m_Width, m_Height, 0, GL_RGBA, GL_UNSIGNED_BYTE, newLocalBuffer));
-        glBindTexture(GL_TEXTURE_2D, 0);
+        GLState::GetInstance().BindTexture(0);
 
         // Free the old local buffer
         stbi_image_free(m_LocalBuffer);
@@ -200,7 +202,7 @@ void Texture::UpdateBufferData()
 {
     // Upload image data to OpenGL texture
     GLCall(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, m_Width, m_Height, 0, GL_RGBA, GL_UNSIGNED_BYTE, m_LocalBuffer));
-    glBindTexture(GL_TEXTURE_2D, 0);
+    GLState::GetInstance().BindTexture(0);
 
 }
 
@@ -167,6 +167,16 @@ public:
     inline int GetHeight() {
         return m_Height;
     }
+
+    /*!
+    * \brief Get the pixels loaded from the file.
+    *
+    * \return const unsigned char*
+    * The RGBA pixels, bottom row first, or nullptr if nothing is loaded.
+    */
+    const unsigned char* GetLocalBuffer() const {
+        return m_LocalBuffer;
+    }
     
 private:
     float m_RenderPosX, m_RenderPosY; // Position for rendering